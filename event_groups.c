@@ -51,11 +51,20 @@
  * configUSE_EVENT_GROUPS is set to 1 in FreeRTOSConfig.h. */
 #if ( configUSE_EVENT_GROUPS == 1 )
 
+/* The number of bits in an event group that are available to the application,
+ * which is the number of lists used to index waiting tasks when
+ * configUSE_INDEXED_EVENT_GROUP_WAITERS is set to 1. */
+    #define eventNUMBER_OF_USER_BITS    ( ( UBaseType_t ) ( ( sizeof( EventBits_t ) * ( size_t ) 8 ) - ( size_t ) 8 ) )
+
     typedef struct EventGroupDef_t
     {
         EventBits_t uxEventBits;
         List_t xTasksWaitingForBits; /**< List of tasks waiting for a bit to be set. */
 
+        #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+            List_t xTasksWaitingForBit[ eventNUMBER_OF_USER_BITS ]; /**< Tasks waiting for all of their bits, or a single bit, indexed by a bit they are waiting for that is not yet set.  Other tasks remain in xTasksWaitingForBits. */
+        #endif
+
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxEventGroupNumber;
         #endif
@@ -63,10 +72,49 @@
         #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
             uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
         #endif
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            portSPINLOCK_TYPE xSpinlock; /**< Protects uxEventBits. */
+        #endif
     } EventGroup_t;
 
 /*-----------------------------------------------------------*/
 
+/*
+ * The list of tasks waiting for bits is only accessed with the scheduler
+ * suspended, and interrupts only access an event group through a deferred
+ * function call, so without granular locks it is enough to use the kernel
+ * critical section where the event bits are accessed outside of a suspended
+ * scheduler.  With granular locks each event group is protected by its own
+ * spinlock, which must also be held while the event bits are accessed with the
+ * scheduler suspended, as the scheduler being suspended no longer prevents
+ * another core from entering the event group's critical section.
+ */
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #define event_groupsENTER_CRITICAL( pxEventBits )                                    taskDATA_GROUP_ENTER_CRITICAL( &( ( pxEventBits )->xSpinlock ) )
+        #define event_groupsEXIT_CRITICAL( pxEventBits )                                     taskDATA_GROUP_EXIT_CRITICAL( &( ( pxEventBits )->xSpinlock ) )
+        #define event_groupsENTER_CRITICAL_FROM_ISR( pxEventBits )                           taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( &( ( pxEventBits )->xSpinlock ) )
+        #define event_groupsEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxEventBits )    taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, &( ( pxEventBits )->xSpinlock ) )
+        #define event_groupsLOCK( pxEventBits )                                              event_groupsENTER_CRITICAL( pxEventBits )
+        #define event_groupsUNLOCK( pxEventBits )                                            event_groupsEXIT_CRITICAL( pxEventBits )
+    #else
+        #define event_groupsENTER_CRITICAL( pxEventBits )                                    taskENTER_CRITICAL()
+        #define event_groupsEXIT_CRITICAL( pxEventBits )                                     taskEXIT_CRITICAL()
+        #define event_groupsENTER_CRITICAL_FROM_ISR( pxEventBits )                           taskENTER_CRITICAL_FROM_ISR()
+        #define event_groupsEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxEventBits )    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+        #define event_groupsLOCK( pxEventBits )
+        #define event_groupsUNLOCK( pxEventBits )
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+/* The list on which a task waiting for bits is placed when it blocks. */
+    #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+        #define event_groupsGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )    prvGetWaitingList( ( pxEventBits ), ( uxBitsToWaitFor ), ( xWaitForAllBits ) )
+    #else
+        #define event_groupsGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )    ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+    #endif
+
+/*-----------------------------------------------------------*/
+
 /*
  * Test the bits set in uxCurrentEventBits to see if the wait condition is met.
  * The wait condition is defined by xWaitForAllBits.  If xWaitForAllBits is
@@ -79,6 +127,22 @@
                                             const EventBits_t uxBitsToWaitFor,
                                             const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used when configUSE_INDEXED_EVENT_GROUP_WAITERS is 1.  prvGetWaitingList()
+ * returns the list on which a task that is about to wait for bits is placed.
+ * prvUnblockIndexedTasks() unblocks the indexed tasks whose wait condition is
+ * met by setting uxBitsSet, re-indexes those that are still waiting, and
+ * returns the bits to clear on their exit.
+ */
+    #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+        static UBaseType_t prvLowestBitIndex( EventBits_t uxBits ) PRIVILEGED_FUNCTION;
+        static List_t * prvGetWaitingList( EventGroup_t * const pxEventBits,
+                                           const EventBits_t uxBitsToWaitFor,
+                                           const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+        static EventBits_t prvUnblockIndexedTasks( EventGroup_t * const pxEventBits,
+                                                   EventBits_t uxBitsSet ) PRIVILEGED_FUNCTION;
+    #endif
+
 /*-----------------------------------------------------------*/
 
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,6 +177,23 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+                {
+                    UBaseType_t uxBitIndex;
+
+                    for( uxBitIndex = 0; uxBitIndex < eventNUMBER_OF_USER_BITS; uxBitIndex++ )
+                    {
+                        vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBitIndex ] ) );
+                    }
+                }
+                #endif
+
+                #if ( configUSE_GRANULAR_LOCKS == 1 )
+                {
+                    portINIT_SPINLOCK( &( pxEventBits->xSpinlock ) );
+                }
+                #endif
+
                 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note that
@@ -158,6 +239,23 @@
                 pxEventBits->uxEventBits = 0;
                 vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+                #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+                {
+                    UBaseType_t uxBitIndex;
+
+                    for( uxBitIndex = 0; uxBitIndex < eventNUMBER_OF_USER_BITS; uxBitIndex++ )
+                    {
+                        vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBitIndex ] ) );
+                    }
+                }
+                #endif
+
+                #if ( configUSE_GRANULAR_LOCKS == 1 )
+                {
+                    portINIT_SPINLOCK( &( pxEventBits->xSpinlock ) );
+                }
+                #endif
+
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* Both static and dynamic allocation can be used, so note this
@@ -204,10 +302,16 @@
 
         vTaskSuspendAll();
         {
-            uxOriginalBitValue = pxEventBits->uxEventBits;
+            event_groupsLOCK( pxEventBits );
+            {
+                uxOriginalBitValue = pxEventBits->uxEventBits;
+            }
+            event_groupsUNLOCK( pxEventBits );
 
             ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
 
+            event_groupsLOCK( pxEventBits );
+
             if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
             {
                 /* All the rendezvous bits are now set - no need to block. */
@@ -228,7 +332,7 @@
                     /* Store the bits that the calling task is waiting for in the
                      * task's event list item so the kernel knows when a match is
                      * found.  Then enter the blocked state. */
-                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                    vTaskPlaceOnUnorderedEventList( event_groupsGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                     /* This assignment is obsolete as uxReturn will get set after
                      * the task unblocks, but some compilers mistakenly generate a
@@ -244,6 +348,8 @@
                     xTimeoutOccurred = pdTRUE;
                 }
             }
+
+            event_groupsUNLOCK( pxEventBits );
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -267,7 +373,7 @@
             if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
             {
                 /* The task timed out, just return the current event bit value. */
-                taskENTER_CRITICAL();
+                event_groupsENTER_CRITICAL( pxEventBits );
                 {
                     uxReturn = pxEventBits->uxEventBits;
 
@@ -284,7 +390,7 @@
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                taskEXIT_CRITICAL();
+                event_groupsEXIT_CRITICAL( pxEventBits );
 
                 xTimeoutOccurred = pdTRUE;
             }
@@ -334,6 +440,7 @@
         #endif
 
         vTaskSuspendAll();
+        event_groupsLOCK( pxEventBits );
         {
             const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
@@ -391,7 +498,7 @@
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( event_groupsGET_WAITING_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
                 /* This is obsolete as it will get set after the task unblocks, but
                  * some compilers mistakenly generate a warning about the variable
@@ -401,6 +508,7 @@
                 traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
             }
         }
+        event_groupsUNLOCK( pxEventBits );
         xAlreadyYielded = xTaskResumeAll();
 
         if( xTicksToWait != ( TickType_t ) 0 )
@@ -422,7 +530,7 @@
 
             if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
             {
-                taskENTER_CRITICAL();
+                event_groupsENTER_CRITICAL( pxEventBits );
                 {
                     /* The task timed out, just return the current event bit value. */
                     uxReturn = pxEventBits->uxEventBits;
@@ -447,7 +555,7 @@
 
                     xTimeoutOccurred = pdTRUE;
                 }
-                taskEXIT_CRITICAL();
+                event_groupsEXIT_CRITICAL( pxEventBits );
             }
             else
             {
@@ -482,7 +590,7 @@
         configASSERT( xEventGroup );
         configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-        taskENTER_CRITICAL();
+        event_groupsENTER_CRITICAL( pxEventBits );
         {
             traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear );
 
@@ -493,7 +601,7 @@
             /* Clear the bits. */
             pxEventBits->uxEventBits &= ~uxBitsToClear;
         }
-        taskEXIT_CRITICAL();
+        event_groupsEXIT_CRITICAL( pxEventBits );
 
         traceRETURN_xEventGroupClearBits( uxReturn );
 
@@ -524,7 +632,7 @@
     EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
     {
         UBaseType_t uxSavedInterruptStatus;
-        EventGroup_t const * const pxEventBits = xEventGroup;
+        EventGroup_t * const pxEventBits = xEventGroup;
         EventBits_t uxReturn;
 
         traceENTER_xEventGroupGetBitsFromISR( xEventGroup );
@@ -532,11 +640,11 @@
         /* MISRA Ref 4.7.1 [Return value shall be checked] */
         /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
         /* coverity[misra_c_2012_directive_4_7_violation] */
-        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        uxSavedInterruptStatus = event_groupsENTER_CRITICAL_FROM_ISR( pxEventBits );
         {
             uxReturn = pxEventBits->uxEventBits;
         }
-        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        event_groupsEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxEventBits );
 
         traceRETURN_xEventGroupGetBitsFromISR( uxReturn );
 
@@ -565,6 +673,7 @@
         pxList = &( pxEventBits->xTasksWaitingForBits );
         pxListEnd = listGET_END_MARKER( pxList );
         vTaskSuspendAll();
+        event_groupsLOCK( pxEventBits );
         {
             traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
@@ -632,10 +741,20 @@
                 pxListItem = pxNext;
             }
 
+            #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+            {
+                /* The list walked above only holds the tasks that are waiting
+                 * for any one of several bits.  The other tasks are indexed by
+                 * bit. */
+                uxBitsToClear |= prvUnblockIndexedTasks( pxEventBits, uxBitsToSet );
+            }
+            #endif
+
             /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
              * bit was set in the control word. */
             pxEventBits->uxEventBits &= ~uxBitsToClear;
         }
+        event_groupsUNLOCK( pxEventBits );
         ( void ) xTaskResumeAll();
 
         traceRETURN_xEventGroupSetBits( pxEventBits->uxEventBits );
@@ -666,6 +785,22 @@
                 configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
                 vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
             }
+
+            #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+            {
+                UBaseType_t uxBitIndex;
+
+                for( uxBitIndex = 0; uxBitIndex < eventNUMBER_OF_USER_BITS; uxBitIndex++ )
+                {
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ uxBitIndex ] );
+
+                    while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                    {
+                        vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+                    }
+                }
+            }
+            #endif
         }
         ( void ) xTaskResumeAll();
 
@@ -809,6 +944,128 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+
+        static UBaseType_t prvLowestBitIndex( EventBits_t uxBits )
+        {
+            UBaseType_t uxIndex = 0;
+
+            /* uxBits must not be zero. */
+            while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+            {
+                uxBits >>= 1;
+                uxIndex++;
+            }
+
+            return uxIndex;
+        }
+/*-----------------------------------------------------------*/
+
+        static List_t * prvGetWaitingList( EventGroup_t * const pxEventBits,
+                                           const EventBits_t uxBitsToWaitFor,
+                                           const BaseType_t xWaitForAllBits )
+        {
+            List_t * pxList = &( pxEventBits->xTasksWaitingForBits );
+            EventBits_t uxBitsNotSet;
+
+            /* A task waiting for all of its bits, or for a single bit, cannot
+             * have its wait condition met until each bit that is currently
+             * clear gets set, so is indexed by the lowest such bit.  A task
+             * waiting for any one of several bits could be unblocked by any of
+             * them, so is placed on the list that is checked on every set. */
+            if( ( xWaitForAllBits != pdFALSE ) || ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 ) )
+            {
+                uxBitsNotSet = uxBitsToWaitFor & ~( pxEventBits->uxEventBits );
+
+                if( uxBitsNotSet != ( EventBits_t ) 0 )
+                {
+                    pxList = &( pxEventBits->xTasksWaitingForBit[ prvLowestBitIndex( uxBitsNotSet ) ] );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxList;
+        }
+/*-----------------------------------------------------------*/
+
+        static EventBits_t prvUnblockIndexedTasks( EventGroup_t * const pxEventBits,
+                                                   EventBits_t uxBitsSet )
+        {
+            ListItem_t * pxListItem;
+            ListItem_t * pxNext;
+            ListItem_t const * pxListEnd;
+            List_t * pxList;
+            EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxBitsNotSet;
+            UBaseType_t uxBitIndex;
+
+            /* Must be called with the scheduler suspended, after the bits have
+             * been set.  Only the tasks indexed by one of the bits just set need
+             * to be checked. */
+            for( uxBitIndex = 0; uxBitsSet != ( EventBits_t ) 0; uxBitIndex++ )
+            {
+                if( ( uxBitsSet & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+                {
+                    pxList = &( pxEventBits->xTasksWaitingForBit[ uxBitIndex ] );
+                    pxListEnd = listGET_END_MARKER( pxList );
+                    pxListItem = listGET_HEAD_ENTRY( pxList );
+
+                    while( pxListItem != pxListEnd )
+                    {
+                        pxNext = listGET_NEXT( pxListItem );
+                        uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+                        uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+                        uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+                        uxBitsNotSet = uxBitsWaitedFor & ~( pxEventBits->uxEventBits );
+
+                        if( uxBitsNotSet == ( EventBits_t ) 0 )
+                        {
+                            /* All the bits are set.  As in xEventGroupSetBits(),
+                             * store the event bits in the task's event list item
+                             * as it is removed from the event list. */
+                            if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                            {
+                                uxBitsToClear |= uxBitsWaitedFor;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+                        }
+                        else
+                        {
+                            /* Still waiting for other bits, so index the task by
+                             * one of those instead.  That bit is clear, so is not
+                             * one of the bits being processed by this call. */
+                            ( void ) uxListRemove( pxListItem );
+                            vListInsertEnd( &( pxEventBits->xTasksWaitingForBit[ prvLowestBitIndex( uxBitsNotSet ) ] ), pxListItem );
+                        }
+
+                        pxListItem = pxNext;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxBitsSet >>= 1;
+            }
+
+            return uxBitsToClear;
+        }
+
+    #endif /* configUSE_INDEXED_EVENT_GROUP_WAITERS */
+/*-----------------------------------------------------------*/
+
     #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
         BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
@@ -97,17 +97,71 @@
  * undefined. */
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 
+/* Set configUSE_READY_PRIORITY_BITMAP to 1 to select the next task to run using
+ * a generic two level bitmap of the priorities that have Ready state tasks.  This
+ * gives constant time task selection on ports that do not provide a port
+ * optimised method, at the cost of up to 132 bytes of RAM.  Supports up to 1024
+ * priorities.  Cannot be used with configUSE_PORT_OPTIMISED_TASK_SELECTION or
+ * in SMP builds.  Defaults to 0 if left undefined. */
+#define configUSE_READY_PRIORITY_BITMAP            0
+
 /* Set configUSE_TICKLESS_IDLE to 1 to use the low power tickless mode.  Set to
  * 0 to keep the tick interrupt running at all times.  Not all FreeRTOS ports
  * support tickless mode. See https://www.freertos.org/low-power-tickless-rtos.html
  * Defaults to 0 if left undefined. */
 #define configUSE_TICKLESS_IDLE                    0
 
+/* Set configUSE_DYNAMIC_TICK to 1 to only generate tick interrupts when the
+ * kernel has work to do, such as when a task leaves the Blocked state or the
+ * running task is time sliced, whether or not the idle task is running.  The
+ * port must then provide portSET_NEXT_TICK_INTERRUPT() and call
+ * xTaskCatchUpTicksFromISR() from its timer interrupt.  Cannot be used with
+ * configUSE_TICKLESS_IDLE or in SMP builds.  Defaults to 0 if left undefined. */
+#define configUSE_DYNAMIC_TICK                     0
+
+/* Set configUSE_HIGH_RESOLUTION_TIMEOUTS to 1 to include xTaskDelayUntilNs(),
+ * xQueueReceiveUntilNs() and xSemaphoreTakeUntilNs(), which block until a
+ * deadline given in nanoseconds rather than for a number of ticks.  The port
+ * must provide portGET_HIGH_RESOLUTION_TIME_NS() and
+ * portSET_HIGH_RESOLUTION_TIMER().  Defaults to 0 if left undefined. */
+#define configUSE_HIGH_RESOLUTION_TIMEOUTS         0
+
+/* Set configUSE_DELAYED_TASK_HEAP to 1 to order the tasks that are in the
+ * Blocked state with a timeout using a pairing heap, which makes the cost of
+ * entering the Blocked state independent of the number of tasks already in the
+ * Blocked state.  Set to 0 to use a sorted list, which uses less RAM per task.
+ * Defaults to 0 if left undefined. */
+#define configUSE_DELAYED_TASK_HEAP                0
+
+/* Set configUSE_BATCHED_TICK_WAKE_UP to 1 to have the tick interrupt remove all
+ * the tasks it unblocks from the delayed task list in one operation, which
+ * shortens the tick interrupt when many tasks unblock on the same tick.  Cannot
+ * be used with configUSE_DELAYED_TASK_HEAP.  Defaults to 0 if left undefined. */
+#define configUSE_BATCHED_TICK_WAKE_UP             0
+
+/* Set configUSE_DEFERRED_TICK_PROCESSING to 1 to have a tick interrupt that
+ * would unblock tasks only count the tick and request a context switch, with
+ * the tasks being unblocked by the context switch.  That keeps the time spent
+ * in the tick interrupt constant.  As such a tick always causes a context
+ * switch, tasks of equal priority can be rotated on it even when
+ * configUSE_TIME_SLICING is 0.  Only supported in single core FreeRTOS.
+ * Defaults to 0 if left undefined. */
+#define configUSE_DEFERRED_TICK_PROCESSING         0
+
 /* configMAX_PRIORITIES Sets the number of available task priorities.  Tasks can
  * be assigned priorities of 0 to (configMAX_PRIORITIES - 1).  Zero is the lowest
  * priority. */
 #define configMAX_PRIORITIES                       5
 
+/* Set configUSE_EDF_SCHEDULING to 1 to schedule the tasks created using
+ * xTaskCreateEDF() by earliest deadline first.  EDF tasks all run at priority
+ * configEDF_PRIORITY, which defaults to (configMAX_PRIORITIES - 1) if left
+ * undefined, and the EDF task with the earliest absolute deadline is selected
+ * from among them.  configEDF_PRIORITY is reserved for EDF tasks, so
+ * configTIMER_TASK_PRIORITY must be set to a different priority.  Only
+ * available in single core builds.  Defaults to 0 if left undefined. */
+#define configUSE_EDF_SCHEDULING                   0
+
 /* configMINIMAL_STACK_SIZE defines the size of the stack used by the Idle task
  * (in words, not in bytes!).  The kernel does not use this constant for any other
  * purpose.  Demo applications use the constant to make the demos somewhat portable
@@ -247,6 +301,14 @@
 
 #define configUSE_EVENT_GROUPS    1
 
+/* Set configUSE_INDEXED_EVENT_GROUP_WAITERS to 1 to index the tasks blocked on
+ * an event group by the bits they are waiting for, so setting bits only checks
+ * the tasks that could be unblocked by those bits, rather than every task that
+ * is blocked on the event group.  Tasks waiting for any one of several bits are
+ * still checked on every set.  Increases the size of each event group by one
+ * list for each event bit.  Defaults to 0 if left undefined. */
+#define configUSE_INDEXED_EVENT_GROUP_WAITERS    0
+
 /******************************************************************************/
 /* Stream Buffer related definitions. *****************************************/
 /******************************************************************************/
@@ -258,6 +320,19 @@
 
 #define configUSE_STREAM_BUFFERS    1
 
+/* Set configUSE_MPMC_STREAM_BUFFERS to 1 to allow stream and message buffers
+ * to be created that can be written by more than one task and read by more
+ * than one task at a time without the application serialising access with a
+ * mutex.  Such buffers can only be used from tasks, not interrupts.  Defaults
+ * to 0 if left undefined. */
+#define configUSE_MPMC_STREAM_BUFFERS    0
+
+/* Set configUSE_BROADCAST_MESSAGE_BUFFERS to 1 to allow message buffers to be
+ * created that deliver every message written by a single writer to any number
+ * of subscribed readers, each of which reads at its own pace.  Defaults to 0 if
+ * left undefined. */
+#define configUSE_BROADCAST_MESSAGE_BUFFERS    0
+
 /******************************************************************************/
 /* Memory allocation related definitions. *************************************/
 /******************************************************************************/
@@ -366,6 +441,12 @@
  * if left undefined.  See https://www.freertos.org/rtos-run-time-stats.html. */
 #define configGENERATE_RUN_TIME_STATS           0
 
+/* Set configUSE_TASK_BUDGETS to 1 to include the xTaskSetBudget() function,
+ * which limits the processing time a task can use within each period.  Requires
+ * configGENERATE_RUN_TIME_STATS to be set to 1.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_TASK_BUDGETS                  0
+
 /* Set configUSE_TRACE_FACILITY to include additional task structure members
  * are used by trace and visualisation functions and tools.  Set to 0 to exclude
  * the additional information from the structures. Defaults to 0 if left
@@ -538,6 +619,26 @@
  * of a separate task. Defaults to 0 if left undefined. */
 #define configUSE_PASSIVE_IDLE_HOOK               0
 
+/* When using SMP (i.e. configNUMBER_OF_CORES is greater than one), set
+ * configUSE_PER_CORE_READY_LISTS to 1 to give each core its own set of ready
+ * lists.  A core selects from its own ready lists first and only takes a task
+ * from a sibling core's ready lists when it has no task of the same priority
+ * to run, so the scheduler does not have to step over tasks that are running
+ * on other cores.  The highest priority ready tasks still run on all cores.
+ * Defaults to 0 if left undefined. */
+#define configUSE_PER_CORE_READY_LISTS            0
+
+/* When using SMP (i.e. configNUMBER_OF_CORES is greater than one), set
+ * configUSE_GRANULAR_LOCKS to 1 to protect each queue, semaphore, event group
+ * and stream buffer with its own spinlock rather than the kernel wide critical
+ * section, so operations on different objects do not serialise each other.
+ * Mutexes continue to use the kernel critical section, so cannot be added to
+ * a queue set.  The port must provide portSPINLOCK_TYPE, portINIT_SPINLOCK(),
+ * portGET_SPINLOCK() and portRELEASE_SPINLOCK().  Locks are always taken in
+ * the order TASK lock, object spinlock, ISR lock.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_GRANULAR_LOCKS                  0
+
 /* When using SMP (i.e. configNUMBER_OF_CORES is greater than one),
  * configTIMER_SERVICE_TASK_CORE_AFFINITY allows the application writer to set
  * the core affinity of the RTOS Daemon/Timer Service task. Defaults to
@@ -619,11 +720,35 @@
  * the build, or 0 to exclude the named feature from the build. */
 #define configUSE_TASK_NOTIFICATIONS           1
 #define configUSE_MUTEXES                      1
+#define configUSE_MUTEX_PRIORITY_CEILING       0
+#define configUSE_MUTEX_FAST_PATH              0
+#define configUSE_RW_LOCKS                     0
 #define configUSE_RECURSIVE_MUTEXES            1
 #define configUSE_COUNTING_SEMAPHORES          1
 #define configUSE_QUEUE_SETS                   0
+#define configUSE_QUEUE_SET_READY_LIST         0
+#define configUSE_QUEUE_ZERO_COPY              0
+#define configUSE_QUEUE_BATCH_OPERATIONS       0
 #define configUSE_APPLICATION_TASK_TAG         0
 
+/* Set configUSE_MPMC_QUEUES to 1 to include the lock-free multi-producer
+ * multi-consumer queues created by xMpmcQueueCreate().  When
+ * configNUMBER_OF_CORES is greater than 1 the atomic.h operations must be
+ * atomic across cores and portMEMORY_FENCE() must be a full hardware memory
+ * fence.  GCC builds default portMEMORY_FENCE() to __sync_synchronize(), other
+ * compilers need the port to define it.  Defaults to 0 if left undefined. */
+#define configUSE_MPMC_QUEUES                  0
+
+/* Set configUSE_PRIORITY_EVENT_LISTS to 1 to give the lists of tasks blocked on
+ * each queue and semaphore an index, so a task blocks in constant time however
+ * many other tasks are blocked on the same object.  Tasks of equal priority
+ * are still unblocked in the order they blocked.  The index adds
+ * ( 8 + ( configMAX_PRIORITIES * sizeof( void * ) ) ) bytes or more to each of
+ * the two lists in every queue and semaphore, and a pointer to every list.
+ * Cannot be used with configUSE_GRANULAR_LOCKS.  Defaults to 0 if left
+ * undefined. */
+#define configUSE_PRIORITY_EVENT_LISTS         0
+
 /* Set the following INCLUDE_* constants to 1 to incldue the named API function,
  * or 0 to exclude the named API function.  Most linkers will remove unused
  * functions even when the constant is 1. */
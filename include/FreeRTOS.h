@@ -314,6 +314,18 @@
     #define configUSE_MUTEXES    0
 #endif
 
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+    #define configUSE_MUTEX_PRIORITY_CEILING    0
+#endif
+
+#ifndef configUSE_MUTEX_FAST_PATH
+    #define configUSE_MUTEX_FAST_PATH    0
+#endif
+
+#ifndef configUSE_RW_LOCKS
+    #define configUSE_RW_LOCKS    0
+#endif
+
 #ifndef configUSE_TIMERS
     #define configUSE_TIMERS    0
 #endif
@@ -322,10 +334,30 @@
     #define configUSE_EVENT_GROUPS    1
 #endif
 
+#ifndef configUSE_INDEXED_EVENT_GROUP_WAITERS
+    #define configUSE_INDEXED_EVENT_GROUP_WAITERS    0
+#endif
+
 #ifndef configUSE_STREAM_BUFFERS
     #define configUSE_STREAM_BUFFERS    1
 #endif
 
+#ifndef configUSE_MPMC_STREAM_BUFFERS
+    #define configUSE_MPMC_STREAM_BUFFERS    0
+#endif
+
+#if ( ( configUSE_MPMC_STREAM_BUFFERS == 1 ) && ( configUSE_STREAM_BUFFERS != 1 ) )
+    #error configUSE_MPMC_STREAM_BUFFERS cannot be set to 1 unless configUSE_STREAM_BUFFERS is also set to 1.
+#endif
+
+#ifndef configUSE_BROADCAST_MESSAGE_BUFFERS
+    #define configUSE_BROADCAST_MESSAGE_BUFFERS    0
+#endif
+
+#if ( ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 ) && ( configUSE_STREAM_BUFFERS != 1 ) )
+    #error configUSE_BROADCAST_MESSAGE_BUFFERS cannot be set to 1 unless configUSE_STREAM_BUFFERS is also set to 1.
+#endif
+
 #ifndef configUSE_DAEMON_TASK_STARTUP_HOOK
     #define configUSE_DAEMON_TASK_STARTUP_HOOK    0
 #endif
@@ -402,6 +434,18 @@
     #define portSOFTWARE_BARRIER()
 #endif
 
+/* portMEMORY_FENCE() must order all earlier loads and stores before all later
+ * loads and stores, as observed by every core.  With a single core the
+ * compiler barrier is enough.  Ports on which portMEMORY_BARRIER() is already
+ * a full hardware fence can define portMEMORY_FENCE() as portMEMORY_BARRIER(). */
+#ifndef portMEMORY_FENCE
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define portMEMORY_FENCE()    portMEMORY_BARRIER()
+    #elif defined( __GNUC__ )
+        #define portMEMORY_FENCE()    __sync_synchronize()
+    #endif
+#endif
+
 #ifndef configRUN_MULTIPLE_PRIORITIES
     #define configRUN_MULTIPLE_PRIORITIES    0
 #endif
@@ -512,6 +556,61 @@
     #define configUSE_PASSIVE_IDLE_HOOK    0
 #endif /* configUSE_PASSIVE_IDLE_HOOK */
 
+#ifndef configUSE_PER_CORE_READY_LISTS
+    #define configUSE_PER_CORE_READY_LISTS    0
+#endif /* configUSE_PER_CORE_READY_LISTS */
+
+#ifndef configUSE_GRANULAR_LOCKS
+    #define configUSE_GRANULAR_LOCKS    0
+#endif /* configUSE_GRANULAR_LOCKS */
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    #ifndef portSPINLOCK_TYPE
+        #error portSPINLOCK_TYPE is required when configUSE_GRANULAR_LOCKS is set to 1
+    #endif
+
+    #ifndef portINIT_SPINLOCK
+        #error portINIT_SPINLOCK is required when configUSE_GRANULAR_LOCKS is set to 1
+    #endif
+
+    #ifndef portGET_SPINLOCK
+        #error portGET_SPINLOCK is required when configUSE_GRANULAR_LOCKS is set to 1
+    #endif
+
+    #ifndef portRELEASE_SPINLOCK
+        #error portRELEASE_SPINLOCK is required when configUSE_GRANULAR_LOCKS is set to 1
+    #endif
+
+#endif /* configUSE_GRANULAR_LOCKS */
+
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING    0
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* The priority at which tasks created with xTaskCreateEDF() run.  Tasks of a
+ * higher priority preempt EDF tasks, tasks of a lower priority only run when no
+ * EDF task is ready. */
+    #ifndef configEDF_PRIORITY
+        #define configEDF_PRIORITY    ( configMAX_PRIORITIES - 1 )
+    #endif
+
+    #if ( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configEDF_PRIORITY must be greater than 0 and less than configMAX_PRIORITIES
+    #endif
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#ifndef configUSE_TASK_BUDGETS
+    #define configUSE_TASK_BUDGETS    0
+#endif /* configUSE_TASK_BUDGETS */
+
+#if ( ( configUSE_TASK_BUDGETS == 1 ) && ( configGENERATE_RUN_TIME_STATS != 1 ) )
+    #error configGENERATE_RUN_TIME_STATS must be set to 1 when configUSE_TASK_BUDGETS is set to 1 as task budgets are measured using the run time counter
+#endif
+
 /* The timers module relies on xTaskGetSchedulerState(). */
 #if configUSE_TIMERS == 1
 
@@ -837,6 +936,10 @@
     #define traceTASK_DELAY()
 #endif
 
+#ifndef traceTASK_BUDGET_EXHAUSTED
+    #define traceTASK_BUDGET_EXHAUSTED( pxTask )
+#endif
+
 #ifndef traceTASK_PRIORITY_SET
     #define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )
 #endif
@@ -1205,6 +1308,22 @@
     #define traceRETURN_xQueueCreateMutexStatic( xNewQueue )
 #endif
 
+#ifndef traceENTER_xQueueCreateMutexWithCeiling
+    #define traceENTER_xQueueCreateMutexWithCeiling( ucQueueType, uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_xQueueCreateMutexWithCeiling
+    #define traceRETURN_xQueueCreateMutexWithCeiling( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateMutexWithCeilingStatic
+    #define traceENTER_xQueueCreateMutexWithCeilingStatic( ucQueueType, uxCeilingPriority, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateMutexWithCeilingStatic
+    #define traceRETURN_xQueueCreateMutexWithCeilingStatic( xNewQueue )
+#endif
+
 #ifndef traceENTER_xQueueGetMutexHolder
     #define traceENTER_xQueueGetMutexHolder( xSemaphore )
 #endif
@@ -1237,6 +1356,54 @@
     #define traceRETURN_xQueueTakeMutexRecursive( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueCreateRwLock
+    #define traceENTER_xQueueCreateRwLock()
+#endif
+
+#ifndef traceRETURN_xQueueCreateRwLock
+    #define traceRETURN_xQueueCreateRwLock( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueCreateRwLockStatic
+    #define traceENTER_xQueueCreateRwLockStatic( pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCreateRwLockStatic
+    #define traceRETURN_xQueueCreateRwLockStatic( xNewQueue )
+#endif
+
+#ifndef traceENTER_xQueueTakeRwLock
+    #define traceENTER_xQueueTakeRwLock( xRwLock, xWrite, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueTakeRwLock
+    #define traceRETURN_xQueueTakeRwLock( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueGiveRwLock
+    #define traceENTER_xQueueGiveRwLock( xRwLock, xWrite )
+#endif
+
+#ifndef traceRETURN_xQueueGiveRwLock
+    #define traceRETURN_xQueueGiveRwLock( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueTakeRwLockFromISR
+    #define traceENTER_xQueueTakeRwLockFromISR( xRwLock )
+#endif
+
+#ifndef traceRETURN_xQueueTakeRwLockFromISR
+    #define traceRETURN_xQueueTakeRwLockFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueGiveRwLockFromISR
+    #define traceENTER_xQueueGiveRwLockFromISR( xRwLock, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueGiveRwLockFromISR
+    #define traceRETURN_xQueueGiveRwLockFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueCreateCountingSemaphoreStatic
     #define traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue )
 #endif
@@ -1285,6 +1452,14 @@
     #define traceRETURN_xQueueReceive( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueReceiveUntilNs
+    #define traceENTER_xQueueReceiveUntilNs( xQueue, pvBuffer, ullDeadlineNs )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveUntilNs
+    #define traceRETURN_xQueueReceiveUntilNs( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueSemaphoreTake
     #define traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait )
 #endif
@@ -1293,6 +1468,14 @@
     #define traceRETURN_xQueueSemaphoreTake( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueSemaphoreTakeUntilNs
+    #define traceENTER_xQueueSemaphoreTakeUntilNs( xQueue, ullDeadlineNs )
+#endif
+
+#ifndef traceRETURN_xQueueSemaphoreTakeUntilNs
+    #define traceRETURN_xQueueSemaphoreTakeUntilNs( xReturn )
+#endif
+
 #ifndef traceENTER_xQueuePeek
     #define traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait )
 #endif
@@ -1317,6 +1500,102 @@
     #define traceRETURN_xQueuePeekFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueReserve
+    #define traceENTER_xQueueReserve( xQueue, ppvSlot, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReserve
+    #define traceRETURN_xQueueReserve( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueCommit
+    #define traceENTER_xQueueCommit( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueCommit
+    #define traceRETURN_xQueueCommit( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueAcquire
+    #define traceENTER_xQueueAcquire( xQueue, ppvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueAcquire
+    #define traceRETURN_xQueueAcquire( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueRelease
+    #define traceENTER_xQueueRelease( xQueue )
+#endif
+
+#ifndef traceRETURN_xQueueRelease
+    #define traceRETURN_xQueueRelease( xReturn )
+#endif
+
+#ifndef traceENTER_uxQueueSendMultiple
+    #define traceENTER_uxQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxQueueSendMultiple
+    #define traceRETURN_uxQueueSendMultiple( uxItemsSent )
+#endif
+
+#ifndef traceENTER_uxQueueReceiveMultiple
+    #define traceENTER_uxQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxQueueReceiveMultiple
+    #define traceRETURN_uxQueueReceiveMultiple( uxItemsReceived )
+#endif
+
+#ifndef traceENTER_uxQueueSendMultipleFromISR
+    #define traceENTER_uxQueueSendMultipleFromISR( xQueue, pvItemsToQueue, uxItemCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueSendMultipleFromISR
+    #define traceRETURN_uxQueueSendMultipleFromISR( uxItemsSent )
+#endif
+
+#ifndef traceENTER_uxQueueReceiveMultipleFromISR
+    #define traceENTER_uxQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxMaxItems, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueReceiveMultipleFromISR
+    #define traceRETURN_uxQueueReceiveMultipleFromISR( uxItemsReceived )
+#endif
+
+#ifndef traceENTER_uxQueueSemaphoreGiveMultiple
+    #define traceENTER_uxQueueSemaphoreGiveMultiple( xQueue, uxCount )
+#endif
+
+#ifndef traceRETURN_uxQueueSemaphoreGiveMultiple
+    #define traceRETURN_uxQueueSemaphoreGiveMultiple( uxGiven )
+#endif
+
+#ifndef traceENTER_uxQueueSemaphoreTakeMultiple
+    #define traceENTER_uxQueueSemaphoreTakeMultiple( xQueue, uxMaxCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_uxQueueSemaphoreTakeMultiple
+    #define traceRETURN_uxQueueSemaphoreTakeMultiple( uxTaken )
+#endif
+
+#ifndef traceENTER_uxQueueSemaphoreGiveMultipleFromISR
+    #define traceENTER_uxQueueSemaphoreGiveMultipleFromISR( xQueue, uxCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueSemaphoreGiveMultipleFromISR
+    #define traceRETURN_uxQueueSemaphoreGiveMultipleFromISR( uxGiven )
+#endif
+
+#ifndef traceENTER_uxQueueSemaphoreTakeMultipleFromISR
+    #define traceENTER_uxQueueSemaphoreTakeMultipleFromISR( xQueue, uxMaxCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_uxQueueSemaphoreTakeMultipleFromISR
+    #define traceRETURN_uxQueueSemaphoreTakeMultipleFromISR( uxTaken )
+#endif
+
 #ifndef traceENTER_uxQueueMessagesWaiting
     #define traceENTER_uxQueueMessagesWaiting( xQueue )
 #endif
@@ -1509,6 +1788,54 @@
     #define traceRETURN_xQueueSelectFromSetFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xMpmcQueueCreate
+    #define traceENTER_xMpmcQueueCreate( uxQueueLength, uxItemSize )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueCreate
+    #define traceRETURN_xMpmcQueueCreate( pxNewQueue )
+#endif
+
+#ifndef traceENTER_xMpmcQueueCreateStatic
+    #define traceENTER_xMpmcQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueCreateStatic
+    #define traceRETURN_xMpmcQueueCreateStatic( pxNewQueue )
+#endif
+
+#ifndef traceENTER_xMpmcQueueSend
+    #define traceENTER_xMpmcQueueSend( xQueue, pvItemToQueue, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueSend
+    #define traceRETURN_xMpmcQueueSend( xReturn )
+#endif
+
+#ifndef traceENTER_xMpmcQueueReceive
+    #define traceENTER_xMpmcQueueReceive( xQueue, pvBuffer, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xMpmcQueueReceive
+    #define traceRETURN_xMpmcQueueReceive( xReturn )
+#endif
+
+#ifndef traceENTER_uxMpmcQueueMessagesWaiting
+    #define traceENTER_uxMpmcQueueMessagesWaiting( xQueue )
+#endif
+
+#ifndef traceRETURN_uxMpmcQueueMessagesWaiting
+    #define traceRETURN_uxMpmcQueueMessagesWaiting( uxReturn )
+#endif
+
+#ifndef traceENTER_vMpmcQueueDelete
+    #define traceENTER_vMpmcQueueDelete( xQueue )
+#endif
+
+#ifndef traceRETURN_vMpmcQueueDelete
+    #define traceRETURN_vMpmcQueueDelete()
+#endif
+
 #ifndef traceENTER_xTimerCreateTimerTask
     #define traceENTER_xTimerCreateTimerTask()
 #endif
@@ -1733,6 +2060,14 @@
     #define traceRETURN_xTaskCreateAffinitySet( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreateEDF
+    #define traceENTER_xTaskCreateEDF( pxTaskCode, pcName, uxStackDepth, pvParameters, xRelativeDeadline, xPeriod, pxCreatedTask )
+#endif
+
+#ifndef traceRETURN_xTaskCreateEDF
+    #define traceRETURN_xTaskCreateEDF( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskDelete
     #define traceENTER_vTaskDelete( xTaskToDelete )
 #endif
@@ -1749,6 +2084,38 @@
     #define traceRETURN_xTaskDelayUntil( xShouldDelay )
 #endif
 
+#ifndef traceENTER_xTaskDelayUntilNextPeriod
+    #define traceENTER_xTaskDelayUntilNextPeriod( pxPreviousWakeTime )
+#endif
+
+#ifndef traceRETURN_xTaskDelayUntilNextPeriod
+    #define traceRETURN_xTaskDelayUntilNextPeriod( xShouldDelay )
+#endif
+
+#ifndef traceENTER_xTaskDelayUntilNs
+    #define traceENTER_xTaskDelayUntilNs( ullDeadlineNs )
+#endif
+
+#ifndef traceRETURN_xTaskDelayUntilNs
+    #define traceRETURN_xTaskDelayUntilNs( xShouldDelay )
+#endif
+
+#ifndef traceENTER_xTaskGetDeadline
+    #define traceENTER_xTaskGetDeadline( xTask )
+#endif
+
+#ifndef traceRETURN_xTaskGetDeadline
+    #define traceRETURN_xTaskGetDeadline( xDeadline )
+#endif
+
+#ifndef traceENTER_xTaskSetBudget
+    #define traceENTER_xTaskSetBudget( xTask, ulBudget, xPeriod )
+#endif
+
+#ifndef traceRETURN_xTaskSetBudget
+    #define traceRETURN_xTaskSetBudget( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskDelay
     #define traceENTER_vTaskDelay( xTicksToDelay )
 #endif
@@ -1909,6 +2276,14 @@
     #define traceRETURN_xTaskGetTickCountFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_ullTaskGetTimeNs
+    #define traceENTER_ullTaskGetTimeNs()
+#endif
+
+#ifndef traceRETURN_ullTaskGetTimeNs
+    #define traceRETURN_ullTaskGetTimeNs( ullTimeNs )
+#endif
+
 #ifndef traceENTER_uxTaskGetNumberOfTasks
     #define traceENTER_uxTaskGetNumberOfTasks()
 #endif
@@ -1985,6 +2360,14 @@
     #define traceRETURN_xTaskCatchUpTicks( xYieldOccurred )
 #endif
 
+#ifndef traceENTER_xTaskCatchUpTicksFromISR
+    #define traceENTER_xTaskCatchUpTicksFromISR( xTicksToCatchUp )
+#endif
+
+#ifndef traceRETURN_xTaskCatchUpTicksFromISR
+    #define traceRETURN_xTaskCatchUpTicksFromISR( xSwitchRequired )
+#endif
+
 #ifndef traceENTER_xTaskAbortDelay
     #define traceENTER_xTaskAbortDelay( xTask )
 #endif
@@ -2105,6 +2488,30 @@
     #define traceRETURN_xTaskCheckForTimeOut( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskInternalSetDeadlineNs
+    #define traceENTER_xTaskInternalSetDeadlineNs( ullDeadlineNs )
+#endif
+
+#ifndef traceRETURN_xTaskInternalSetDeadlineNs
+    #define traceRETURN_xTaskInternalSetDeadlineNs( xTicksToWait )
+#endif
+
+#ifndef traceENTER_vTaskInternalClearDeadlineNs
+    #define traceENTER_vTaskInternalClearDeadlineNs()
+#endif
+
+#ifndef traceRETURN_vTaskInternalClearDeadlineNs
+    #define traceRETURN_vTaskInternalClearDeadlineNs()
+#endif
+
+#ifndef traceENTER_xTaskCheckDeadlinesFromISR
+    #define traceENTER_xTaskCheckDeadlinesFromISR()
+#endif
+
+#ifndef traceRETURN_xTaskCheckDeadlinesFromISR
+    #define traceRETURN_xTaskCheckDeadlinesFromISR( xSwitchRequired )
+#endif
+
 #ifndef traceENTER_vTaskMissedYield
     #define traceENTER_vTaskMissedYield()
 #endif
@@ -2225,6 +2632,14 @@
     #define traceRETURN_xTaskPriorityDisinherit( xReturn )
 #endif
 
+#ifndef traceENTER_vTaskPriorityRaiseToCeiling
+    #define traceENTER_vTaskPriorityRaiseToCeiling( pxMutexHolder, uxCeilingPriority )
+#endif
+
+#ifndef traceRETURN_vTaskPriorityRaiseToCeiling
+    #define traceRETURN_vTaskPriorityRaiseToCeiling()
+#endif
+
 #ifndef traceENTER_vTaskPriorityDisinheritAfterTimeout
     #define traceENTER_vTaskPriorityDisinheritAfterTimeout( pxMutexHolder, uxHighestPriorityWaitingTask )
 #endif
@@ -2273,6 +2688,38 @@
     #define traceRETURN_vTaskExitCriticalFromISR()
 #endif
 
+#ifndef traceENTER_vTaskDataGroupEnterCritical
+    #define traceENTER_vTaskDataGroupEnterCritical( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupEnterCritical
+    #define traceRETURN_vTaskDataGroupEnterCritical()
+#endif
+
+#ifndef traceENTER_uxTaskDataGroupEnterCriticalFromISR
+    #define traceENTER_uxTaskDataGroupEnterCriticalFromISR( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_uxTaskDataGroupEnterCriticalFromISR
+    #define traceRETURN_uxTaskDataGroupEnterCriticalFromISR( uxSavedInterruptStatus )
+#endif
+
+#ifndef traceENTER_vTaskDataGroupExitCritical
+    #define traceENTER_vTaskDataGroupExitCritical( pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupExitCritical
+    #define traceRETURN_vTaskDataGroupExitCritical()
+#endif
+
+#ifndef traceENTER_vTaskDataGroupExitCriticalFromISR
+    #define traceENTER_vTaskDataGroupExitCriticalFromISR( uxSavedInterruptStatus, pxSpinlock )
+#endif
+
+#ifndef traceRETURN_vTaskDataGroupExitCriticalFromISR
+    #define traceRETURN_vTaskDataGroupExitCriticalFromISR()
+#endif
+
 #ifndef traceENTER_vTaskListTasks
     #define traceENTER_vTaskListTasks( pcWriteBuffer, uxBufferLength )
 #endif
@@ -2305,6 +2752,14 @@
     #define traceRETURN_pvTaskIncrementMutexHeldCount( pxTCB )
 #endif
 
+#ifndef traceENTER_xTaskDecrementMutexHeldCount
+    #define traceENTER_xTaskDecrementMutexHeldCount()
+#endif
+
+#ifndef traceRETURN_xTaskDecrementMutexHeldCount
+    #define traceRETURN_xTaskDecrementMutexHeldCount( xReturn )
+#endif
+
 #ifndef traceENTER_ulTaskGenericNotifyTake
     #define traceENTER_ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait )
 #endif
@@ -2481,6 +2936,14 @@
     #define traceRETURN_xStreamBufferSend( xReturn )
 #endif
 
+#ifndef traceENTER_xStreamBufferSendV
+    #define traceENTER_xStreamBufferSendV( xStreamBuffer, pxVectors, uxVectorCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSendV
+    #define traceRETURN_xStreamBufferSendV( xReturn )
+#endif
+
 #ifndef traceENTER_xStreamBufferSendFromISR
     #define traceENTER_xStreamBufferSendFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken )
 #endif
@@ -2497,6 +2960,46 @@
     #define traceRETURN_xStreamBufferReceive( xReceivedLength )
 #endif
 
+#ifndef traceENTER_xStreamBufferReceiveV
+    #define traceENTER_xStreamBufferReceiveV( xStreamBuffer, pxVectors, uxVectorCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveV
+    #define traceRETURN_xStreamBufferReceiveV( xReceivedLength )
+#endif
+
+#ifndef traceENTER_xStreamBufferPublish
+    #define traceENTER_xStreamBufferPublish( xStreamBuffer, pvTxData, xDataLengthBytes )
+#endif
+
+#ifndef traceRETURN_xStreamBufferPublish
+    #define traceRETURN_xStreamBufferPublish( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferPublishFromISR
+    #define traceENTER_xStreamBufferPublishFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferPublishFromISR
+    #define traceRETURN_xStreamBufferPublishFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_vStreamBufferSubscribe
+    #define traceENTER_vStreamBufferSubscribe( xStreamBuffer, pxSubscriber )
+#endif
+
+#ifndef traceRETURN_vStreamBufferSubscribe
+    #define traceRETURN_vStreamBufferSubscribe()
+#endif
+
+#ifndef traceENTER_xStreamBufferReceiveSubscribed
+    #define traceENTER_xStreamBufferReceiveSubscribed( xStreamBuffer, pxSubscriber, pvRxData, xBufferLengthBytes, pxMessagesLost, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveSubscribed
+    #define traceRETURN_xStreamBufferReceiveSubscribed( xReceivedLength )
+#endif
+
 #ifndef traceENTER_xStreamBufferNextMessageLengthBytes
     #define traceENTER_xStreamBufferNextMessageLengthBytes( xStreamBuffer )
 #endif
@@ -2505,6 +3008,86 @@
     #define traceRETURN_xStreamBufferNextMessageLengthBytes( xReturn )
 #endif
 
+#ifndef traceENTER_xStreamBufferSendItem
+    #define traceENTER_xStreamBufferSendItem( xStreamBuffer, pvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSendItem
+    #define traceRETURN_xStreamBufferSendItem( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferSendItemFromISR
+    #define traceENTER_xStreamBufferSendItemFromISR( xStreamBuffer, pvItem, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferSendItemFromISR
+    #define traceRETURN_xStreamBufferSendItemFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferReceiveItem
+    #define traceENTER_xStreamBufferReceiveItem( xStreamBuffer, pvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveItem
+    #define traceRETURN_xStreamBufferReceiveItem( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferReceiveItemFromISR
+    #define traceENTER_xStreamBufferReceiveItemFromISR( xStreamBuffer, pvItem, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferReceiveItemFromISR
+    #define traceRETURN_xStreamBufferReceiveItemFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferGetWriteRegion
+    #define traceENTER_xStreamBufferGetWriteRegion( xStreamBuffer, ppvRegion, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferGetWriteRegion
+    #define traceRETURN_xStreamBufferGetWriteRegion( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferCommitWrite
+    #define traceENTER_xStreamBufferCommitWrite( xStreamBuffer, xBytesWritten )
+#endif
+
+#ifndef traceRETURN_xStreamBufferCommitWrite
+    #define traceRETURN_xStreamBufferCommitWrite( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferCommitWriteFromISR
+    #define traceENTER_xStreamBufferCommitWriteFromISR( xStreamBuffer, xBytesWritten, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferCommitWriteFromISR
+    #define traceRETURN_xStreamBufferCommitWriteFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferGetReadRegion
+    #define traceENTER_xStreamBufferGetReadRegion( xStreamBuffer, ppvRegion, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xStreamBufferGetReadRegion
+    #define traceRETURN_xStreamBufferGetReadRegion( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferConsume
+    #define traceENTER_xStreamBufferConsume( xStreamBuffer, xBytesRead )
+#endif
+
+#ifndef traceRETURN_xStreamBufferConsume
+    #define traceRETURN_xStreamBufferConsume( xReturn )
+#endif
+
+#ifndef traceENTER_xStreamBufferConsumeFromISR
+    #define traceENTER_xStreamBufferConsumeFromISR( xStreamBuffer, xBytesRead, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xStreamBufferConsumeFromISR
+    #define traceRETURN_xStreamBufferConsumeFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_xStreamBufferReceiveFromISR
     #define traceENTER_xStreamBufferReceiveFromISR( xStreamBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken )
 #endif
@@ -2625,6 +3208,22 @@
     #define traceRETURN_uxListRemove( uxNumberOfItems )
 #endif
 
+#ifndef traceENTER_vListInitialisePriorityIndex
+    #define traceENTER_vListInitialisePriorityIndex( pxList, pxPriorityIndex )
+#endif
+
+#ifndef traceRETURN_vListInitialisePriorityIndex
+    #define traceRETURN_vListInitialisePriorityIndex()
+#endif
+
+#ifndef traceENTER_vListPriorityIndexRemove
+    #define traceENTER_vListPriorityIndexRemove( pxList, pxItemToRemove )
+#endif
+
+#ifndef traceRETURN_vListPriorityIndexRemove
+    #define traceRETURN_vListPriorityIndexRemove()
+#endif
+
 #ifndef traceENTER_xCoRoutineCreate
     #define traceENTER_xCoRoutineCreate( pxCoRoutineCode, uxPriority, uxIndex )
 #endif
@@ -2703,6 +3302,58 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
+#ifndef configUSE_DYNAMIC_TICK
+    #define configUSE_DYNAMIC_TICK    0
+#endif
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/* portSET_NEXT_TICK_INTERRUPT( xTicksToNextTick ) programs the port's one shot
+ * timer to interrupt xTicksToNextTick tick periods after the last tick passed
+ * to xTaskCatchUpTicksFromISR(), replacing any interrupt already programmed.
+ * It is called from within critical sections and interrupts.
+ *
+ * portGET_UNPROCESSED_TICKS() returns the number of whole tick periods that
+ * have elapsed since the last tick passed to xTaskCatchUpTicksFromISR().  It is
+ * called from tasks, critical sections and interrupts. */
+    #ifndef portSET_NEXT_TICK_INTERRUPT
+        #error portSET_NEXT_TICK_INTERRUPT is required when configUSE_DYNAMIC_TICK is set to 1
+    #endif
+
+    #ifndef portGET_UNPROCESSED_TICKS
+        #error portGET_UNPROCESSED_TICKS is required when configUSE_DYNAMIC_TICK is set to 1
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TICKLESS_IDLE must be set to 0 when configUSE_DYNAMIC_TICK is set to 1 as the tick is already suppressed whenever possible
+    #endif
+
+#endif /* configUSE_DYNAMIC_TICK */
+
+#ifndef configUSE_HIGH_RESOLUTION_TIMEOUTS
+    #define configUSE_HIGH_RESOLUTION_TIMEOUTS    0
+#endif
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+/* portGET_HIGH_RESOLUTION_TIME_NS() returns the value of a free running counter
+ * in nanoseconds as a uint64_t.  The counter must not wrap.
+ *
+ * portSET_HIGH_RESOLUTION_TIMER( ullDeadlineNs ) programs a one shot timer to
+ * interrupt when the counter reaches ullDeadlineNs, replacing any interrupt
+ * already programmed, or as soon as possible if ullDeadlineNs has already
+ * passed.  The interrupt must call xTaskCheckDeadlinesFromISR().  It is called
+ * from within critical sections and interrupts. */
+    #ifndef portGET_HIGH_RESOLUTION_TIME_NS
+        #error portGET_HIGH_RESOLUTION_TIME_NS is required when configUSE_HIGH_RESOLUTION_TIMEOUTS is set to 1
+    #endif
+
+    #ifndef portSET_HIGH_RESOLUTION_TIMER
+        #error portSET_HIGH_RESOLUTION_TIMER is required when configUSE_HIGH_RESOLUTION_TIMEOUTS is set to 1
+    #endif
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMEOUTS */
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
     #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -2719,6 +3370,30 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_QUEUE_SET_READY_LIST
+    #define configUSE_QUEUE_SET_READY_LIST    0
+#endif
+
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_QUEUE_BATCH_OPERATIONS
+    #define configUSE_QUEUE_BATCH_OPERATIONS    0
+#endif
+
+#ifndef configUSE_MPMC_QUEUES
+    #define configUSE_MPMC_QUEUES    0
+#endif
+
+#if ( ( configUSE_MPMC_QUEUES == 1 ) && !defined( portMEMORY_FENCE ) )
+    #error configUSE_MPMC_QUEUES requires portMEMORY_FENCE() to be defined as a full hardware memory fence when configNUMBER_OF_CORES is greater than 1.
+#endif
+
+#ifndef configUSE_PRIORITY_EVENT_LISTS
+    #define configUSE_PRIORITY_EVENT_LISTS    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -2735,6 +3410,38 @@
     #define configUSE_TIME_SLICING    1
 #endif
 
+#ifndef configUSE_DELAYED_TASK_HEAP
+    #define configUSE_DELAYED_TASK_HEAP    0
+#endif
+
+#ifndef configUSE_BATCHED_TICK_WAKE_UP
+    #define configUSE_BATCHED_TICK_WAKE_UP    0
+#endif
+
+#if ( ( configUSE_BATCHED_TICK_WAKE_UP == 1 ) && ( configUSE_DELAYED_TASK_HEAP == 1 ) )
+
+/* Batching relies on the tasks to unblock being at the head of a sorted
+ * delayed task list. */
+    #error configUSE_BATCHED_TICK_WAKE_UP cannot be used with configUSE_DELAYED_TASK_HEAP
+#endif
+
+#ifndef configUSE_DEFERRED_TICK_PROCESSING
+    #define configUSE_DEFERRED_TICK_PROCESSING    0
+#endif
+
+#if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+
+/* Deferred ticks are processed by the context switch the tick interrupt
+ * requests, so the tick interrupt must be allowed to request one. */
+    #if ( configUSE_PREEMPTION == 0 )
+        #error configUSE_PREEMPTION must be set to 1 when configUSE_DEFERRED_TICK_PROCESSING is set to 1
+    #endif
+
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+        #error configUSE_DEFERRED_TICK_PROCESSING cannot be used with configUSE_DYNAMIC_TICK
+    #endif
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
     #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
 #endif
@@ -2767,6 +3474,10 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+#ifndef configUSE_READY_PRIORITY_BITMAP
+    #define configUSE_READY_PRIORITY_BITMAP    0
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -2861,6 +3572,18 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
+#if ( ( configUSE_MUTEX_FAST_PATH == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use configUSE_MUTEX_FAST_PATH
+#endif
+
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use reader-writer locks
+#endif
+
 #if ( ( configRUN_MULTIPLE_PRIORITIES == 0 ) && ( configUSE_TASK_PREEMPTION_DISABLE != 0 ) )
     #error configRUN_MULTIPLE_PRIORITIES must be set to 1 to use task preemption disable
 #endif
@@ -2877,10 +3600,54 @@
     #error configUSE_CORE_AFFINITY is not supported in single core FreeRTOS
 #endif
 
+#if ( ( configNUMBER_OF_CORES == 1 ) && ( configUSE_PER_CORE_READY_LISTS != 0 ) )
+    #error configUSE_PER_CORE_READY_LISTS is not supported in single core FreeRTOS
+#endif
+
+#if ( ( configNUMBER_OF_CORES == 1 ) && ( configUSE_GRANULAR_LOCKS != 0 ) )
+    #error configUSE_GRANULAR_LOCKS is not supported in single core FreeRTOS
+#endif
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_EDF_SCHEDULING != 0 ) )
+    #error configUSE_EDF_SCHEDULING is not supported in SMP FreeRTOS
+#endif
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_DYNAMIC_TICK != 0 ) )
+    #error configUSE_DYNAMIC_TICK is not supported in SMP FreeRTOS
+#endif
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_DEFERRED_TICK_PROCESSING != 0 ) )
+    #error configUSE_DEFERRED_TICK_PROCESSING is not supported in SMP FreeRTOS
+#endif
+
 #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) )
     #error configUSE_PORT_OPTIMISED_TASK_SELECTION is not supported in SMP FreeRTOS
 #endif
 
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_READY_PRIORITY_BITMAP != 0 ) )
+    #error configUSE_READY_PRIORITY_BITMAP is not supported in SMP FreeRTOS
+#endif
+
+#if ( ( configUSE_READY_PRIORITY_BITMAP != 0 ) && ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) )
+    #error configUSE_READY_PRIORITY_BITMAP cannot be used with configUSE_PORT_OPTIMISED_TASK_SELECTION
+#endif
+
+#if ( ( configUSE_READY_PRIORITY_BITMAP != 0 ) && ( configMAX_PRIORITIES > 1024 ) )
+    #error configMAX_PRIORITIES must not exceed 1024 when configUSE_READY_PRIORITY_BITMAP is 1
+#endif
+
+#if ( ( configUSE_QUEUE_SET_READY_LIST != 0 ) && ( configUSE_QUEUE_SETS == 0 ) )
+    #error configUSE_QUEUE_SETS must be set to 1 when configUSE_QUEUE_SET_READY_LIST is 1
+#endif
+
+#if ( ( configUSE_PRIORITY_EVENT_LISTS != 0 ) && ( configMAX_PRIORITIES > 1023 ) )
+    #error configMAX_PRIORITIES must not exceed 1023 when configUSE_PRIORITY_EVENT_LISTS is 1
+#endif
+
+#if ( ( configUSE_PRIORITY_EVENT_LISTS != 0 ) && ( configUSE_GRANULAR_LOCKS != 0 ) )
+    #error configUSE_PRIORITY_EVENT_LISTS cannot be used with configUSE_GRANULAR_LOCKS
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
     #define configINITIAL_TICK_COUNT    0
 #endif
@@ -3118,11 +3885,26 @@ typedef struct xSTATIC_LIST
     UBaseType_t uxDummy2;
     void * pvDummy3;
     StaticMiniListItem_t xDummy4;
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        void * pvDummy6;
+    #endif
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy5;
     #endif
 } StaticList_t;
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+/*
+ * See the comments above the struct xSTATIC_LIST_ITEM definition.
+ */
+    typedef struct xSTATIC_LIST_PRIORITY_INDEX
+    {
+        uint32_t ulDummy1[ 1 + ( ( configMAX_PRIORITIES + 32 ) / 32 ) ];
+        void * pvDummy2[ configMAX_PRIORITIES + 1 ];
+    } StaticListPriorityIndex_t;
+#endif
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3146,11 +3928,17 @@ typedef struct xSTATIC_TCB
         UBaseType_t uxDummy26;
     #endif
     StaticListItem_t xDummy3[ 2 ];
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        void * pvDummy27[ 3 ];
+    #endif
     UBaseType_t uxDummy5;
     void * pxDummy6;
     #if ( configNUMBER_OF_CORES > 1 )
         BaseType_t xDummy23;
         UBaseType_t uxDummy24;
+        #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+            BaseType_t xDummy28;
+        #endif
     #endif
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
     #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
@@ -3168,6 +3956,9 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_MUTEXES == 1 )
         UBaseType_t uxDummy12[ 2 ];
     #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDummy29[ 3 ];
+    #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void * pxDummy14;
     #endif
@@ -3177,6 +3968,14 @@ typedef struct xSTATIC_TCB
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
     #endif
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy30[ 2 ];
+        TickType_t xDummy31[ 2 ];
+    #endif
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+        StaticListItem_t xDummy32;
+        uint64_t ullDummy33;
+    #endif
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         configTLS_BLOCK_TYPE xDummy17;
     #endif
@@ -3232,13 +4031,66 @@ typedef struct xSTATIC_QUEUE
         void * pvDummy7;
     #endif
 
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+        void * pvDummy17;
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxDummy16;
+    #endif
+
+    #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+        void * pvDummy13;
+        UBaseType_t uxDummy14;
+        void * pvDummy15[ 2 ];
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummy10;
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy11;
+    #endif
+
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        StaticListPriorityIndex_t xDummy12[ 2 ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the MPMC queue structure used
+ * internally by FreeRTOS is not accessible to application code.  However, if
+ * the application writer wants to statically allocate the memory required to
+ * create an MPMC queue then the size of the queue object needs to be known.
+ * The StaticMpmcQueue_t structure below is provided for this purpose.  Its
+ * sizes and alignment requirements are guaranteed to match those of the
+ * genuine structure, no matter which architecture is being used, and no matter
+ * how the values in FreeRTOSConfig.h are set.  Its contents are somewhat
+ * obfuscated in the hope users will recognise that it would be unwise to make
+ * direct use of the structure members.
+ */
+typedef struct xSTATIC_MPMC_QUEUE
+{
+    uint32_t ulDummy1[ 2 ];
+    void * pvDummy2[ 2 ];
+    UBaseType_t uxDummy3[ 2 ];
+    StaticList_t xDummy4[ 2 ];
+    UBaseType_t uxDummy5[ 2 ];
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy6;
+    #endif
+} StaticMpmcQueue_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3258,6 +4110,10 @@ typedef struct xSTATIC_EVENT_GROUP
     TickType_t xDummy1;
     StaticList_t xDummy2;
 
+    #if ( configUSE_INDEXED_EVENT_GROUP_WAITERS == 1 )
+        StaticList_t xDummy6[ ( sizeof( TickType_t ) * ( size_t ) 8 ) - ( size_t ) 8 ];
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
     #endif
@@ -3265,6 +4121,10 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummy5;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -3320,10 +4180,26 @@ typedef struct xSTATIC_STREAM_BUFFER
         void * pvDummy5[ 2 ];
     #endif
     UBaseType_t uxDummy6;
+    #if ( ( configUSE_MPMC_STREAM_BUFFERS == 1 ) || ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 ) )
+        StaticList_t xDummy8;
+    #endif
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+        StaticList_t xDummy9;
+        size_t uxDummy10[ 2 ];
+        void * pvDummy11[ 4 ];
+        size_t uxDummy12[ 2 ];
+    #endif
+    #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+        size_t uxDummy13[ 4 ];
+    #endif
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummy7;
+    #endif
 } StaticStreamBuffer_t;
 
-/* Message buffers are built on stream buffers. */
+/* Message buffers and SPSC queues are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
+typedef StaticStreamBuffer_t StaticSpscQueue_t;
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
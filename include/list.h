@@ -166,6 +166,28 @@ typedef struct xLIST_ITEM ListItem_t;
     typedef struct xLIST_ITEM      MiniListItem_t;
 #endif
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+/* The number of item values a priority index can hold.  Event list items have
+ * values between 0 and configMAX_PRIORITIES inclusive. */
+    #define listPRIORITY_INDEX_VALUES    ( configMAX_PRIORITIES + 1 )
+    #define listPRIORITY_INDEX_WORDS     ( ( listPRIORITY_INDEX_VALUES + 31 ) / 32 )
+
+/*
+ * An index that can be attached to a list to make vListInsert() constant time.
+ * pxLastItem[ n ] points to the last item in the list that has an item value of
+ * n.  Bit ( n & 31 ) of ulValues[ n >> 5 ] is set if the list contains an item
+ * with a value of n, and bit m of ulGroups is set if any bit of ulValues[ m ] is
+ * set.
+ */
+    typedef struct xLIST_PRIORITY_INDEX
+    {
+        uint32_t ulGroups;
+        uint32_t ulValues[ listPRIORITY_INDEX_WORDS ];
+        struct xLIST_ITEM * pxLastItem[ listPRIORITY_INDEX_VALUES ];
+    } ListPriorityIndex_t;
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+
 /*
  * Definition of the type of queue used by the scheduler.
  */
@@ -175,6 +197,9 @@ typedef struct xLIST
     configLIST_VOLATILE UBaseType_t uxNumberOfItems;
     ListItem_t * configLIST_VOLATILE pxIndex; /**< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
     MiniListItem_t xListEnd;                  /**< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        ListPriorityIndex_t * pxPriorityIndex; /**< Points to the index used to insert items in constant time, or NULL if the list does not have one. */
+    #endif
     listSECOND_LIST_INTEGRITY_CHECK_VALUE     /**< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
@@ -303,6 +328,39 @@ typedef struct xLIST
  */
 #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 
+/*
+ * Update the priority index of a list, if it has one, to account for an item
+ * that is about to be removed from the list.  Used by listREMOVE_ITEM() and
+ * uxListRemove().
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    #define listPRIORITY_INDEX_REMOVE( pxList, pxItemToRemove )             \
+    do {                                                                    \
+        if( ( pxList )->pxPriorityIndex != NULL )                           \
+        {                                                                   \
+            vListPriorityIndexRemove( ( pxList ), ( pxItemToRemove ) );     \
+        }                                                                   \
+    } while( 0 )
+#else
+    #define listPRIORITY_INDEX_REMOVE( pxList, pxItemToRemove )
+#endif
+
+/*
+ * Obtain the bit number of the most significant set bit in a non-zero 32-bit
+ * value.  Used by the list priority index and by the scheduler's ready priority
+ * bitmap.  Use the compiler's count leading zeros builtin where there is one,
+ * otherwise fall back to the constant time binary search in
+ * uxListGetMSBPosition().
+ */
+#if ( defined( __GNUC__ ) && defined( __SIZEOF_INT__ ) && ( __SIZEOF_INT__ == 4 ) )
+    #define listGET_MSB_POSITION( ulBits )    ( ( UBaseType_t ) ( 31U - ( unsigned int ) __builtin_clz( ( unsigned int ) ( ulBits ) ) ) )
+#elif ( defined( __GNUC__ ) && defined( __SIZEOF_LONG__ ) && ( __SIZEOF_LONG__ == 4 ) )
+    #define listGET_MSB_POSITION( ulBits )    ( ( UBaseType_t ) ( 31U - ( unsigned int ) __builtin_clzl( ( unsigned long ) ( ulBits ) ) ) )
+#else
+    #define listUSE_GENERIC_MSB_POSITION
+    #define listGET_MSB_POSITION( ulBits )    uxListGetMSBPosition( ulBits )
+#endif
+
 /*
  * Version of uxListRemove() that does not return a value.  Provided as a slight
  * optimisation for xTaskIncrementTick() by being inline.
@@ -325,6 +383,7 @@ typedef struct xLIST
          * item. */                                                                                 \
         List_t * const pxList = ( pxItemToRemove )->pxContainer;                                    \
                                                                                                     \
+        listPRIORITY_INDEX_REMOVE( pxList, ( pxItemToRemove ) );                                    \
         ( pxItemToRemove )->pxNext->pxPrevious = ( pxItemToRemove )->pxPrevious;                    \
         ( pxItemToRemove )->pxPrevious->pxNext = ( pxItemToRemove )->pxNext;                        \
         /* Make sure the index is left pointing to a valid item. */                                 \
@@ -337,6 +396,33 @@ typedef struct xLIST
         ( ( pxList )->uxNumberOfItems ) = ( UBaseType_t ) ( ( ( pxList )->uxNumberOfItems ) - 1U ); \
     } while( 0 )
 
+/*
+ * Remove every item from the head of a list up to, but not including,
+ * pxFirstRemaining in a single operation.  Provided as an optimisation for
+ * xTaskIncrementTick() when many tasks are unblocked by the same tick.
+ *
+ * The removed items remain linked to each other in list order and their
+ * pxContainer members are not updated, so each removed item must be inserted
+ * into another list before it is next used.  pxIndex must not reference a
+ * removed item.
+ *
+ * @param pxList The list to remove the items from.
+ *
+ * @param pxFirstRemaining The first item that is to remain in the list, or the
+ * list end marker if all the items are to be removed.
+ *
+ * @param uxNumberToRemove The number of items being removed.
+ *
+ * \page listREMOVE_HEAD_ITEMS listREMOVE_HEAD_ITEMS
+ * \ingroup LinkedList
+ */
+#define listREMOVE_HEAD_ITEMS( pxList, pxFirstRemaining, uxNumberToRemove )                                 \
+    do {                                                                                                     \
+        ( pxList )->xListEnd.pxNext = ( pxFirstRemaining );                                                  \
+        ( pxFirstRemaining )->pxPrevious = ( ListItem_t * ) &( ( pxList )->xListEnd );                       \
+        ( pxList )->uxNumberOfItems = ( UBaseType_t ) ( ( pxList )->uxNumberOfItems - ( uxNumberToRemove ) ); \
+    } while( 0 )
+
 /*
  * Inline version of vListInsertEnd() to provide slight optimisation for
  * xTaskIncrementTick().
@@ -502,6 +588,48 @@ void vListInsertEnd( List_t * const pxList,
  */
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
 
+/*
+ * Attach a priority index to a list that has just been initialised by
+ * vListInitialise().  vListInsert() then inserts items into the list in
+ * constant time, rather than in a time proportional to the number of items in
+ * the list, while keeping the same ascending item value order with items of
+ * equal value in the order they were inserted.  Only lists whose items all have
+ * values between 0 and configMAX_PRIORITIES, such as the event lists used by
+ * queues and semaphores, can have a priority index.  Items must not be added to
+ * the list using vListInsertEnd(), and the value of an item must not be
+ * changed while it is in the list.
+ *
+ * configUSE_PRIORITY_EVENT_LISTS must be set to 1 for this function to be
+ * available.
+ *
+ * @param pxList The list to which the index is attached.
+ *
+ * @param pxPriorityIndex The index.  It must remain valid for as long as the
+ * list is in use.
+ *
+ * \page vListInitialisePriorityIndex vListInitialisePriorityIndex
+ * \ingroup LinkedList
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    void vListInitialisePriorityIndex( List_t * const pxList,
+                                       ListPriorityIndex_t * const pxPriorityIndex ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Use listREMOVE_ITEM() or uxListRemove() instead.
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    void vListPriorityIndexRemove( List_t * const pxList,
+                                   const ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  Use listGET_MSB_POSITION() instead.
+ */
+#if ( ( ( configUSE_PRIORITY_EVENT_LISTS == 1 ) || ( configUSE_READY_PRIORITY_BITMAP == 1 ) ) && defined( listUSE_GENERIC_MSB_POSITION ) )
+    UBaseType_t uxListGetMSBPosition( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
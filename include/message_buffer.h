@@ -48,7 +48,9 @@
  * block time to 0.  Likewise, if there are to be multiple different readers
  * then the application writer must place each call to a reading API function
  * (such as xMessageBufferRead()) inside a critical section and set the receive
- * timeout to 0.
+ * timeout to 0.  Alternatively, when configUSE_MPMC_STREAM_BUFFERS is set to 1,
+ * a message buffer created using xMessageBufferCreateMPMC() can be written and
+ * read by any number of tasks.
  *
  * Message buffers hold variable length messages.  To enable that, when a
  * message is written to the message buffer an additional sizeof( size_t ) bytes
@@ -85,6 +87,12 @@
  */
 typedef StreamBufferHandle_t MessageBufferHandle_t;
 
+/**
+ * Type used by each reader of a broadcast message buffer to hold its position
+ * within the buffer.  See vMessageBufferSubscribe().
+ */
+typedef StreamBufferSubscriber_t MessageBufferSubscriber_t;
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -250,6 +258,86 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
     xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_MESSAGE_BUFFER, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * MessageBufferHandle_t xMessageBufferCreateMPMC( size_t xBufferSizeBytes );
+ * MessageBufferHandle_t xMessageBufferCreateMPMCStatic( size_t xBufferSizeBytes,
+ *                                                       uint8_t *pucMessageBufferStorageArea,
+ *                                                       StaticMessageBuffer_t *pxStaticMessageBuffer );
+ * @endcode
+ *
+ * Creates a message buffer that, unlike a message buffer created with
+ * xMessageBufferCreate(), can be written to by more than one task and read
+ * from by more than one task at the same time.  Each message is received by
+ * exactly one reader.  The parameters have the same meaning as the parameters
+ * of xMessageBufferCreate() and xMessageBufferCreateStatic().
+ *
+ * Writers and readers only serialise for the time taken to reserve space for,
+ * or claim, a message - the message itself is copied outside of any critical
+ * section.  Messages become visible to readers in the order in which their
+ * space was reserved.  Such message buffers can only be accessed from tasks,
+ * not from interrupts.
+ *
+ * configUSE_MPMC_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferCreateMPMC() and xMessageBufferCreateMPMCStatic() to be
+ * available.
+ *
+ * \defgroup xMessageBufferCreateMPMC xMessageBufferCreateMPMC
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    #define xMessageBufferCreateMPMC( xBufferSizeBytes ) \
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, sbTYPE_MPMC_MESSAGE_BUFFER, NULL, NULL )
+
+    #define xMessageBufferCreateMPMCStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_MPMC_MESSAGE_BUFFER, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), NULL, NULL )
+#endif
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * MessageBufferHandle_t xMessageBufferCreateBroadcast( size_t xBufferSizeBytes );
+ * MessageBufferHandle_t xMessageBufferCreateBroadcastStatic( size_t xBufferSizeBytes,
+ *                                                            uint8_t *pucMessageBufferStorageArea,
+ *                                                            StaticMessageBuffer_t *pxStaticMessageBuffer );
+ * @endcode
+ *
+ * Creates a broadcast message buffer.  A broadcast message buffer has a single
+ * writer and any number of readers, called subscribers, and every subscriber
+ * receives every message.  Each message is stored once, no matter how many
+ * subscribers there are, and each subscriber keeps its own position within the
+ * buffer in a MessageBufferSubscriber_t variable.
+ *
+ * The writer never waits for subscribers.  Messages are written using
+ * xMessageBufferPublish() or xMessageBufferPublishFromISR(), which discard the
+ * oldest messages if there is not enough space for the new message.  A
+ * subscriber that falls so far behind that messages it had not yet read are
+ * discarded is told how many messages it missed the next time it calls
+ * xMessageBufferReceiveSubscribed().
+ *
+ * Broadcast message buffers cannot be used with xMessageBufferSend(),
+ * xMessageBufferReceive() or their variants.  The parameters have the same
+ * meaning as the parameters of xMessageBufferCreate() and
+ * xMessageBufferCreateStatic().
+ *
+ * configUSE_BROADCAST_MESSAGE_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferCreateBroadcast() and xMessageBufferCreateBroadcastStatic() to
+ * be available.
+ *
+ * \defgroup xMessageBufferCreateBroadcast xMessageBufferCreateBroadcast
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+    #define xMessageBufferCreateBroadcast( xBufferSizeBytes ) \
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, sbTYPE_BROADCAST_MESSAGE_BUFFER, NULL, NULL )
+
+    #define xMessageBufferCreateBroadcastStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_BROADCAST_MESSAGE_BUFFER, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), NULL, NULL )
+#endif
+
 /**
  * message_buffer.h
  *
@@ -495,6 +583,57 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
     xStreamBufferSendFromISR( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendV( MessageBufferHandle_t xMessageBuffer,
+ *                             const StreamBufferConstVector_t * pxVectors,
+ *                             UBaseType_t uxVectorCount,
+ *                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends one discrete message, gathered from several buffers, to a message
+ * buffer.  The message length is the total length of the vectors, and the
+ * message is written with a single length and a single notification exactly
+ * as if the concatenated data had been passed to xMessageBufferSend().
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xMessageBufferSendV() to be available.
+ *
+ * See xStreamBufferSendV() for a description of the parameters.
+ *
+ * @return The number of bytes written to the message buffer.  If the call
+ * times out before the whole message could be written then 0 is returned.
+ *
+ * Example use:
+ * @code{c}
+ * void vSendFrame( MessageBufferHandle_t xMessageBuffer,
+ *                  const FrameHeader_t * pxHeader,
+ *                  const uint8_t * pucPayload,
+ *                  size_t xPayloadLength,
+ *                  const uint32_t * pulCRC )
+ * {
+ * StreamBufferConstVector_t xVectors[ 3 ];
+ *
+ *  xVectors[ 0 ].pvData = pxHeader;
+ *  xVectors[ 0 ].xLength = sizeof( FrameHeader_t );
+ *  xVectors[ 1 ].pvData = pucPayload;
+ *  xVectors[ 1 ].xLength = xPayloadLength;
+ *  xVectors[ 2 ].pvData = pulCRC;
+ *  xVectors[ 2 ].xLength = sizeof( uint32_t );
+ *
+ *  // Send header, payload and CRC as one message without first copying
+ *  // them into a staging buffer.
+ *  ( void ) xMessageBufferSendV( xMessageBuffer, xVectors, 3, portMAX_DELAY );
+ * }
+ * @endcode
+ * \defgroup xMessageBufferSendV xMessageBufferSendV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendV( xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait ) \
+    xStreamBufferSendV( ( xMessageBuffer ), ( pxVectors ), ( uxVectorCount ), ( xTicksToWait ) )
+
 /**
  * message_buffer.h
  *
@@ -692,6 +831,172 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveV( MessageBufferHandle_t xMessageBuffer,
+ *                                const StreamBufferVector_t * pxVectors,
+ *                                UBaseType_t uxVectorCount,
+ *                                TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the next discrete message from a message buffer, scattering it
+ * across several buffers.  The buffers are filled in order.  If the total
+ * length of the vectors is too small to hold the next message then the message
+ * is left in the message buffer and 0 is returned.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xMessageBufferReceiveV() to be available.
+ *
+ * See xStreamBufferReceiveV() for a description of the parameters.
+ *
+ * @return The length, in bytes, of the message read from the message buffer,
+ * if any.
+ *
+ * \defgroup xMessageBufferReceiveV xMessageBufferReceiveV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveV( xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait ) \
+    xStreamBufferReceiveV( ( xMessageBuffer ), ( pxVectors ), ( uxVectorCount ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferPublish( MessageBufferHandle_t xMessageBuffer,
+ *                               const void *pvTxData,
+ *                               size_t xDataLengthBytes );
+ * size_t xMessageBufferPublishFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                      const void *pvTxData,
+ *                                      size_t xDataLengthBytes,
+ *                                      BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Writes a message to a broadcast message buffer created using
+ * xMessageBufferCreateBroadcast(), making it available to every subscriber.
+ * Never blocks - if there is not enough free space for the message then the
+ * oldest messages are discarded to make space, whether or not every
+ * subscriber has read them.  Every subscriber that is blocked waiting for a
+ * message is unblocked.
+ *
+ * A broadcast message buffer must only have one writer.
+ *
+ * configUSE_BROADCAST_MESSAGE_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferPublish() and xMessageBufferPublishFromISR() to be available.
+ *
+ * @param xMessageBuffer The handle of the broadcast message buffer.
+ *
+ * @param pvTxData A pointer to the message to copy into the buffer.
+ *
+ * @param xDataLengthBytes The length of the message.  The message must fit in
+ * the buffer, along with the sbBYTES_TO_STORE_MESSAGE_LENGTH bytes used to
+ * store its length, when the buffer is otherwise empty.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE by
+ * xMessageBufferPublishFromISR() if a subscriber of higher priority than the
+ * interrupted task was unblocked.
+ *
+ * @return xDataLengthBytes if the message was written, or 0 if it is too long
+ * to ever fit in the buffer.
+ *
+ * \defgroup xMessageBufferPublish xMessageBufferPublish
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+    #define xMessageBufferPublish( xMessageBuffer, pvTxData, xDataLengthBytes ) \
+    xStreamBufferPublish( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ) )
+
+    #define xMessageBufferPublishFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferPublishFromISR( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * void vMessageBufferSubscribe( MessageBufferHandle_t xMessageBuffer,
+ *                               MessageBufferSubscriber_t *pxSubscriber );
+ * @endcode
+ *
+ * Subscribes a reader to a broadcast message buffer by initialising the
+ * MessageBufferSubscriber_t variable in which the reader's position is held.
+ * The subscriber receives the messages published after the call.  There is no
+ * need to unsubscribe - a subscriber that stops reading does not hold up the
+ * writer or use any memory within the buffer.
+ *
+ * configUSE_BROADCAST_MESSAGE_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * vMessageBufferSubscribe() to be available.
+ *
+ * @param xMessageBuffer The handle of the broadcast message buffer.
+ *
+ * @param pxSubscriber The variable, which must remain in scope for as long as
+ * it is used, that holds the subscriber's position.
+ *
+ * \defgroup vMessageBufferSubscribe vMessageBufferSubscribe
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+    #define vMessageBufferSubscribe( xMessageBuffer, pxSubscriber ) \
+    vStreamBufferSubscribe( ( xMessageBuffer ), ( pxSubscriber ) )
+#endif
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveSubscribed( MessageBufferHandle_t xMessageBuffer,
+ *                                         MessageBufferSubscriber_t *pxSubscriber,
+ *                                         void *pvRxData,
+ *                                         size_t xBufferLengthBytes,
+ *                                         size_t *pxMessagesLost,
+ *                                         TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the next message that the subscriber has not yet read from a
+ * broadcast message buffer.  Reading a message does not remove it from the
+ * buffer, so it remains available to the other subscribers.
+ *
+ * The message is copied without preventing the writer from running.  If the
+ * writer discards the message while it is being copied then the copy is
+ * abandoned and the oldest message still in the buffer is received instead.
+ *
+ * Must only be called from a task, and each MessageBufferSubscriber_t must only
+ * be used by one task.
+ *
+ * configUSE_BROADCAST_MESSAGE_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferReceiveSubscribed() to be available.
+ *
+ * @param xMessageBuffer The handle of the broadcast message buffer.
+ *
+ * @param pxSubscriber The subscriber's position, as initialised by
+ * vMessageBufferSubscribe().
+ *
+ * @param pvRxData A pointer to the buffer into which the message is copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ * If the next message is longer than this then it is left unread and 0 is
+ * returned.
+ *
+ * @param pxMessagesLost If not NULL, used to return the number of messages the
+ * subscriber missed because they were discarded before it read them.  Non-zero
+ * indicates the subscriber overran.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for a message if the subscriber has already read every
+ * message in the buffer.
+ *
+ * @return The length, in bytes, of the message received, or 0 if no message
+ * was received.
+ *
+ * \defgroup xMessageBufferReceiveSubscribed xMessageBufferReceiveSubscribed
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+    #define xMessageBufferReceiveSubscribed( xMessageBuffer, pxSubscriber, pvRxData, xBufferLengthBytes, pxMessagesLost, xTicksToWait ) \
+    xStreamBufferReceiveSubscribed( ( xMessageBuffer ), ( pxSubscriber ), ( pvRxData ), ( xBufferLengthBytes ), ( pxMessagesLost ), ( xTicksToWait ) )
+#endif
+
 /**
  * message_buffer.h
  *
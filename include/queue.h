@@ -64,7 +64,19 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
-/* For internal use only. */
+/**
+ * Type by which lock-free multi-producer multi-consumer queues are referenced.
+ * For example, a call to xMpmcQueueCreate() returns an MpmcQueueHandle_t
+ * variable that can then be used as a parameter to xMpmcQueueSend(),
+ * xMpmcQueueReceive(), etc.
+ */
+struct MpmcQueueDefinition;
+typedef struct MpmcQueueDefinition * MpmcQueueHandle_t;
+
+/* For internal use only.  With configUSE_QUEUE_ZERO_COPY set to 1 a send using
+ * queueOVERWRITE fails as though the queue were full while the queue holds a
+ * slot reserved by xQueueReserve() that has not been committed, as the reserved
+ * slot is the only one in the queue and is being written by another task. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
 #define queueOVERWRITE                        ( ( BaseType_t ) 2 )
@@ -76,6 +88,12 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE    ( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_RW_LOCK               ( ( uint8_t ) 5U )
+
+/* The number of bytes of storage an MPMC queue created by
+ * xMpmcQueueCreateStatic() requires - a sequence number for each slot as well
+ * as the slot itself. */
+#define queueMPMC_STORAGE_SIZE_BYTES( uxQueueLength, uxItemSize )    ( ( size_t ) ( uxQueueLength ) * ( sizeof( uint32_t ) + ( size_t ) ( uxItemSize ) ) )
 
 /**
  * queue. h
@@ -541,7 +559,11 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
  * @return xQueueOverwrite() is a macro that calls xQueueGenericSend(), and
  * therefore has the same return values as xQueueSendToFront().  However, pdPASS
  * is the only value that can be returned because xQueueOverwrite() will write
- * to the queue even when the queue is already full.
+ * to the queue even when the queue is already full.  The exception is when
+ * configUSE_QUEUE_ZERO_COPY is set to 1 and a slot in the queue has been
+ * reserved by xQueueReserve() but not yet committed, in which case the reserved
+ * slot is the only one in the queue, nothing is overwritten, and errQUEUE_FULL
+ * is returned.
  *
  * Example usage:
  * @code{c}
@@ -914,6 +936,462 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveUntilNs(
+ *                                  QueueHandle_t xQueue,
+ *                                  void *pvBuffer,
+ *                                  uint64_t ullDeadlineNs
+ *                               );
+ * @endcode
+ *
+ * configUSE_HIGH_RESOLUTION_TIMEOUTS must be set to 1 for this function to be
+ * available.
+ *
+ * The same as xQueueReceive(), but the time to wait for an item is given as an
+ * absolute deadline of the high resolution counter returned by
+ * ullTaskGetTimeNs() rather than as a number of ticks.  If the queue is empty
+ * the task leaves the Blocked state when the deadline passes, rather than at
+ * the next tick interrupt.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will
+ * be copied.
+ *
+ * @param ullDeadlineNs The time, in nanoseconds, after which the call will
+ * stop waiting for an item.  A deadline that has already passed can be used to
+ * poll the queue.
+ *
+ * @return pdTRUE if an item was successfully received from the queue,
+ * otherwise pdFALSE.
+ *
+ * \defgroup xQueueReceiveUntilNs xQueueReceiveUntilNs
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    BaseType_t xQueueReceiveUntilNs( QueueHandle_t xQueue,
+                                     void * const pvBuffer,
+                                     uint64_t ullDeadlineNs ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReserve(
+ *                           QueueHandle_t xQueue,
+ *                           void **ppvSlot,
+ *                           TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 for this function to be
+ * available.
+ *
+ * Reserve the storage for the next item to be posted to the back of a queue so
+ * the item can be written into the queue's storage area in place, rather than
+ * being copied into the queue by xQueueSend().  The item is not available to
+ * tasks reading from the queue until xQueueCommit() is called.
+ *
+ * Only one item can be reserved in a queue at a time.  Until the reserved item
+ * is committed no other item can be posted to the queue, and tasks attempting
+ * to do so wait as though the queue were full.  xQueueOverwrite() must not be
+ * used on a queue that is written using xQueueReserve().
+ *
+ * This function must not be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue in which the item is to be reserved.
+ *
+ * @param ppvSlot Set to point to the uxItemSize bytes into which the item is
+ * to be written.  Only set if pdPASS is returned.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full.  The
+ * call will return immediately if this is set to 0.
+ *
+ * @return pdPASS if the item was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AMessage
+ * {
+ *  char ucMessageID;
+ *  char ucData[ 256 ];
+ * };
+ *
+ * void vATask( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue;
+ * struct AMessage *pxMessage;
+ *
+ *  // Create a queue capable of containing 10 AMessage structures.
+ *  xQueue = xQueueCreate( 10, sizeof( struct AMessage ) );
+ *
+ *  // ...
+ *
+ *  // Build the next message directly in the queue, waiting up to 10 ticks
+ *  // for space to become available.
+ *  if( xQueueReserve( xQueue, ( void ** ) &pxMessage, ( TickType_t ) 10 ) == pdPASS )
+ *  {
+ *      pxMessage->ucMessageID = 1;
+ *      vFillData( pxMessage->ucData );
+ *
+ *      // Make the message available to the tasks reading from the queue.
+ *      xQueueCommit( xQueue );
+ *  }
+ *
+ *  // ... Rest of task code.
+ * }
+ * @endcode
+ * \defgroup xQueueReserve xQueueReserve
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** const ppvSlot,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommit( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 for this function to be
+ * available.
+ *
+ * Post the item reserved by xQueueReserve() to the back of the queue, making it
+ * available to tasks reading from the queue.  The item must not be accessed
+ * through the pointer returned by xQueueReserve() once it has been committed.
+ *
+ * This function must not be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue in which the item was reserved.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueCommit xQueueCommit
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueAcquire(
+ *                           QueueHandle_t xQueue,
+ *                           void **ppvItem,
+ *                           TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 for this function to be
+ * available.
+ *
+ * Obtain a pointer to the item at the front of a queue so the item can be read
+ * in place, rather than being copied out of the queue by xQueueReceive().  The
+ * item remains in the queue until xQueueRelease() is called.
+ *
+ * Only one item can be acquired from a queue at a time.  Until the acquired
+ * item is released no other item can be received or peeked from the queue,
+ * and tasks attempting to do so wait as though the queue were empty.
+ * xQueueSendToFront() and xQueueOverwrite() must not be used on a queue that is
+ * read using xQueueAcquire().
+ *
+ * This function must not be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * acquired.
+ *
+ * @param ppvItem Set to point to the uxItemSize bytes that hold the item.
+ * Only set if pdPASS is returned.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to acquire should the queue be empty at the time of the
+ * call.  The call will return immediately if this is set to 0.
+ *
+ * @return pdPASS if an item was acquired, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueueAcquire xQueueAcquire
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueAcquire( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueRelease( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 for this function to be
+ * available.
+ *
+ * Remove the item acquired by xQueueAcquire() from the queue, freeing its
+ * storage for the next item posted to the queue.  The item must not be
+ * accessed through the pointer returned by xQueueAcquire() once it has been
+ * released.
+ *
+ * This function must not be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the item was acquired.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueRelease xQueueRelease
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    BaseType_t xQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultiple(
+ *                                  QueueHandle_t xQueue,
+ *                                  const void *pvItemsToQueue,
+ *                                  UBaseType_t uxItemCount,
+ *                                  TickType_t xTicksToWait
+ *                                );
+ * @endcode
+ *
+ * configUSE_QUEUE_BATCH_OPERATIONS must be set to 1 for this function to be
+ * available.
+ *
+ * Post a number of items to the back of a queue.  As many items as there is
+ * space for are copied into the queue, and tasks waiting to receive from the
+ * queue are unblocked, within a single critical section.  If there was not
+ * space for all the items the calling task then blocks until more space
+ * becomes available, or until xTicksToWait expires.  Items posted by other
+ * tasks and interrupts can be interleaved with the items from pvItemsToQueue
+ * if the calling task has to block.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See uxQueueSendMultipleFromISR() for an alternative which may be used
+ * in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each the
+ * size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue.  The call will return
+ * as soon as the queue is full if this is set to 0.
+ *
+ * @return The number of items posted to the queue.  This is less than
+ * uxItemCount if xTicksToWait expired before all the items could be posted.
+ *
+ * Example usage:
+ * @code{c}
+ * #define BURST_LENGTH    32
+ *
+ * void vProducerTask( void *pvParameters )
+ * {
+ * uint16_t usSamples[ BURST_LENGTH ];
+ * UBaseType_t uxSent;
+ *
+ *  // Create a queue capable of containing 128 samples.
+ *  xQueue = xQueueCreate( 128, sizeof( uint16_t ) );
+ *
+ *  for( ;; )
+ *  {
+ *      vReadSamples( usSamples, BURST_LENGTH );
+ *
+ *      // Post the whole burst, waiting up to 10 ticks for space.
+ *      uxSent = uxQueueSendMultiple( xQueue, usSamples, BURST_LENGTH, ( TickType_t ) 10 );
+ *
+ *      if( uxSent != BURST_LENGTH )
+ *      {
+ *          // The last BURST_LENGTH - uxSent samples were not posted.
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                     const void * const pvItemsToQueue,
+                                     UBaseType_t uxItemCount,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultiple(
+ *                                     QueueHandle_t xQueue,
+ *                                     void *pvBuffer,
+ *                                     UBaseType_t uxMaxItems,
+ *                                     TickType_t xTicksToWait
+ *                                   );
+ * @endcode
+ *
+ * configUSE_QUEUE_BATCH_OPERATIONS must be set to 1 for this function to be
+ * available.
+ *
+ * Receive up to uxMaxItems items from the front of a queue.  All the items
+ * that are available, up to uxMaxItems, are copied out of the queue, and tasks
+ * waiting to post to the queue are unblocked, within a single critical
+ * section.  The calling task only blocks if the queue is empty, and returns as
+ * soon as at least one item is available.
+ *
+ * This function must not be called from an interrupt service routine.
+ * See uxQueueReceiveMultipleFromISR() for an alternative which may be used
+ * in an ISR.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.  The buffer must be large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.  The call will return immediately if this is set to 0.
+ *
+ * @return The number of items received, which is 0 if the queue remained
+ * empty until xTicksToWait expired.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                        void * const pvBuffer,
+                                        UBaseType_t uxMaxItems,
+                                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultipleFromISR(
+ *                                         QueueHandle_t xQueue,
+ *                                         const void *pvItemsToQueue,
+ *                                         UBaseType_t uxItemCount,
+ *                                         BaseType_t *pxHigherPriorityTaskWoken
+ *                                       );
+ * @endcode
+ *
+ * configUSE_QUEUE_BATCH_OPERATIONS must be set to 1 for this function to be
+ * available.
+ *
+ * A version of uxQueueSendMultiple() that can be used in an interrupt service
+ * routine.  As many of the items as there is space for are posted to the back
+ * of the queue.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to an array of uxItemCount items, each the
+ * size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param pxHigherPriorityTaskWoken uxQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if posting the items caused a task to
+ * unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If uxQueueSendMultipleFromISR() sets this value to pdTRUE then
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted to the queue.
+ *
+ * Example usage for buffered IO (where the ISR can obtain more than one value
+ * per call):
+ * @code{c}
+ * void vBufferISR( void )
+ * {
+ * char cIn[ 16 ];
+ * UBaseType_t uxCount;
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // Drain the hardware FIFO into a local buffer.
+ *  uxCount = 0;
+ *
+ *  while( ( portINPUT_BYTE( BUFFER_COUNT ) != 0 ) && ( uxCount < sizeof( cIn ) ) )
+ *  {
+ *      cIn[ uxCount++ ] = portINPUT_BYTE( RX_REGISTER_ADDRESS );
+ *  }
+ *
+ *  // Post all the bytes in one call.
+ *  ( void ) uxQueueSendMultipleFromISR( xRxQueue, cIn, uxCount, &xHigherPriorityTaskWoken );
+ *
+ *  // Now the buffer is empty we can switch context if necessary.
+ *  if( xHigherPriorityTaskWoken )
+ *  {
+ *      portYIELD_FROM_ISR ();
+ *  }
+ * }
+ * @endcode
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                            const void * const pvItemsToQueue,
+                                            UBaseType_t uxItemCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultipleFromISR(
+ *                                            QueueHandle_t xQueue,
+ *                                            void *pvBuffer,
+ *                                            UBaseType_t uxMaxItems,
+ *                                            BaseType_t *pxHigherPriorityTaskWoken
+ *                                          );
+ * @endcode
+ *
+ * configUSE_QUEUE_BATCH_OPERATIONS must be set to 1 for this function to be
+ * available.
+ *
+ * A version of uxQueueReceiveMultiple() that can be used in an interrupt
+ * service routine.  Receives up to uxMaxItems items from the front of the
+ * queue without blocking.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received items will be
+ * copied.  The buffer must be large enough to hold uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken A task may be blocked waiting for space to
+ * become available on the queue.  If uxQueueReceiveMultipleFromISR() causes
+ * such a task to unblock *pxHigherPriorityTaskWoken will get set to pdTRUE,
+ * otherwise *pxHigherPriorityTaskWoken will remain unchanged.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                               void * const pvBuffer,
+                                               UBaseType_t uxMaxItems,
+                                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -1145,7 +1623,9 @@ void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
  * xQueueGenericSendFromISR(), and therefore has the same return values as
  * xQueueSendToFrontFromISR().  However, pdPASS is the only value that can be
  * returned because xQueueOverwriteFromISR() will write to the queue even when
- * the queue is already full.
+ * the queue is already full.  As with xQueueOverwrite(), errQUEUE_FULL is
+ * returned if a slot in the queue has been reserved by xQueueReserve() but not
+ * yet committed.
  *
  * Example usage:
  * @code{c}
@@ -1502,6 +1982,17 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
                                            StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                                UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                      UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_COUNTING_SEMAPHORES == 1 )
     QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                                  const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
@@ -1516,6 +2007,30 @@ QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use uxSemaphoreGiveMultiple(),
+ * uxSemaphoreTakeMultiple() and their FromISR() versions instead of calling
+ * these functions directly.
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    UBaseType_t uxQueueSemaphoreGiveMultiple( QueueHandle_t xQueue,
+                                              UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxQueueSemaphoreTakeMultiple( QueueHandle_t xQueue,
+                                              UBaseType_t uxMaxCount,
+                                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxQueueSemaphoreGiveMultipleFromISR( QueueHandle_t xQueue,
+                                                     UBaseType_t uxCount,
+                                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxQueueSemaphoreTakeMultipleFromISR( QueueHandle_t xQueue,
+                                                     UBaseType_t uxMaxCount,
+                                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    BaseType_t xQueueSemaphoreTakeUntilNs( QueueHandle_t xQueue,
+                                           uint64_t ullDeadlineNs ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
     TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
@@ -1529,6 +2044,30 @@ BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use xSemaphoreCreateRwLock(), xSemaphoreTakeRead(),
+ * xSemaphoreTakeWrite(), xSemaphoreGiveRead(), xSemaphoreGiveWrite() and their
+ * variants instead of calling these functions directly.
+ */
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateRwLock( void ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateRwLockStatic( StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+    BaseType_t xQueueTakeRwLock( QueueHandle_t xRwLock,
+                                 const BaseType_t xWrite,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueGiveRwLock( QueueHandle_t xRwLock,
+                                 const BaseType_t xWrite ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueTakeRwLockFromISR( QueueHandle_t xRwLock ) PRIVILEGED_FUNCTION;
+    BaseType_t xQueueGiveRwLockFromISR( QueueHandle_t xRwLock,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Reset a queue back to its original empty state.  The return value is now
  * obsolete and is always set to pdPASS.
@@ -1654,12 +2193,22 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  *
  * Note 3:  An additional 4 bytes of RAM is required for each space in a every
  * queue added to a queue set.  Therefore counting semaphores that have a high
- * maximum count value should not be added to a queue set.
+ * maximum count value should not be added to a queue set.  This does not apply
+ * if configUSE_QUEUE_SET_READY_LIST is set to 1 - see Note 5.
  *
  * Note 4:  A receive (in the case of a queue) or take (in the case of a
  * semaphore) operation must not be performed on a member of a queue set unless
  * a call to xQueueSelectFromSet() has first returned a handle to that set member.
  *
+ * Note 5:  If configUSE_QUEUE_SET_READY_LIST is set to 1 then the queue set
+ * does not store a copy of the handle of a member each time the member receives
+ * data.  Instead the members that have data are linked into a list held by the
+ * set, and each member counts its own pending events, so posting and selecting
+ * events takes constant time, uxEventQueueLength is ignored, and there is no
+ * limit on the number of members or events.  A member that has more than one
+ * event pending is moved to the back of the list each time it is selected, so
+ * members are selected in turn.  xQueuePeek() must not be used on such a set.
+ *
  * @param uxEventQueueLength Queue sets store events that occur on
  * the queues and semaphores contained in the set.  uxEventQueueLength specifies
  * the maximum number of events that can be queued at once.  To be absolutely
@@ -1694,6 +2243,11 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * semaphore) operation must not be performed on a member of a queue set unless
  * a call to xQueueSelectFromSet() has first returned a handle to that set member.
  *
+ * Note 2:  If configUSE_GRANULAR_LOCKS is set to 1 then mutexes cannot be
+ * added to a queue set.  A mutex is protected by the kernel critical section
+ * rather than by its own spinlock, and notifying the set from the kernel
+ * critical section would take the locks in an order that can deadlock.
+ *
  * @param xQueueOrSemaphore The handle of the queue or semaphore being added to
  * the queue set (cast to an QueueSetMemberHandle_t type).
  *
@@ -1702,7 +2256,8 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  *
  * @return If the queue or semaphore was successfully added to the queue set
  * then pdPASS is returned.  If the queue could not be successfully added to the
- * queue set because it is already a member of a different queue set then pdFAIL
+ * queue set because it is already a member of a different queue set, or
+ * because it is a mutex and configUSE_GRANULAR_LOCKS is set to 1, then pdFAIL
  * is returned.
  */
 #if ( configUSE_QUEUE_SETS == 1 )
@@ -1725,7 +2280,9 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  *
  * @return If the queue or semaphore was successfully removed from the queue set
  * then pdPASS is returned.  If the queue was not in the queue set, or the
- * queue (or semaphore) was not empty, then pdFAIL is returned.
+ * queue (or semaphore) was not empty, then pdFAIL is returned.  If
+ * configUSE_QUEUE_SET_READY_LIST is set to 1 then any events the queue or
+ * semaphore posted to the set that were never selected are discarded.
  */
 #if ( configUSE_QUEUE_SETS == 1 )
     BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
@@ -1778,6 +2335,252 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
     QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * queue. h
+ * @code{c}
+ * MpmcQueueHandle_t xMpmcQueueCreate(
+ *                                     UBaseType_t uxQueueLength,
+ *                                     UBaseType_t uxItemSize
+ *                                   );
+ * @endcode
+ *
+ * configUSE_MPMC_QUEUES must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Creates a new lock-free multi-producer multi-consumer (MPMC) queue and
+ * returns a handle by which the queue can be referenced.  Any number of tasks
+ * can send to and receive from an MPMC queue.  Items are copied into and out
+ * of the queue by claiming slots with the compare-and-swap operations provided
+ * by atomic.h, so the scheduler is only involved when a task has to block
+ * because the queue is full or empty, or when a task is blocked on the queue.
+ *
+ * MPMC queues can only be used from tasks, not from interrupts, and cannot be
+ * added to a queue set.  Unlike a standard queue, a task that finds space or
+ * an item available takes it even if higher priority tasks are blocked on the
+ * queue.
+ *
+ * On multicore systems atomic.h must provide operations that are atomic across
+ * cores, and portMEMORY_FENCE() must be a full hardware memory fence.  GCC
+ * builds default portMEMORY_FENCE() to __sync_synchronize(); other compilers
+ * need the port to define it.
+ *
+ * Internally, within the FreeRTOS implementation, an MPMC queue uses a block of
+ * memory to hold the queue structure, followed by an array holding a sequence
+ * number for each slot, followed by the slots themselves.  If an MPMC queue is
+ * created using xMpmcQueueCreate() then the required memory is automatically
+ * dynamically allocated inside the xMpmcQueueCreate() function.  If an MPMC
+ * queue is created using xMpmcQueueCreateStatic() then the application writer
+ * must provide the memory that will get used by the queue.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ * Must be a power of two, and at least 2.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must be greater than zero.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then NULL is
+ * returned.
+ *
+ * \defgroup xMpmcQueueCreate xMpmcQueueCreate
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_MPMC_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    MpmcQueueHandle_t xMpmcQueueCreate( const UBaseType_t uxQueueLength,
+                                        const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * MpmcQueueHandle_t xMpmcQueueCreateStatic(
+ *                                           UBaseType_t uxQueueLength,
+ *                                           UBaseType_t uxItemSize,
+ *                                           uint8_t *pucQueueStorage,
+ *                                           StaticMpmcQueue_t *pxStaticQueue
+ *                                         );
+ * @endcode
+ *
+ * configUSE_MPMC_QUEUES must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Creates a new MPMC queue using statically allocated memory.  See
+ * xMpmcQueueCreate().
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ * Must be a power of two, and at least 2.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must be greater than zero.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array that is at least
+ * queueMPMC_STORAGE_SIZE_BYTES( uxQueueLength, uxItemSize ) bytes long, and
+ * that is aligned to hold uint32_t values.
+ *
+ * @param pxStaticQueue Must point to a variable of type StaticMpmcQueue_t,
+ * which will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created then a handle to the created queue is
+ * returned.  If either pucQueueStorage or pxStaticQueue are NULL, or the length
+ * or item size are invalid, then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * #define QUEUE_LENGTH 16
+ * #define ITEM_SIZE sizeof( uint32_t )
+ *
+ * // The variable used to hold the queue's data structure.
+ * static StaticMpmcQueue_t xQueueBuffer;
+ *
+ * // The array used as the queue's storage area.  It holds a sequence number
+ * // for each slot as well as the items themselves.
+ * static uint32_t ulQueueStorage[ queueMPMC_STORAGE_SIZE_BYTES( QUEUE_LENGTH, ITEM_SIZE ) / sizeof( uint32_t ) ];
+ *
+ * void vATask( void *pvParameters )
+ * {
+ *  MpmcQueueHandle_t xQueue;
+ *
+ *  xQueue = xMpmcQueueCreateStatic( QUEUE_LENGTH,
+ *                                   ITEM_SIZE,
+ *                                   ( uint8_t * ) ulQueueStorage,
+ *                                   &xQueueBuffer );
+ *
+ *  // pxQueueBuffer was not NULL so xQueue should not be NULL.
+ *  configASSERT( xQueue );
+ * }
+ * @endcode
+ * \defgroup xMpmcQueueCreateStatic xMpmcQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_MPMC_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    MpmcQueueHandle_t xMpmcQueueCreateStatic( const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              uint8_t * pucQueueStorage,
+                                              StaticMpmcQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xMpmcQueueSend(
+ *                            MpmcQueueHandle_t xQueue,
+ *                            const void *pvItemToQueue,
+ *                            TickType_t xTicksToWait
+ *                          );
+ * @endcode
+ *
+ * configUSE_MPMC_QUEUES must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Post an item to the back of an MPMC queue.  The item is queued by copy, not
+ * by reference.  This function must not be called from an interrupt service
+ * routine.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already be
+ * full.  The call will return immediately if this is set to 0.
+ *
+ * @return pdPASS if the item was successfully posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xMpmcQueueSend xMpmcQueueSend
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_MPMC_QUEUES == 1 )
+    BaseType_t xMpmcQueueSend( MpmcQueueHandle_t xQueue,
+                               const void * const pvItemToQueue,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xMpmcQueueReceive(
+ *                               MpmcQueueHandle_t xQueue,
+ *                               void *pvBuffer,
+ *                               TickType_t xTicksToWait
+ *                             );
+ * @endcode
+ *
+ * configUSE_MPMC_QUEUES must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Receive an item from the front of an MPMC queue.  The item is received by
+ * copy so a buffer of adequate size must be provided.  This function must not
+ * be called from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the item is to be
+ * received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will be
+ * copied.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of the
+ * call.  The call will return immediately if this is set to 0.
+ *
+ * @return pdPASS if an item was successfully received from the queue,
+ * otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xMpmcQueueReceive xMpmcQueueReceive
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_MPMC_QUEUES == 1 )
+    BaseType_t xMpmcQueueReceive( MpmcQueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxMpmcQueueMessagesWaiting( const MpmcQueueHandle_t xQueue );
+ * @endcode
+ *
+ * configUSE_MPMC_QUEUES must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Return the number of items stored in an MPMC queue.  Other tasks can send to
+ * and receive from the queue while the number is being calculated, so the
+ * value returned is only a snapshot.
+ *
+ * @param xQueue A handle to the queue being queried.
+ *
+ * @return The number of items available in the queue.
+ *
+ * \defgroup uxMpmcQueueMessagesWaiting uxMpmcQueueMessagesWaiting
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_MPMC_QUEUES == 1 )
+    UBaseType_t uxMpmcQueueMessagesWaiting( const MpmcQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void vMpmcQueueDelete( MpmcQueueHandle_t xQueue );
+ * @endcode
+ *
+ * configUSE_MPMC_QUEUES must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Delete an MPMC queue - freeing all the memory allocated for storing of items
+ * placed on the queue.  No task may be using, or blocked on, the queue when it
+ * is deleted.
+ *
+ * @param xQueue A handle to the queue to be deleted.
+ *
+ * \defgroup vMpmcQueueDelete vMpmcQueueDelete
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_MPMC_QUEUES == 1 )
+    void vMpmcQueueDelete( MpmcQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
                                      TickType_t xTicksToWait,
@@ -297,6 +297,40 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreTake( xSemaphore, xBlockTime )    xQueueSemaphoreTake( ( xSemaphore ), ( xBlockTime ) )
 
+/**
+ * semphr. h
+ * @code{c}
+ * xSemaphoreTakeUntilNs(
+ *                       SemaphoreHandle_t xSemaphore,
+ *                       uint64_t ullDeadlineNs
+ *                   );
+ * @endcode
+ *
+ * configUSE_HIGH_RESOLUTION_TIMEOUTS must be set to 1 for this macro to be
+ * available.
+ *
+ * <i>Macro</i> to obtain a semaphore.  The same as xSemaphoreTake(), but the
+ * time to wait for the semaphore is given as an absolute deadline of the high
+ * resolution counter returned by ullTaskGetTimeNs() rather than as a number of
+ * ticks.  If the semaphore is not available the task leaves the Blocked state
+ * when the deadline passes, rather than at the next tick interrupt.
+ *
+ * @param xSemaphore A handle to the semaphore being taken - obtained when
+ * the semaphore was created.
+ *
+ * @param ullDeadlineNs The time, in nanoseconds, after which the call will
+ * stop waiting for the semaphore.
+ *
+ * @return pdTRUE if the semaphore was obtained.  pdFALSE if the deadline
+ * passed without the semaphore becoming available.
+ *
+ * \defgroup xSemaphoreTakeUntilNs xSemaphoreTakeUntilNs
+ * \ingroup Semaphores
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    #define xSemaphoreTakeUntilNs( xSemaphore, ullDeadlineNs )    xQueueSemaphoreTakeUntilNs( ( xSemaphore ), ( ullDeadlineNs ) )
+#endif
+
 /**
  * semphr. h
  * @code{c}
@@ -674,6 +708,106 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreTakeFromISR( xSemaphore, pxHigherPriorityTaskWoken )    xQueueReceiveFromISR( ( QueueHandle_t ) ( xSemaphore ), NULL, ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * semphr. h
+ * @code{c}
+ * UBaseType_t uxSemaphoreGiveMultiple( SemaphoreHandle_t xSemaphore, UBaseType_t uxCount );
+ * @endcode
+ *
+ * <i>Macro</i> to release uxCount units of a counting semaphore at once.
+ * configUSE_QUEUE_BATCH_OPERATIONS must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * The semaphore count is increased, and up to uxCount tasks waiting to take
+ * the semaphore are unblocked, within a single critical section, which is
+ * cheaper than calling xSemaphoreGive() uxCount times.  Mutex type semaphores
+ * must not be used with this macro.
+ *
+ * @param xSemaphore A handle to the semaphore being released.
+ *
+ * @param uxCount The number of units to release.
+ *
+ * @return The number of units released.  This is less than uxCount if the
+ * count would otherwise have exceeded the semaphore's maximum count.
+ *
+ * Example usage:
+ * @code{c}
+ * // Return a whole batch of buffers to a pool guarded by xBufferPool.
+ * if( uxSemaphoreGiveMultiple( xBufferPool, 16 ) != 16 )
+ * {
+ *     // More buffers were returned than the pool holds.
+ * }
+ * @endcode
+ * \defgroup uxSemaphoreGiveMultiple uxSemaphoreGiveMultiple
+ * \ingroup Semaphores
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    #define uxSemaphoreGiveMultiple( xSemaphore, uxCount )    uxQueueSemaphoreGiveMultiple( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * UBaseType_t uxSemaphoreTakeMultiple( SemaphoreHandle_t xSemaphore,
+ *                                      UBaseType_t uxMaxCount,
+ *                                      TickType_t xBlockTime );
+ * @endcode
+ *
+ * <i>Macro</i> to obtain up to uxMaxCount units of a counting semaphore at
+ * once.  configUSE_QUEUE_BATCH_OPERATIONS must be set to 1 in FreeRTOSConfig.h
+ * for this macro to be available.
+ *
+ * All the units that are available, up to uxMaxCount, are taken within a
+ * single critical section.  If no units are available the calling task blocks
+ * until at least one is, or until xBlockTime expires.  Mutex type semaphores
+ * must not be used with this macro.
+ *
+ * @param xSemaphore A handle to the semaphore being taken.
+ *
+ * @param uxMaxCount The maximum number of units to take.  Must not be 0.
+ *
+ * @param xBlockTime The time in ticks to wait for a unit to become available.
+ *
+ * @return The number of units taken, or 0 if xBlockTime expired without a unit
+ * becoming available.
+ *
+ * \defgroup uxSemaphoreTakeMultiple uxSemaphoreTakeMultiple
+ * \ingroup Semaphores
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    #define uxSemaphoreTakeMultiple( xSemaphore, uxMaxCount, xBlockTime )    uxQueueSemaphoreTakeMultiple( ( QueueHandle_t ) ( xSemaphore ), ( uxMaxCount ), ( xBlockTime ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * UBaseType_t uxSemaphoreGiveMultipleFromISR( SemaphoreHandle_t xSemaphore,
+ *                                             UBaseType_t uxCount,
+ *                                             BaseType_t *pxHigherPriorityTaskWoken );
+ * UBaseType_t uxSemaphoreTakeMultipleFromISR( SemaphoreHandle_t xSemaphore,
+ *                                             UBaseType_t uxMaxCount,
+ *                                             BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Versions of uxSemaphoreGiveMultiple() and uxSemaphoreTakeMultiple() that can
+ * be called from an interrupt service routine.  uxSemaphoreTakeMultipleFromISR()
+ * only takes the units that are available, as an interrupt cannot block.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing or taking the
+ * units unblocked a task that has a priority higher than the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * @return The number of units released or taken.
+ *
+ * \defgroup uxSemaphoreGiveMultipleFromISR uxSemaphoreGiveMultipleFromISR
+ * \ingroup Semaphores
+ */
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+    #define uxSemaphoreGiveMultipleFromISR( xSemaphore, uxCount, pxHigherPriorityTaskWoken )       uxQueueSemaphoreGiveMultipleFromISR( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ), ( pxHigherPriorityTaskWoken ) )
+    #define uxSemaphoreTakeMultipleFromISR( xSemaphore, uxMaxCount, pxHigherPriorityTaskWoken )    uxQueueSemaphoreTakeMultipleFromISR( ( QueueHandle_t ) ( xSemaphore ), ( uxMaxCount ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
 /**
  * semphr. h
  * @code{c}
@@ -798,6 +932,72 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * @endcode
+ *
+ * Creates a new mutex type semaphore that uses the immediate priority ceiling
+ * protocol instead of priority inheritance, and returns a handle by which the
+ * new mutex can be referenced.  configUSE_MUTEX_PRIORITY_CEILING must be set
+ * to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * A task that takes the mutex has its priority raised to uxCeilingPriority
+ * straight away, and returns to its base priority once it no longer holds any
+ * mutexes.  As the holder already runs at the ceiling, a task that attempts to
+ * take the mutex while it is held does not raise the priority of the holder,
+ * so the ready lists are never re-sorted because of contention on the mutex.
+ *
+ * uxCeilingPriority must be at least the priority of the highest priority task
+ * that takes the mutex.  A task that takes the mutex while running above the
+ * ceiling keeps its own priority.
+ *
+ * Mutexes created using this function can be accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros.  The xSemaphoreTakeRecursive() and
+ * xSemaphoreGiveRecursive() macros must not be used.  As with any mutex, the
+ * mutex cannot be used from within interrupt service routines.
+ *
+ * @param uxCeilingPriority The priority the holder of the mutex runs at.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If there was not enough heap to allocate the mutex data
+ * structures then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+ *                                                           StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * As xSemaphoreCreateMutexWithCeiling(), but the memory used to hold the
+ * mutex is provided by the application writer.  See
+ * xSemaphoreCreateMutexStatic().
+ *
+ * @param uxCeilingPriority The priority the holder of the mutex runs at.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure, removing the need for
+ * the memory to be allocated dynamically.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If pxMutexBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeilingStatic xSemaphoreCreateMutexWithCeilingStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -1112,6 +1312,181 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer )    xQueueCreateCountingSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateRwLock( void );
+ * @endcode
+ *
+ * Creates a new reader-writer lock, and returns a handle by which the new lock
+ * can be referenced.  configUSE_RW_LOCKS must be set to 1 in FreeRTOSConfig.h
+ * for this function to be available.
+ *
+ * Any number of tasks can hold a reader-writer lock for reading at the same
+ * time, using xSemaphoreTakeRead() and xSemaphoreGiveRead(), but only one task
+ * can hold it for writing, using xSemaphoreTakeWrite() and
+ * xSemaphoreGiveWrite(), and then only while no task holds it for reading.
+ *
+ * Writers are preferred over readers: while a task is blocked waiting to take
+ * the lock for writing no further tasks can take it for reading, so a steady
+ * stream of readers cannot prevent a writer from ever taking the lock.  A task that
+ * already holds the lock for reading must therefore not attempt to take it for
+ * reading again.
+ *
+ * The task that holds the lock for writing inherits the priority of any higher
+ * priority task that waits for the lock, as the holder of a mutex does.  Tasks
+ * that hold the lock for reading do not inherit priorities.
+ *
+ * Reader-writer locks are always taken through the kernel, cannot be taken
+ * recursively, and cannot be added to a queue set.
+ *
+ * @return If the lock was successfully created then a handle to the created
+ * lock is returned.  If there was not enough heap to allocate the lock data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xTableLock;
+ *
+ * void vReaderTask( void * pvParameters )
+ * {
+ *  for( ;; )
+ *  {
+ *      if( xSemaphoreTakeRead( xTableLock, portMAX_DELAY ) == pdTRUE )
+ *      {
+ *          // Any number of readers can access the table here at once.
+ *
+ *          xSemaphoreGiveRead( xTableLock );
+ *      }
+ *  }
+ * }
+ *
+ * void vWriterTask( void * pvParameters )
+ * {
+ *  for( ;; )
+ *  {
+ *      if( xSemaphoreTakeWrite( xTableLock, portMAX_DELAY ) == pdTRUE )
+ *      {
+ *          // Only this task can access the table here.
+ *
+ *          xSemaphoreGiveWrite( xTableLock );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateRwLock xSemaphoreCreateRwLock
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_RW_LOCKS == 1 ) )
+    #define xSemaphoreCreateRwLock()    xQueueCreateRwLock()
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateRwLockStatic( StaticSemaphore_t *pxRwLockBuffer );
+ * @endcode
+ *
+ * As xSemaphoreCreateRwLock(), but the memory used to hold the lock is
+ * provided by the application writer.
+ *
+ * @param pxRwLockBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the lock's data structure, removing the need for
+ * the memory to be allocated dynamically.
+ *
+ * @return If the lock was successfully created then a handle to the created
+ * lock is returned.  If pxRwLockBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateRwLockStatic xSemaphoreCreateRwLockStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_RW_LOCKS == 1 ) )
+    #define xSemaphoreCreateRwLockStatic( pxRwLockBuffer )    xQueueCreateRwLockStatic( ( pxRwLockBuffer ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreTakeRead( SemaphoreHandle_t xRwLock, TickType_t xBlockTime );
+ * BaseType_t xSemaphoreTakeWrite( SemaphoreHandle_t xRwLock, TickType_t xBlockTime );
+ * @endcode
+ *
+ * Take a reader-writer lock created with xSemaphoreCreateRwLock() or
+ * xSemaphoreCreateRwLockStatic() for reading or for writing respectively.
+ *
+ * @param xRwLock A handle to the lock being taken.
+ *
+ * @param xBlockTime The time in ticks to wait for the lock to become
+ * available.  A block time of zero can be used to poll the lock.
+ *
+ * @return pdTRUE if the lock was taken.  pdFALSE if xBlockTime expired
+ * without the lock becoming available.
+ *
+ * \defgroup xSemaphoreTakeRead xSemaphoreTakeRead
+ * \ingroup Semaphores
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #define xSemaphoreTakeRead( xRwLock, xBlockTime )     xQueueTakeRwLock( ( xRwLock ), pdFALSE, ( xBlockTime ) )
+    #define xSemaphoreTakeWrite( xRwLock, xBlockTime )    xQueueTakeRwLock( ( xRwLock ), pdTRUE, ( xBlockTime ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreGiveRead( SemaphoreHandle_t xRwLock );
+ * BaseType_t xSemaphoreGiveWrite( SemaphoreHandle_t xRwLock );
+ * @endcode
+ *
+ * Give back a reader-writer lock previously taken with xSemaphoreTakeRead() or
+ * xSemaphoreTakeWrite() respectively.  When the last reader gives the lock
+ * back the highest priority task waiting to write is unblocked.  When a writer
+ * gives the lock back the highest priority task waiting to write is unblocked
+ * if there is one, otherwise every task waiting to read is unblocked.
+ *
+ * @param xRwLock A handle to the lock being given back.
+ *
+ * @return pdTRUE if the lock was given back.  pdFALSE if the lock was not held
+ * for reading, or, for xSemaphoreGiveWrite(), not held for writing by the
+ * calling task.
+ *
+ * \defgroup xSemaphoreGiveRead xSemaphoreGiveRead
+ * \ingroup Semaphores
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #define xSemaphoreGiveRead( xRwLock )     xQueueGiveRwLock( ( xRwLock ), pdFALSE )
+    #define xSemaphoreGiveWrite( xRwLock )    xQueueGiveRwLock( ( xRwLock ), pdTRUE )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * BaseType_t xSemaphoreTakeReadFromISR( SemaphoreHandle_t xRwLock );
+ * BaseType_t xSemaphoreGiveReadFromISR( SemaphoreHandle_t xRwLock,
+ *                                       BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Versions of xSemaphoreTakeRead() and xSemaphoreGiveRead() that can be
+ * called from an interrupt service routine.  An interrupt cannot wait for the
+ * lock, so xSemaphoreTakeReadFromISR() fails if a task holds the lock for
+ * writing or is waiting to do so.  An interrupt cannot take the lock for
+ * writing.
+ *
+ * @param xRwLock A handle to the lock being taken or given back.
+ *
+ * @param pxHigherPriorityTaskWoken xSemaphoreGiveReadFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if giving the lock back unblocked a task
+ * waiting to write that has a priority higher than the currently running task.
+ *
+ * @return pdTRUE if the lock was taken or given back, otherwise pdFALSE.
+ *
+ * \defgroup xSemaphoreTakeReadFromISR xSemaphoreTakeReadFromISR
+ * \ingroup Semaphores
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #define xSemaphoreTakeReadFromISR( xRwLock )                               xQueueTakeRwLockFromISR( ( xRwLock ) )
+    #define xSemaphoreGiveReadFromISR( xRwLock, pxHigherPriorityTaskWoken )    xQueueGiveRwLockFromISR( ( xRwLock ), ( pxHigherPriorityTaskWoken ) )
+#endif
+
 /**
  * semphr. h
  * @code{c}
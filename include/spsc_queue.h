@@ -0,0 +1,365 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * SPSC queues build functionality on top of FreeRTOS stream buffers.  An SPSC
+ * queue passes fixed size items from one task or interrupt (the writer) to
+ * one other task or interrupt (the reader), in the order they were sent.
+ *
+ * Because there is only one writer and only one reader, sending and receiving
+ * an item only copies the item and then updates the buffer's head or tail
+ * index.  Neither operation enters a critical section unless a task is blocked
+ * on the other end of the queue, making SPSC queues particularly suited to
+ * high rate interrupt to task communication.  Tasks that block on an SPSC
+ * queue do so using a task notification, exactly as they would on a stream
+ * buffer.  SPSC queues always use direct task notifications, so the
+ * sbSEND_COMPLETED() and sbRECEIVE_COMPLETED() macros are not used.
+ *
+ * ***NOTE***:  As with stream buffers and message buffers, it is not safe to
+ * have more than one writer or more than one reader.  Use a FreeRTOS queue if
+ * there are multiple writers or multiple readers.
+ */
+
+#ifndef FREERTOS_SPSC_QUEUE_H
+#define FREERTOS_SPSC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_queue.h"
+#endif
+
+/* SPSC queues are built onto of stream buffers. */
+#include "stream_buffer.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which SPSC queues are referenced.  An SPSC queue is built as a
+ * stream buffer, hence its handle is also set to same type as a stream buffer
+ * handle.
+ */
+typedef StreamBufferHandle_t SpscQueueHandle_t;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * The number of bytes of storage a statically allocated SPSC queue capable of
+ * holding uxQueueLength items of uxItemSize bytes requires.
+ */
+#define spscQUEUE_STORAGE_SIZE_BYTES( uxQueueLength, uxItemSize ) \
+    ( ( ( size_t ) ( uxQueueLength ) * ( size_t ) ( uxItemSize ) ) + ( size_t ) 1 )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SpscQueueHandle_t xSpscQueueCreate( UBaseType_t uxQueueLength,
+ *                                     UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new SPSC queue using dynamically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h, and configUSE_STREAM_BUFFERS must be set to 1 in
+ * FreeRTOSConfig.h, for xSpscQueueCreate() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold at any
+ * one time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Must not be 0.
+ *
+ * @return A handle to the created SPSC queue, or NULL if there was
+ * insufficient heap memory available to create it.
+ *
+ * \defgroup xSpscQueueCreate xSpscQueueCreate
+ * \ingroup SpscQueueManagement
+ */
+#define xSpscQueueCreate( uxQueueLength, uxItemSize ) \
+    xStreamBufferGenericCreate( ( size_t ) ( uxQueueLength ) * ( size_t ) ( uxItemSize ), ( size_t ) ( uxItemSize ), sbTYPE_SPSC_QUEUE, NULL, NULL )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SpscQueueHandle_t xSpscQueueCreateStatic( UBaseType_t uxQueueLength,
+ *                                           UBaseType_t uxItemSize,
+ *                                           uint8_t *pucQueueStorage,
+ *                                           StaticSpscQueue_t *pxStaticQueue );
+ * @endcode
+ *
+ * Creates a new SPSC queue using statically allocated memory.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xSpscQueueCreateStatic() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold at any
+ * one time.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Must not be 0.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array that is at least
+ * spscQUEUE_STORAGE_SIZE_BYTES( uxQueueLength, uxItemSize ) big.
+ *
+ * @param pxStaticQueue Must point to a variable of type StaticSpscQueue_t,
+ * which will be used to hold the queue's data structure.
+ *
+ * @return A handle to the created SPSC queue, or NULL if either
+ * pucQueueStorage or pxStaticQueue is NULL.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * typedef struct
+ * {
+ *  uint32_t ulTimestamp;
+ *  int16_t sX, sY, sZ;
+ * } Sample_t;
+ *
+ * static uint8_t ucStorage[ spscQUEUE_STORAGE_SIZE_BYTES( 64, sizeof( Sample_t ) ) ];
+ * static StaticSpscQueue_t xQueueStruct;
+ * static SpscQueueHandle_t xSampleQueue;
+ *
+ * void vSetup( void )
+ * {
+ *  xSampleQueue = xSpscQueueCreateStatic( 64, sizeof( Sample_t ), ucStorage, &xQueueStruct );
+ * }
+ *
+ * void vSensorISR( void )
+ * {
+ * Sample_t xSample;
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  vReadSensor( &xSample );
+ *
+ *  if( xSpscQueueSendFromISR( xSampleQueue, &xSample, &xHigherPriorityTaskWoken ) != pdPASS )
+ *  {
+ *      // The queue was full so the sample was dropped.
+ *  }
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vProcessingTask( void *pvParameters )
+ * {
+ * Sample_t xSample;
+ *
+ *  for( ;; )
+ *  {
+ *      if( xSpscQueueReceive( xSampleQueue, &xSample, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vProcessSample( &xSample );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSpscQueueCreateStatic xSpscQueueCreateStatic
+ * \ingroup SpscQueueManagement
+ */
+#define xSpscQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue ) \
+    xStreamBufferGenericCreateStatic( spscQUEUE_STORAGE_SIZE_BYTES( ( uxQueueLength ), ( uxItemSize ) ), ( size_t ) ( uxItemSize ), sbTYPE_SPSC_QUEUE, ( pucQueueStorage ), ( pxStaticQueue ), NULL, NULL )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueSend( SpscQueueHandle_t xQueue,
+ *                            const void *pvItem,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item to the back of an SPSC queue.  Must only be called by the
+ * queue's single writer.  Use xSpscQueueSendFromISR() to write to the queue
+ * from an interrupt service routine.
+ *
+ * @param xQueue The handle of the queue to which the item is being sent.
+ *
+ * @param pvItem A pointer to the item to copy into the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for space to become available should
+ * the queue be full.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xSpscQueueSend xSpscQueueSend
+ * \ingroup SpscQueueManagement
+ */
+#define xSpscQueueSend( xQueue, pvItem, xTicksToWait ) \
+    xStreamBufferSendItem( ( xQueue ), ( pvItem ), ( xTicksToWait ) )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueSendFromISR( SpscQueueHandle_t xQueue,
+ *                                   const void *pvItem,
+ *                                   BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscQueueSend().
+ *
+ * @param xQueue The handle of the queue to which the item is being sent.
+ *
+ * @param pvItem A pointer to the item to copy into the queue.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a task that has a priority above the priority of the currently executing
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xSpscQueueSendFromISR xSpscQueueSendFromISR
+ * \ingroup SpscQueueManagement
+ */
+#define xSpscQueueSendFromISR( xQueue, pvItem, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendItemFromISR( ( xQueue ), ( pvItem ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueReceive( SpscQueueHandle_t xQueue,
+ *                               void *pvBuffer,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the item at the front of an SPSC queue into pvBuffer and removes it
+ * from the queue.  Must only be called by the queue's single reader.  Use
+ * xSpscQueueReceiveFromISR() to read from the queue from an interrupt service
+ * routine.
+ *
+ * @param xQueue The handle of the queue from which the item is being received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item will be copied.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for an item should the queue be empty.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xSpscQueueReceive xSpscQueueReceive
+ * \ingroup SpscQueueManagement
+ */
+#define xSpscQueueReceive( xQueue, pvBuffer, xTicksToWait ) \
+    xStreamBufferReceiveItem( ( xQueue ), ( pvBuffer ), ( xTicksToWait ) )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueReceiveFromISR( SpscQueueHandle_t xQueue,
+ *                                      void *pvBuffer,
+ *                                      BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSpscQueueReceive().
+ *
+ * @param xQueue The handle of the queue from which the item is being received.
+ *
+ * @param pvBuffer A pointer to the buffer into which the item will be copied.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item
+ * unblocked a task that has a priority above the priority of the currently
+ * executing task, in which case a context switch should be requested before
+ * the interrupt is exited.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xSpscQueueReceiveFromISR xSpscQueueReceiveFromISR
+ * \ingroup SpscQueueManagement
+ */
+#define xSpscQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveItemFromISR( ( xQueue ), ( pvBuffer ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * void vSpscQueueDelete( SpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Deletes an SPSC queue.  If the queue was created using xSpscQueueCreate()
+ * then the allocated memory is freed.
+ *
+ * @param xQueue The handle of the queue to be deleted.
+ */
+#define vSpscQueueDelete( xQueue ) \
+    vStreamBufferDelete( xQueue )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueIsFull( SpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * @return pdTRUE if there is no space in the queue for another item,
+ * otherwise pdFALSE.
+ */
+#define xSpscQueueIsFull( xQueue ) \
+    xStreamBufferIsFull( xQueue )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueIsEmpty( SpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * @return pdTRUE if the queue does not contain any items, otherwise pdFALSE.
+ */
+#define xSpscQueueIsEmpty( xQueue ) \
+    xStreamBufferIsEmpty( xQueue )
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueReset( SpscQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Resets an SPSC queue to its initial empty state, discarding any items it
+ * contains.  A queue can only be reset if there are no tasks blocked on it.
+ *
+ * @return pdPASS if the queue was reset, otherwise pdFAIL.
+ */
+#define xSpscQueueReset( xQueue ) \
+    xStreamBufferReset( xQueue )
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( FREERTOS_SPSC_QUEUE_H ) */
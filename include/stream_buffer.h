@@ -45,7 +45,9 @@
  * block time to 0.  Likewise, if there are to be multiple different readers
  * then the application writer must place each call to a reading API function
  * (such as xStreamBufferReceive()) inside a critical section section and set the
- * receive block time to 0.
+ * receive block time to 0.  Alternatively, when configUSE_MPMC_STREAM_BUFFERS
+ * is set to 1, a stream buffer created using xStreamBufferCreateMPMC() can be
+ * written and read by any number of tasks.
  *
  */
 
@@ -68,6 +70,10 @@
 #define sbTYPE_STREAM_BUFFER             ( ( BaseType_t ) 0 )
 #define sbTYPE_MESSAGE_BUFFER            ( ( BaseType_t ) 1 )
 #define sbTYPE_STREAM_BATCHING_BUFFER    ( ( BaseType_t ) 2 )
+#define sbTYPE_SPSC_QUEUE                ( ( BaseType_t ) 3 )
+#define sbTYPE_MPMC_STREAM_BUFFER        ( ( BaseType_t ) 4 )
+#define sbTYPE_MPMC_MESSAGE_BUFFER       ( ( BaseType_t ) 5 )
+#define sbTYPE_BROADCAST_MESSAGE_BUFFER  ( ( BaseType_t ) 6 )
 
 /**
  * Type by which stream buffers are referenced.  For example, a call to
@@ -85,6 +91,37 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * Describes one of the buffers into which xStreamBufferReceiveV() copies the
+ * data it receives.
+ */
+typedef struct StreamBufferVector
+{
+    void * pvData;  /* Start of the buffer. */
+    size_t xLength; /* Number of bytes in the buffer. */
+} StreamBufferVector_t;
+
+/**
+ * Describes one of the buffers from which xStreamBufferSendV() gathers the
+ * data it sends.  The data is only read, so it can be const.
+ */
+typedef struct StreamBufferConstVector
+{
+    const void * pvData; /* Start of the buffer. */
+    size_t xLength;      /* Number of bytes in the buffer. */
+} StreamBufferConstVector_t;
+
+/**
+ * Holds a reader's position within a broadcast message buffer.  Allocated by
+ * the reader, initialised by vMessageBufferSubscribe(), then only accessed by
+ * the kernel.
+ */
+typedef struct StreamBufferSubscriber
+{
+    size_t xNextByte;    /* Number of bytes published before the next message to read. */
+    size_t xNextMessage; /* Number of messages published before the next message to read. */
+} StreamBufferSubscriber_t;
+
 /**
  * stream_buffer.h
  *
@@ -459,6 +496,52 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
     xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BATCHING_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamBufferCreateMPMC( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ * StreamBufferHandle_t xStreamBufferCreateMPMCStatic( size_t xBufferSizeBytes,
+ *                                                     size_t xTriggerLevelBytes,
+ *                                                     uint8_t *pucStreamBufferStorageArea,
+ *                                                     StaticStreamBuffer_t *pxStaticStreamBuffer );
+ * @endcode
+ *
+ * Creates a stream buffer that, unlike a stream buffer created with
+ * xStreamBufferCreate(), can be written to by more than one task and read from
+ * by more than one task at the same time.  The parameters have the same meaning
+ * as the parameters of xStreamBufferCreate() and xStreamBufferCreateStatic().
+ *
+ * A writer reserves the space it needs within a short critical section then
+ * copies its data into the reserved space outside of the critical section, so
+ * writers (and likewise readers) only serialise for the time taken to update
+ * the buffer's indexes.  Data becomes visible to readers in the order in which
+ * the space was reserved, once every writer that reserved space ahead of it has
+ * finished copying.  Each call to xStreamBufferSend() writes its data as one
+ * contiguous block, and each call to xStreamBufferReceive() reads a contiguous
+ * block, so the bytes written by different tasks are never interleaved.  Any
+ * number of tasks can block on the buffer, and all are unblocked when space or
+ * data becomes available.
+ *
+ * Such buffers can only be accessed from tasks - xStreamBufferSendFromISR(),
+ * xStreamBufferReceiveFromISR() and the zero copy region API cannot be used.
+ * xStreamBufferReset() fails if any task is part way through a send or receive.
+ *
+ * configUSE_MPMC_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferCreateMPMC() and xStreamBufferCreateMPMCStatic() to be
+ * available.
+ *
+ * \defgroup xStreamBufferCreateMPMC xStreamBufferCreateMPMC
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    #define xStreamBufferCreateMPMC( xBufferSizeBytes, xTriggerLevelBytes ) \
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_MPMC_STREAM_BUFFER, NULL, NULL )
+
+    #define xStreamBufferCreateMPMCStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_MPMC_STREAM_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), NULL, NULL )
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -594,6 +677,52 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           size_t xDataLengthBytes,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+ *                            const StreamBufferConstVector_t * pxVectors,
+ *                            UBaseType_t uxVectorCount,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * A version of xStreamBufferSend() that gathers the data to send from several
+ * buffers, so data assembled from separate pieces (for example a header, a
+ * payload and a checksum) does not first have to be copied into one staging
+ * buffer.
+ *
+ * The bytes are sent exactly as if their concatenation had been passed to
+ * xStreamBufferSend().  When used on a message buffer (through
+ * xMessageBufferSendV()) the vectors form one message with one length, so the
+ * message is either written completely or not at all, and the reader is
+ * notified once.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferSendV() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which a stream is
+ * being sent.
+ *
+ * @param pxVectors An array of uxVectorCount structures, each giving the start
+ * and length of one of the buffers to send, in order.  Vectors with a length
+ * of 0 are skipped.
+ *
+ * @param uxVectorCount The number of entries in the pxVectors array.
+ *
+ * @param xTicksToWait As for xStreamBufferSend(), where the space required is
+ * the total length of all the vectors.
+ *
+ * @return The number of bytes written to the stream buffer.
+ *
+ * \defgroup xStreamBufferSendV xStreamBufferSendV
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferConstVector_t * pxVectors,
+                           UBaseType_t uxVectorCount,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -790,6 +919,47 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
                              size_t xBufferLengthBytes,
                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+ *                               const StreamBufferVector_t * pxVectors,
+ *                               UBaseType_t uxVectorCount,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * A version of xStreamBufferReceive() that scatters the received bytes across
+ * several buffers.  The buffers are filled in order, each one being filled
+ * completely before the next is used.
+ *
+ * When used on a message buffer (through xMessageBufferReceiveV()) the total
+ * length of the vectors must be large enough to hold the next message,
+ * otherwise the message is left in the message buffer and 0 is returned.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferReceiveV() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which bytes are to
+ * be received.
+ *
+ * @param pxVectors An array of uxVectorCount structures, each giving the start
+ * and length of one of the buffers into which bytes are copied.
+ *
+ * @param uxVectorCount The number of entries in the pxVectors array.
+ *
+ * @param xTicksToWait As for xStreamBufferReceive().
+ *
+ * @return The number of bytes read from the stream buffer.
+ *
+ * \defgroup xStreamBufferReceiveV xStreamBufferReceiveV
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+                              const StreamBufferVector_t * pxVectors,
+                              UBaseType_t uxVectorCount,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -879,6 +1049,268 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
                                     size_t xBufferLengthBytes,
                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferGetWriteRegion( StreamBufferHandle_t xStreamBuffer,
+ *                                     void ** ppvRegion,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains a pointer to the free space at the head of a stream buffer so the
+ * writer can place data directly into the stream buffer's storage area rather
+ * than copying it in with xStreamBufferSend().  Data written into the region
+ * is not visible to the reader until it is committed with
+ * xStreamBufferCommitWrite() or xStreamBufferCommitWriteFromISR().
+ *
+ * The returned region is always contiguous, so it ends at the end of the
+ * storage area even if there is more free space at the start of the storage
+ * area.  Once the region has been committed, call
+ * xStreamBufferGetWriteRegion() again to obtain the space that has wrapped
+ * around to the start of the storage area.
+ *
+ * The region is only valid until it is committed, and only the single writer
+ * may hold it.  The writer must not call xStreamBufferSend() or
+ * xStreamBufferSendFromISR() between obtaining and committing a region.
+ * Regions cannot be obtained from message buffers, as doing so would bypass
+ * the message length that precedes each message.
+ *
+ * xStreamBufferGetWriteRegion() can be called from an interrupt service
+ * routine if xTicksToWait is 0.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferGetWriteRegion() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which data will be
+ * written.
+ *
+ * @param ppvRegion Set to point to the start of the region, or to NULL if the
+ * stream buffer is full.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for space to become available if the
+ * stream buffer is full.
+ *
+ * @return The number of bytes that can be written to *ppvRegion.  0 is
+ * returned if the call timed out before any space became available.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * void * pvRegion;
+ * size_t xRegionLength, xWritten;
+ *
+ *  // Wait up to 100ms for space to become available.
+ *  xRegionLength = xStreamBufferGetWriteRegion( xStreamBuffer, &pvRegion, pdMS_TO_TICKS( 100 ) );
+ *
+ *  if( xRegionLength > 0 )
+ *  {
+ *      // Have the driver write directly into the stream buffer.
+ *      xWritten = xDriverRead( pvRegion, xRegionLength );
+ *
+ *      // Make the data visible to the reader, unblocking the reader if the
+ *      // trigger level has been reached.
+ *      ( void ) xStreamBufferCommitWrite( xStreamBuffer, xWritten );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferGetWriteRegion xStreamBufferGetWriteRegion
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetWriteRegion( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvRegion,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+ *                                  size_t xBytesWritten );
+ * @endcode
+ *
+ * Adds the first xBytesWritten bytes of the region obtained by
+ * xStreamBufferGetWriteRegion() to the stream buffer.  As with
+ * xStreamBufferSend(), a task blocked waiting to read from the stream buffer
+ * is unblocked once the number of bytes in the stream buffer reaches the
+ * trigger level.
+ *
+ * Use xStreamBufferCommitWrite() to commit a region from a task.  Use
+ * xStreamBufferCommitWriteFromISR() to commit a region from an interrupt
+ * service routine (ISR).
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferCommitWrite() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that contains the
+ * region.
+ *
+ * @param xBytesWritten The number of bytes written to the region.  Must not be
+ * greater than the length returned by xStreamBufferGetWriteRegion().
+ *
+ * @return The number of bytes added to the stream buffer.
+ *
+ * \defgroup xStreamBufferCommitWrite xStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                         size_t xBytesWritten,
+ *                                         BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xStreamBufferCommitWrite().
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferCommitWriteFromISR() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that contains the
+ * region.
+ *
+ * @param xBytesWritten The number of bytes written to the region.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if committing the region
+ * unblocked a task that has a priority above the priority of the interrupted
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.  *pxHigherPriorityTaskWoken should be set to pdFALSE
+ * before it is passed into the function.
+ *
+ * @return The number of bytes added to the stream buffer.
+ *
+ * \defgroup xStreamBufferCommitWriteFromISR xStreamBufferCommitWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xBytesWritten,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferGetReadRegion( StreamBufferHandle_t xStreamBuffer,
+ *                                    void ** ppvRegion,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains a pointer to the data at the tail of a stream buffer so the reader
+ * can process the data in place rather than copying it out with
+ * xStreamBufferReceive().  The data remains in the stream buffer until it is
+ * released with xStreamBufferConsume() or xStreamBufferConsumeFromISR().
+ *
+ * The returned region is always contiguous, so it ends at the end of the
+ * storage area even if more data has wrapped around to the start of the
+ * storage area.  Once the region has been consumed, call
+ * xStreamBufferGetReadRegion() again to obtain the data that follows it.
+ *
+ * The region is only valid until it is consumed, and only the single reader
+ * may hold it.  The reader must not call xStreamBufferReceive() or
+ * xStreamBufferReceiveFromISR() between obtaining and consuming a region.
+ * Regions cannot be obtained from message buffers.
+ *
+ * xStreamBufferGetReadRegion() can be called from an interrupt service routine
+ * if xTicksToWait is 0.
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferGetReadRegion() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer from which data will be
+ * read.
+ *
+ * @param ppvRegion Set to point to the start of the region, or to NULL if
+ * there is no data to read.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for data if the stream buffer is empty.
+ * As with xStreamBufferReceive(), the task is unblocked when the number of
+ * bytes in the stream buffer reaches the trigger level, or when the block
+ * time expires, whichever happens first.
+ *
+ * @return The number of bytes that can be read from *ppvRegion.
+ *
+ * \defgroup xStreamBufferGetReadRegion xStreamBufferGetReadRegion
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetReadRegion( StreamBufferHandle_t xStreamBuffer,
+                                   void ** ppvRegion,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+ *                              size_t xBytesRead );
+ * @endcode
+ *
+ * Removes the first xBytesRead bytes of the region obtained by
+ * xStreamBufferGetReadRegion() from the stream buffer.  As with
+ * xStreamBufferReceive(), a task blocked waiting for space in the stream
+ * buffer is unblocked.
+ *
+ * Use xStreamBufferConsume() to release a region from a task.  Use
+ * xStreamBufferConsumeFromISR() to release a region from an interrupt service
+ * routine (ISR).
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferConsume() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that contains the
+ * region.
+ *
+ * @param xBytesRead The number of bytes to remove.  Must not be greater than
+ * the length returned by xStreamBufferGetReadRegion().
+ *
+ * @return The number of bytes removed from the stream buffer.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xBytesRead,
+ *                                     BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An interrupt safe version of xStreamBufferConsume().
+ *
+ * configUSE_STREAM_BUFFERS must be set to 1 in for FreeRTOSConfig.h for
+ * xStreamBufferConsumeFromISR() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that contains the
+ * region.
+ *
+ * @param xBytesRead The number of bytes to remove.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing the region
+ * unblocked a task that has a priority above the priority of the interrupted
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.  *pxHigherPriorityTaskWoken should be set to pdFALSE
+ * before it is passed into the function.
+ *
+ * @return The number of bytes removed from the stream buffer.
+ *
+ * \defgroup xStreamBufferConsumeFromISR xStreamBufferConsumeFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytesRead,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -1264,6 +1696,37 @@ StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+    size_t xStreamBufferPublish( StreamBufferHandle_t xStreamBuffer,
+                                 const void * pvTxData,
+                                 size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+    size_t xStreamBufferPublishFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        const void * pvTxData,
+                                        size_t xDataLengthBytes,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    void vStreamBufferSubscribe( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSubscriber_t * const pxSubscriber ) PRIVILEGED_FUNCTION;
+    size_t xStreamBufferReceiveSubscribed( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferSubscriber_t * const pxSubscriber,
+                                           void * pvRxData,
+                                           size_t xBufferLengthBytes,
+                                           size_t * const pxMessagesLost,
+                                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+BaseType_t xStreamBufferSendItem( StreamBufferHandle_t xStreamBuffer,
+                                  const void * pvItem,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xStreamBufferSendItemFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         const void * pvItem,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xStreamBufferReceiveItem( StreamBufferHandle_t xStreamBuffer,
+                                     void * pvItem,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xStreamBufferReceiveItemFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void * pvItem,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer,
                                              UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
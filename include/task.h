@@ -250,6 +250,29 @@ typedef enum
     #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
 #endif
 
+/**
+ * task. h
+ *
+ * Macros to mark the start and end of a critical code region that protects a
+ * single kernel object (a data group), such as a queue, rather than the whole
+ * kernel.  The critical region holds the spinlock pointed to by pxSpinlock in
+ * place of the kernel locks, so critical regions that protect different data
+ * groups can execute on different cores at the same time.  Interrupts are
+ * masked and context switches are held pending as for taskENTER_CRITICAL().
+ *
+ * Only available when configUSE_GRANULAR_LOCKS is set to 1.  For use by the
+ * kernel, not application code.
+ *
+ * \defgroup taskDATA_GROUP_ENTER_CRITICAL taskDATA_GROUP_ENTER_CRITICAL
+ * \ingroup SchedulerControl
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #define taskDATA_GROUP_ENTER_CRITICAL( pxSpinlock )                                    vTaskDataGroupEnterCritical( pxSpinlock )
+    #define taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( pxSpinlock )                           uxTaskDataGroupEnterCriticalFromISR( pxSpinlock )
+    #define taskDATA_GROUP_EXIT_CRITICAL( pxSpinlock )                                     vTaskDataGroupExitCritical( pxSpinlock )
+    #define taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxSpinlock )    vTaskDataGroupExitCriticalFromISR( ( uxSavedInterruptStatus ), ( pxSpinlock ) )
+#endif
+
 /**
  * task. h
  *
@@ -397,6 +420,98 @@ typedef enum
                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateEDF( TaskFunction_t pxTaskCode,
+ *                            const char * const pcName,
+ *                            const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                            void *pvParameters,
+ *                            const TickType_t xRelativeDeadline,
+ *                            const TickType_t xPeriod,
+ *                            TaskHandle_t *pxCreatedTask );
+ * @endcode
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION and configUSE_EDF_SCHEDULING must both be
+ * set to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * Create a new periodic task that is scheduled by earliest deadline first
+ * (EDF) and add it to the list of tasks that are ready to run.
+ *
+ * EDF tasks all have the priority configEDF_PRIORITY.  Tasks of a higher
+ * priority always run before EDF tasks, and EDF tasks always run before tasks
+ * of a lower priority.  Among the EDF tasks the one with the earliest absolute
+ * deadline runs, and EDF tasks are not time sliced.
+ *
+ * The first period of the task starts when the task is created.  The task
+ * should call xTaskDelayUntilNextPeriod() at the end of each period, which
+ * also sets the absolute deadline for the next period.
+ *
+ * Do not change the priority of an EDF task using vTaskPrioritySet().  The
+ * priority configEDF_PRIORITY is reserved for EDF tasks, so other tasks,
+ * including the timer task, must not be created at that priority or have their
+ * priority set to it.
+ *
+ * @param pxTaskCode Pointer to the task entry function.
+ *
+ * @param pcName A descriptive name for the task.
+ *
+ * @param uxStackDepth The size of the task stack specified as the number of
+ * variables the stack can hold - not the number of bytes.
+ *
+ * @param pvParameters Pointer that will be used as the parameter for the task
+ * being created.
+ *
+ * @param xRelativeDeadline The number of ticks from the start of each period
+ * by which the task must complete the work of that period.  Must be greater
+ * than zero and not greater than xPeriod.
+ *
+ * @param xPeriod The number of ticks between the start of one period and the
+ * start of the next.
+ *
+ * @param pxCreatedTask Used to pass back a handle by which the created task
+ * can be referenced.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, otherwise an error code defined in the file projdefs.h
+ *
+ * Example usage:
+ * @code{c}
+ * // Task to be created.
+ * void vControlTask( void * pvParameters )
+ * {
+ * TickType_t xLastWakeTime = xTaskGetTickCount();
+ *
+ *   for( ;; )
+ *   {
+ *       // Perform the work for this period.
+ *       vUpdateControlLoop();
+ *
+ *       // Wait for the next period.
+ *       xTaskDelayUntilNextPeriod( &xLastWakeTime );
+ *   }
+ * }
+ *
+ * // Function that creates a task that must finish within 5 ticks of the
+ * // start of each 10 tick period.
+ * void vOtherFunction( void )
+ * {
+ *   xTaskCreateEDF( vControlTask, "CTRL", 200, NULL, 5, 10, NULL );
+ * }
+ * @endcode
+ * \defgroup xTaskCreateEDF xTaskCreateEDF
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+    BaseType_t xTaskCreateEDF( TaskFunction_t pxTaskCode,
+                               const char * const pcName,
+                               const configSTACK_DEPTH_TYPE uxStackDepth,
+                               void * const pvParameters,
+                               const TickType_t xRelativeDeadline,
+                               const TickType_t xPeriod,
+                               TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -923,6 +1038,62 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
 BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
                             const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskDelayUntilNextPeriod( TickType_t *pxPreviousWakeTime );
+ * @endcode
+ *
+ * INCLUDE_xTaskDelayUntil and configUSE_EDF_SCHEDULING must both be set to 1
+ * for this function to be available.
+ *
+ * Delay the calling EDF task until the start of its next period.  This is
+ * equivalent to calling xTaskDelayUntil() with xTimeIncrement set to the
+ * period passed to xTaskCreateEDF().  The absolute deadline of the task is
+ * moved to the start of the next period plus the task's relative deadline.
+ *
+ * Must only be called from a task created using xTaskCreateEDF().
+ *
+ * @param pxPreviousWakeTime Pointer to a variable that holds the time at which
+ * the task was last unblocked.  The variable must be initialised with the
+ * current time prior to its first use (see the example in xTaskCreateEDF()).
+ * Following this the variable is automatically updated.
+ *
+ * @return Value which can be used to check whether the task was actually
+ * delayed: pdTRUE if the task was delayed and pdFALSE otherwise.  A task will
+ * not be delayed if it has overrun its period.
+ *
+ * \defgroup xTaskDelayUntilNextPeriod xTaskDelayUntilNextPeriod
+ * \ingroup TaskCtrl
+ */
+#if ( ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+    BaseType_t xTaskDelayUntilNextPeriod( TickType_t * const pxPreviousWakeTime ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetDeadline( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be set to 1 for this function to be available.
+ *
+ * Obtain the absolute deadline of the current period of an EDF task.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL handle
+ * results in the deadline of the calling task being returned.
+ *
+ * @return The tick count by which the task must complete the work of its
+ * current period.  The value returned for a task that was not created using
+ * xTaskCreateEDF() is meaningless.
+ *
+ * \defgroup xTaskGetDeadline xTaskGetDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * vTaskDelayUntil() is the older version of xTaskDelayUntil() and does not
  * return a value.
@@ -2453,6 +2624,53 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
     configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSetBudget( TaskHandle_t xTask, configRUN_TIME_COUNTER_TYPE ulBudget, TickType_t xPeriod );
+ * @endcode
+ *
+ * configUSE_TASK_BUDGETS must be defined as 1 for this function to be
+ * available.  configUSE_TASK_BUDGETS requires configGENERATE_RUN_TIME_STATS to
+ * also be set to 1, as a task's budget is measured using the same run time
+ * counter used to generate run time statistics.
+ *
+ * Limit the amount of processing time a task can use within each period, so a
+ * misbehaving task cannot starve tasks of a lower priority.  Once a task has
+ * used ulBudget of run time within the current period it is held in the
+ * Blocked state until the start of its next period, at which point its budget
+ * is replenished.  The first period starts when xTaskSetBudget() is called.
+ *
+ * The budget is checked each time the task is switched out and, if
+ * configUSE_PREEMPTION is 1, on each tick interrupt, so a task can overrun its
+ * budget by up to one tick period.
+ *
+ * A task that is held in the Blocked state because it has used its budget
+ * still holds any mutexes it has taken, so budgets should be set generously
+ * for tasks that share mutexes with tasks of a higher priority.  Do not set a
+ * budget for the idle task.
+ *
+ * @param xTask Handle of the task whose budget is being set.  Passing a NULL
+ * handle results in the budget of the calling task being set.
+ *
+ * @param ulBudget The run time the task may use in each period, in the units
+ * of portGET_RUN_TIME_COUNTER_VALUE().  Set to 0 to remove the task's budget.
+ *
+ * @param xPeriod The length of the period in ticks.  Must not be 0 unless
+ * ulBudget is also 0.
+ *
+ * @return pdPASS if the budget was set, or pdFAIL if ulBudget was not 0 but
+ * xPeriod was 0.
+ *
+ * \defgroup xTaskSetBudget xTaskSetBudget
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TASK_BUDGETS == 1 )
+    BaseType_t xTaskSetBudget( TaskHandle_t xTask,
+                               configRUN_TIME_COUNTER_TYPE ulBudget,
+                               TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3439,6 +3657,130 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
  */
 BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * @code{c}
+ * BaseType_t xTaskCatchUpTicksFromISR( TickType_t xTicksToCatchUp );
+ * @endcode
+ *
+ * configUSE_DYNAMIC_TICK must be set to 1 for this function to be available.
+ *
+ * When configUSE_DYNAMIC_TICK is 1 the kernel does not need a periodic tick
+ * interrupt.  Instead it calls portSET_NEXT_TICK_INTERRUPT() with the number
+ * of ticks until the next tick it must process, and the port programs a one
+ * shot timer to generate an interrupt at that time.  The port's timer
+ * interrupt then calls xTaskCatchUpTicksFromISR() in place of
+ * xTaskIncrementTick(), passing the number of tick periods that have elapsed
+ * since the previous call.
+ *
+ * Like xTaskCatchUpTicks(), xTaskCatchUpTicksFromISR() may move the tick count
+ * past a time at which a task should leave the Blocked state.  Ticks in which
+ * no task leaves the Blocked state are not processed individually, so the
+ * tick hook is not called for them.
+ *
+ * Must only be called from the port's timer interrupt, with interrupts masked
+ * in the same way as when xTaskIncrementTick() is called.
+ *
+ * @param xTicksToCatchUp The number of tick periods that have elapsed since
+ * the previous call.  May be 0 if the interrupt occurred early.
+ *
+ * @return pdTRUE if moving the tick count forward means a context switch should
+ * be performed, otherwise pdFALSE.
+ *
+ * \defgroup xTaskCatchUpTicksFromISR xTaskCatchUpTicksFromISR
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    BaseType_t xTaskCatchUpTicksFromISR( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * uint64_t ullTaskGetTimeNs( void );
+ * @endcode
+ *
+ * configUSE_HIGH_RESOLUTION_TIMEOUTS must be set to 1 for this function to be
+ * available.
+ *
+ * @return The value of the port's free running high resolution counter, in
+ * nanoseconds.  High resolution deadlines are absolute values of this counter.
+ *
+ * \defgroup ullTaskGetTimeNs ullTaskGetTimeNs
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    uint64_t ullTaskGetTimeNs( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * BaseType_t xTaskDelayUntilNs( uint64_t ullDeadlineNs );
+ * @endcode
+ *
+ * configUSE_HIGH_RESOLUTION_TIMEOUTS must be set to 1 for this function to be
+ * available.
+ *
+ * Delay the calling task until the high resolution counter returned by
+ * ullTaskGetTimeNs() reaches ullDeadlineNs.  The task is moved out of the
+ * Blocked state by the port's high resolution timer interrupt at the deadline,
+ * rather than at the next tick interrupt, so the delay can be shorter than a
+ * tick period.
+ *
+ * @param ullDeadlineNs The absolute time, in nanoseconds, at which the task
+ * should leave the Blocked state.
+ *
+ * @return pdFALSE if ullDeadlineNs had already passed, in which case the task
+ * is not delayed, otherwise pdTRUE.
+ *
+ * Example usage:
+ * @code{c}
+ * // Poll a sensor every 200 microseconds.
+ * void vSensorTask( void * pvParameters )
+ * {
+ * uint64_t ullNextPollNs = ullTaskGetTimeNs();
+ *
+ *   for( ;; )
+ *   {
+ *       ullNextPollNs += 200000U;
+ *       xTaskDelayUntilNs( ullNextPollNs );
+ *
+ *       // Poll the sensor here.
+ *   }
+ * }
+ * @endcode
+ * \defgroup xTaskDelayUntilNs xTaskDelayUntilNs
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    BaseType_t xTaskDelayUntilNs( uint64_t ullDeadlineNs ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * BaseType_t xTaskCheckDeadlinesFromISR( void );
+ * @endcode
+ *
+ * configUSE_HIGH_RESOLUTION_TIMEOUTS must be set to 1 for this function to be
+ * available.
+ *
+ * Called by the port's high resolution timer interrupt, which is programmed
+ * using portSET_HIGH_RESOLUTION_TIMER().  Moves the tasks whose high resolution
+ * deadlines have passed out of the Blocked state, then programs the timer for
+ * the next deadline.
+ *
+ * @return pdTRUE if a context switch should be performed before the interrupt
+ * exits, otherwise pdFALSE.
+ *
+ * \defgroup xTaskCheckDeadlinesFromISR xTaskCheckDeadlinesFromISR
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    BaseType_t xTaskCheckDeadlinesFromISR( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task.h
  * @code{c}
@@ -3626,6 +3968,17 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the priority of the task that has just taken a mutex that has a
+ * priority ceiling to the ceiling, should the task have a lower priority.
+ * xTaskPriorityDisinherit() returns the task to its base priority once it
+ * holds no mutexes.
+ */
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    void vTaskPriorityRaiseToCeiling( TaskHandle_t const pxMutexHolder,
+                                      UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -3678,12 +4031,36 @@ void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Decrement the mutex held count of the calling task
+ * when a mutex is given back without entering the kernel, returning the task to
+ * its base priority if it no longer holds any mutexes.  Returns pdTRUE if a
+ * context switch is required.
+ */
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+    BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Sets the high resolution deadline of the blocking
+ * call the calling task is about to make and returns the block time, in ticks,
+ * to pass to that call.  Returns 0, and does not set the deadline, if
+ * ullDeadlineNs has already passed.  While the deadline is set the task leaves
+ * the Blocked state at the deadline, and xTaskCheckForTimeOut() uses the
+ * deadline in place of the block time.  vTaskInternalClearDeadlineNs() must be
+ * called when the blocking call returns.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    TickType_t xTaskInternalSetDeadlineNs( uint64_t ullDeadlineNs ) PRIVILEGED_FUNCTION;
+    void vTaskInternalClearDeadlineNs( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only. Same as portYIELD_WITHIN_API() in single core FreeRTOS.
  * For SMP this is not defined by the port.
@@ -3736,6 +4113,20 @@ void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNC
     void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
 #endif
 
+/*
+ * For internal use only.  Enter and exit a critical section that holds the
+ * spinlock of a single data group rather than the kernel locks.  Use the
+ * taskDATA_GROUP_ENTER_CRITICAL() family of macros rather than calling these
+ * functions directly.
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    void vTaskDataGroupEnterCritical( portSPINLOCK_TYPE * pxSpinlock ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxTaskDataGroupEnterCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock ) PRIVILEGED_FUNCTION;
+    void vTaskDataGroupExitCritical( portSPINLOCK_TYPE * pxSpinlock ) PRIVILEGED_FUNCTION;
+    void vTaskDataGroupExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus,
+                                            portSPINLOCK_TYPE * pxSpinlock ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
 /*
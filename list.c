@@ -42,6 +42,16 @@
  * generate the correct privileged Vs unprivileged linkage and placement. */
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+/*
+ * Insert an item into a list that has a priority index.  The item is placed
+ * after the last item that has the same or a lower item value.
+ */
+    static void prvInsertUsingPriorityIndex( List_t * const pxList,
+                                             ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+
 /*-----------------------------------------------------------
 * PUBLIC LIST API documented in list.h
 *----------------------------------------------------------*/
@@ -77,6 +87,12 @@ void vListInitialise( List_t * const pxList )
 
     pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    {
+        pxList->pxPriorityIndex = NULL;
+    }
+    #endif
+
     /* Write known values into the list if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
     listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -150,6 +166,23 @@ void vListInsert( List_t * const pxList,
     listTEST_LIST_INTEGRITY( pxList );
     listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
 
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    {
+        if( pxList->pxPriorityIndex != NULL )
+        {
+            prvInsertUsingPriorityIndex( pxList, pxNewListItem );
+
+            traceRETURN_vListInsert();
+
+            return;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_PRIORITY_EVENT_LISTS */
+
     /* Insert the new list item into the list, sorted in xItemValue order.
      *
      * If the list already contains a list item with the same item value then the
@@ -220,6 +253,8 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 
     traceENTER_uxListRemove( pxItemToRemove );
 
+    listPRIORITY_INDEX_REMOVE( pxList, pxItemToRemove );
+
     pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
     pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
 
@@ -244,3 +279,188 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
     return pxList->uxNumberOfItems;
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+    void vListInitialisePriorityIndex( List_t * const pxList,
+                                       ListPriorityIndex_t * const pxPriorityIndex )
+    {
+        UBaseType_t uxWord;
+
+        traceENTER_vListInitialisePriorityIndex( pxList, pxPriorityIndex );
+
+        pxPriorityIndex->ulGroups = 0U;
+
+        for( uxWord = ( UBaseType_t ) 0U; uxWord < ( UBaseType_t ) listPRIORITY_INDEX_WORDS; uxWord++ )
+        {
+            pxPriorityIndex->ulValues[ uxWord ] = 0U;
+        }
+
+        /* pxLastItem[ n ] is only read when the bit for n is set, so does not
+         * need to be initialised. */
+        pxList->pxPriorityIndex = pxPriorityIndex;
+
+        traceRETURN_vListInitialisePriorityIndex();
+    }
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+    static void prvInsertUsingPriorityIndex( List_t * const pxList,
+                                             ListItem_t * const pxNewListItem )
+    {
+        ListPriorityIndex_t * const pxPriorityIndex = pxList->pxPriorityIndex;
+        const UBaseType_t uxValue = ( UBaseType_t ) pxNewListItem->xItemValue;
+        UBaseType_t uxGroup = uxValue >> 5;
+        uint32_t ulBits;
+        uint32_t ulGroups;
+        ListItem_t * pxIterator;
+
+        /* Find the highest item value present in the list that is not greater
+         * than the value being inserted.  The new item goes after the last item
+         * with that value, or at the head of the list if there is no such
+         * item.  First look in the word that holds the bit for the value being
+         * inserted, masking off the bits for higher values. */
+        ulBits = pxPriorityIndex->ulValues[ uxGroup ] & ( ( ( uint32_t ) 0xFFFFFFFFU ) >> ( 31U - ( uxValue & 0x1FU ) ) );
+
+        if( ulBits == 0U )
+        {
+            /* Then look in the words for lower values. */
+            ulGroups = pxPriorityIndex->ulGroups & ( ( ( uint32_t ) 1U << uxGroup ) - 1U );
+
+            if( ulGroups != 0U )
+            {
+                uxGroup = listGET_MSB_POSITION( ulGroups );
+                ulBits = pxPriorityIndex->ulValues[ uxGroup ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulBits != 0U )
+        {
+            pxIterator = pxPriorityIndex->pxLastItem[ ( uxGroup << 5 ) + listGET_MSB_POSITION( ulBits ) ];
+        }
+        else
+        {
+            pxIterator = ( ListItem_t * ) &( pxList->xListEnd );
+        }
+
+        pxNewListItem->pxNext = pxIterator->pxNext;
+        pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+        pxNewListItem->pxPrevious = pxIterator;
+        pxIterator->pxNext = pxNewListItem;
+
+        /* Remember which list the item is in.  This allows fast removal of the
+         * item later. */
+        pxNewListItem->pxContainer = pxList;
+
+        ( pxList->uxNumberOfItems ) = ( UBaseType_t ) ( pxList->uxNumberOfItems + 1U );
+
+        /* The new item is now the last item with its value. */
+        pxPriorityIndex->pxLastItem[ uxValue ] = pxNewListItem;
+        pxPriorityIndex->ulValues[ uxValue >> 5 ] |= ( uint32_t ) 1U << ( uxValue & 0x1FU );
+        pxPriorityIndex->ulGroups |= ( uint32_t ) 1U << ( uxValue >> 5 );
+    }
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+    void vListPriorityIndexRemove( List_t * const pxList,
+                                   const ListItem_t * const pxItemToRemove )
+    {
+        ListPriorityIndex_t * const pxPriorityIndex = pxList->pxPriorityIndex;
+        const UBaseType_t uxValue = ( UBaseType_t ) pxItemToRemove->xItemValue;
+        ListItem_t * const pxPrevious = pxItemToRemove->pxPrevious;
+
+        traceENTER_vListPriorityIndexRemove( pxList, pxItemToRemove );
+
+        /* Only the last item with a given value is recorded in the index.  If
+         * that item is being removed then the item before it becomes the last
+         * item with the value, unless it has a different value, in which case
+         * no items with the value remain.  The list end marker has a value of
+         * portMAX_DELAY so never matches. */
+        if( pxPriorityIndex->pxLastItem[ uxValue ] == pxItemToRemove )
+        {
+            if( ( pxPrevious != ( ListItem_t * ) &( pxList->xListEnd ) ) &&
+                ( pxPrevious->xItemValue == pxItemToRemove->xItemValue ) )
+            {
+                pxPriorityIndex->pxLastItem[ uxValue ] = pxPrevious;
+            }
+            else
+            {
+                pxPriorityIndex->ulValues[ uxValue >> 5 ] &= ~( ( uint32_t ) 1U << ( uxValue & 0x1FU ) );
+
+                if( pxPriorityIndex->ulValues[ uxValue >> 5 ] == 0U )
+                {
+                    pxPriorityIndex->ulGroups &= ~( ( uint32_t ) 1U << ( uxValue >> 5 ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vListPriorityIndexRemove();
+    }
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+/*-----------------------------------------------------------*/
+
+#if ( ( ( configUSE_PRIORITY_EVENT_LISTS == 1 ) || ( configUSE_READY_PRIORITY_BITMAP == 1 ) ) && defined( listUSE_GENERIC_MSB_POSITION ) )
+
+    UBaseType_t uxListGetMSBPosition( uint32_t ulBits )
+    {
+        UBaseType_t uxPosition = 0U;
+
+        /* Binary search for the most significant set bit, so the number of
+         * steps is the same for every value. */
+        if( ( ulBits & 0xFFFF0000UL ) != 0U )
+        {
+            ulBits >>= 16;
+            uxPosition += 16U;
+        }
+
+        if( ( ulBits & 0x0000FF00UL ) != 0U )
+        {
+            ulBits >>= 8;
+            uxPosition += 8U;
+        }
+
+        if( ( ulBits & 0x000000F0UL ) != 0U )
+        {
+            ulBits >>= 4;
+            uxPosition += 4U;
+        }
+
+        if( ( ulBits & 0x0000000CUL ) != 0U )
+        {
+            ulBits >>= 2;
+            uxPosition += 2U;
+        }
+
+        if( ( ulBits & 0x00000002UL ) != 0U )
+        {
+            uxPosition += 1U;
+        }
+
+        return uxPosition;
+    }
+
+#endif /* ( ( ( configUSE_PRIORITY_EVENT_LISTS == 1 ) || ( configUSE_READY_PRIORITY_BITMAP == 1 ) ) && defined( listUSE_GENERIC_MSB_POSITION ) ) */
+/*-----------------------------------------------------------*/
@@ -40,6 +40,15 @@
 * The timer interrupt uses SIGALRM and care is taken to ensure that
 * the signal handler runs only on the thread for the current task.
 *
+* When configUSE_DYNAMIC_TICK is 1 the timer thread waits on a one shot
+* timerfd instead of sleeping for one tick period, and the kernel
+* reprograms the timerfd each time the next tick it must process
+* changes.  timerfd is only available on Linux.
+*
+* When configUSE_HIGH_RESOLUTION_TIMEOUTS is 1 a second timer thread waits
+* on a one shot timerfd programmed for the next high resolution deadline,
+* and interrupts the thread for the current task using SIGUSR2.
+*
 * Use of part of the standard C library requires care as some
 * functions can take pthread mutexes internally which can result in
 * deadlocks as the FreeRTOS kernel can switch tasks while they're
@@ -67,6 +76,11 @@
 #include <time.h>
 #include <unistd.h>
 
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/timerfd.h>
+#endif
+
 #ifdef __APPLE__
     #include <mach/mach_vm.h>
 #endif
@@ -78,7 +92,18 @@
 #include "utils/wait_for_event.h"
 /*-----------------------------------------------------------*/
 
-#define SIG_RESUME    SIGUSR1
+/* One shot timers are implemented using timerfd. */
+#define portUSING_TIMERFD    ( ( configUSE_DYNAMIC_TICK == 1 ) || ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) )
+
+#if ( portUSING_TIMERFD && !defined( __linux__ ) )
+    #error The Posix port implements configUSE_DYNAMIC_TICK and configUSE_HIGH_RESOLUTION_TIMEOUTS using timerfd, which is only available on Linux.
+#endif
+
+/* The length of a tick period in nanoseconds. */
+#define portTICK_PERIOD_NS    ( ( uint64_t ) portTICK_RATE_MICROSECONDS * ( uint64_t ) 1000U )
+
+#define SIG_RESUME                   SIGUSR1
+#define SIG_HIGH_RESOLUTION_TIMER    SIGUSR2
 
 typedef struct THREAD
 {
@@ -111,6 +136,18 @@ static BaseType_t xSchedulerEnd = pdFALSE;
 static pthread_t hTimerTickThread;
 static bool xTimerTickThreadShouldRun;
 static uint64_t prvStartTimeNs;
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    static int iTimerFd = -1;
+    static uint64_t ullTicksPassedToKernel;
+    static volatile bool xTickInterruptPending;
+#endif
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    static pthread_t hHighResolutionTimerThread;
+    static int iHighResolutionTimerFd = -1;
+    static volatile bool xHighResolutionInterruptPending;
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvSetupSignalsAndSchedulerPolicy( void );
@@ -121,6 +158,16 @@ static void prvSwitchThread( Thread_t * xThreadToResume,
 static void prvSuspendSelf( Thread_t * thread );
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
+#if ( portUSING_TIMERFD )
+    static int prvCreateTimerFd( void );
+    static bool prvWaitForTimerFd( int iFd,
+                                   volatile bool * pxInterruptPending );
+    static void prvSetTimerFd( int iFd,
+                               uint64_t ullTimeNs );
+#endif
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    static void vPortHighResolutionTimerHandler( int sig );
+#endif
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
 /*-----------------------------------------------------------*/
@@ -282,6 +329,17 @@ void vPortEndScheduler( void )
     xTimerTickThreadShouldRun = false;
     pthread_join( hTimerTickThread, NULL );
 
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+        ( void ) close( iTimerFd );
+        iTimerFd = -1;
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+        pthread_join( hHighResolutionTimerThread, NULL );
+        ( void ) close( iHighResolutionTimerFd );
+        iHighResolutionTimerFd = -1;
+    #endif
+
     /* Signal the scheduler to exit its loop. */
     xSchedulerEnd = pdTRUE;
     ( void ) pthread_kill( hMainThread, SIG_RESUME );
@@ -389,29 +447,208 @@ static void * prvTimerTickHandler( void * arg )
 
     while( xTimerTickThreadShouldRun )
     {
-        /*
-         * signal to the active task to cause tick handling or
-         * preemption (if enabled)
-         */
-        Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
-        pthread_kill( thread->pthread, SIGALRM );
-        usleep( portTICK_RATE_MICROSECONDS );
+        #if ( configUSE_DYNAMIC_TICK == 1 )
+            if( prvWaitForTimerFd( iTimerFd, &xTickInterruptPending ) )
+        #endif
+        {
+            /*
+             * signal to the active task to cause tick handling or
+             * preemption (if enabled)
+             */
+            Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+            pthread_kill( thread->pthread, SIGALRM );
+        }
+
+        #if ( configUSE_DYNAMIC_TICK == 0 )
+            usleep( portTICK_RATE_MICROSECONDS );
+        #endif
     }
 
     return NULL;
 }
 /*-----------------------------------------------------------*/
 
+#if ( portUSING_TIMERFD )
+
+    static int prvCreateTimerFd( void )
+    {
+        int iFd;
+
+        iFd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+
+        if( iFd == -1 )
+        {
+            prvFatalError( "timerfd_create", errno );
+        }
+
+        return iFd;
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * Wait for the one shot timer iFd to expire, returning true if the interrupt
+ * handler needs to run.  Returns false after a while if the timer has not
+ * expired so the timer thread can check whether the scheduler has been ended.
+ */
+    static bool prvWaitForTimerFd( int iFd,
+                                   volatile bool * pxInterruptPending )
+    {
+        struct pollfd xPollFd;
+        uint64_t ullExpirations;
+        int iTimeoutMs = 100;
+
+        xPollFd.fd = iFd;
+        xPollFd.events = POLLIN;
+        xPollFd.revents = 0;
+
+        /* Unlike a periodic tick, a one shot timer does not expire again if
+         * the signal is held pending by a thread that has just been switched
+         * out, so keep signalling the active task each tick period until the
+         * interrupt handler has run. */
+        if( *pxInterruptPending )
+        {
+            iTimeoutMs = ( portTICK_PERIOD_MS > 0U ) ? ( int ) portTICK_PERIOD_MS : 1;
+        }
+
+        /* The timer may be reprogrammed while this thread is waiting, in which
+         * case the read fails with EAGAIN. */
+        if( ( poll( &xPollFd, 1, iTimeoutMs ) > 0 ) &&
+            ( read( iFd, &ullExpirations, sizeof( ullExpirations ) ) == ( ssize_t ) sizeof( ullExpirations ) ) )
+        {
+            *pxInterruptPending = true;
+        }
+
+        return *pxInterruptPending;
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * Program the one shot timer iFd to expire at the CLOCK_MONOTONIC time
+ * ullTimeNs, or immediately if that time has already passed.
+ */
+    static void prvSetTimerFd( int iFd,
+                               uint64_t ullTimeNs )
+    {
+        struct itimerspec xTimerSpec;
+
+        memset( &xTimerSpec, 0, sizeof( xTimerSpec ) );
+        xTimerSpec.it_value.tv_sec = ( time_t ) ( ullTimeNs / ( uint64_t ) 1000000000UL );
+        xTimerSpec.it_value.tv_nsec = ( long ) ( ullTimeNs % ( uint64_t ) 1000000000UL );
+
+        if( timerfd_settime( iFd, TFD_TIMER_ABSTIME, &xTimerSpec, NULL ) == -1 )
+        {
+            prvFatalError( "timerfd_settime", errno );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* portUSING_TIMERFD */
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/*
+ * Called by the kernel, with signals blocked, each time the next tick it must
+ * process changes.
+ */
+    void vPortSetNextTickInterrupt( TickType_t xTicksToNextTick )
+    {
+        prvSetTimerFd( iTimerFd, prvStartTimeNs + ( ( ullTicksPassedToKernel + ( uint64_t ) xTicksToNextTick ) * portTICK_PERIOD_NS ) );
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by the kernel to find how many tick periods have elapsed that the
+ * tick handler has not yet passed to the kernel.
+ */
+    TickType_t xPortGetUnprocessedTicks( void )
+    {
+        uint64_t ullTicksElapsed;
+
+        ullTicksElapsed = ( prvGetTimeNs() - prvStartTimeNs ) / portTICK_PERIOD_NS;
+
+        return ( TickType_t ) ( ullTicksElapsed - ullTicksPassedToKernel );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_DYNAMIC_TICK */
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    uint64_t ullPortGetTimeNs( void )
+    {
+        return prvGetTimeNs();
+    }
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by the kernel, with signals blocked, each time the next high
+ * resolution deadline changes.
+ */
+    void vPortSetHighResolutionTimer( uint64_t ullDeadlineNs )
+    {
+        prvSetTimerFd( iHighResolutionTimerFd, ullDeadlineNs );
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvHighResolutionTimerThread( void * arg )
+    {
+        ( void ) arg;
+
+        prvPortSetCurrentThreadName( "High res timer" );
+
+        while( xTimerTickThreadShouldRun )
+        {
+            if( prvWaitForTimerFd( iHighResolutionTimerFd, &xHighResolutionInterruptPending ) )
+            {
+                Thread_t * thread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+                pthread_kill( thread->pthread, SIG_HIGH_RESOLUTION_TIMER );
+            }
+        }
+
+        return NULL;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMEOUTS */
+
 /*
  * Setup the systick timer to generate the tick interrupts at the required
  * frequency.
  */
 void prvSetupTimerInterrupt( void )
 {
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        /* The timer must exist before the timer thread waits on it. */
+        iTimerFd = prvCreateTimerFd();
+        ullTicksPassedToKernel = 0;
+        xTickInterruptPending = false;
+    }
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    {
+        /* The timer is not programmed until a task blocks with a deadline. */
+        iHighResolutionTimerFd = prvCreateTimerFd();
+        xHighResolutionInterruptPending = false;
+    }
+    #endif
+
     xTimerTickThreadShouldRun = true;
     pthread_create( &hTimerTickThread, NULL, prvTimerTickHandler, NULL );
 
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+        pthread_create( &hHighResolutionTimerThread, NULL, prvHighResolutionTimerThread, NULL );
+    #endif
+
     prvStartTimeNs = prvGetTimeNs();
+
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        /* The first tick interrupt occurs after one tick period. */
+        vPortSetNextTickInterrupt( ( TickType_t ) 1 );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -433,16 +670,34 @@ static void vPortSystemTickHandler( int sig )
     /* Tick Increment, accounting for any lost signals or drift in
      * the timer. */
 
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        /* Pass all the tick periods that have elapsed since the last
+         * interrupt to the kernel, which then programs the next interrupt. */
+        uint64_t ullTicksElapsed;
+        TickType_t xTicksToCatchUp;
+
+        xTickInterruptPending = false;
+
+        ullTicksElapsed = ( prvGetTimeNs() - prvStartTimeNs ) / portTICK_PERIOD_NS;
+        xTicksToCatchUp = ( TickType_t ) ( ullTicksElapsed - ullTicksPassedToKernel );
+        ullTicksPassedToKernel = ullTicksElapsed;
+
+        ( void ) xTaskCatchUpTicksFromISR( xTicksToCatchUp );
+    }
+    #else /* configUSE_DYNAMIC_TICK */
+
 /*
  *      Comment code to adjust timing according to full demo requirements
  *      xExpectedTicks = (prvGetTimeNs() - prvStartTimeNs)
  *        / (portTICK_RATE_MICROSECONDS * 1000);
  * do { */
-    xTaskIncrementTick();
+        xTaskIncrementTick();
 
 /*        prvTickCount++;
  *    } while (prvTickCount < xExpectedTicks);
  */
+    #endif /* configUSE_DYNAMIC_TICK */
 
     #if ( configUSE_PREEMPTION == 1 )
         /* Select Next Task. */
@@ -457,6 +712,36 @@ static void vPortSystemTickHandler( int sig )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    static void vPortHighResolutionTimerHandler( int sig )
+    {
+        Thread_t * pxThreadToSuspend;
+        Thread_t * pxThreadToResume;
+
+        ( void ) sig;
+
+        uxCriticalNesting++; /* Signals are blocked in this signal handler. */
+
+        xHighResolutionInterruptPending = false;
+
+        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        if( xTaskCheckDeadlinesFromISR() != pdFALSE )
+        {
+            vTaskSwitchContext();
+
+            pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+            prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+        }
+
+        uxCriticalNesting--;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMEOUTS */
+
 void vPortThreadDying( void * pxTaskToDelete,
                        volatile BaseType_t * pxPendYield )
 {
@@ -604,6 +889,19 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    {
+        sigtick.sa_handler = vPortHighResolutionTimerHandler;
+
+        iRet = sigaction( SIG_HIGH_RESOLUTION_TIMER, &sigtick, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
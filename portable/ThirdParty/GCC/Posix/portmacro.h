@@ -99,6 +99,24 @@ extern void vPortYield( void );
 #define portYIELD_FROM_ISR( x )    portEND_SWITCHING_ISR( x )
 /*-----------------------------------------------------------*/
 
+/* Dynamic tick support, see configUSE_DYNAMIC_TICK.  The functions are only
+ * defined by port.c when configUSE_DYNAMIC_TICK is 1, but the macros are
+ * always provided as this header is included before FreeRTOSConfig.h. */
+extern void vPortSetNextTickInterrupt( TickType_t xTicksToNextTick );
+extern TickType_t xPortGetUnprocessedTicks( void );
+#define portSET_NEXT_TICK_INTERRUPT( xTicksToNextTick )    vPortSetNextTickInterrupt( xTicksToNextTick )
+#define portGET_UNPROCESSED_TICKS()                        xPortGetUnprocessedTicks()
+/*-----------------------------------------------------------*/
+
+/* High resolution time out support, see configUSE_HIGH_RESOLUTION_TIMEOUTS.
+ * As above, the macros are always provided and the functions are only
+ * defined when the option is enabled. */
+extern uint64_t ullPortGetTimeNs( void );
+extern void vPortSetHighResolutionTimer( uint64_t ullDeadlineNs );
+#define portGET_HIGH_RESOLUTION_TIME_NS()                 ullPortGetTimeNs()
+#define portSET_HIGH_RESOLUTION_TIMER( ullDeadlineNs )    vPortSetHighResolutionTimer( ullDeadlineNs )
+/*-----------------------------------------------------------*/
+
 /* Critical section management. */
 extern void vPortDisableInterrupts( void );
 extern void vPortEnableInterrupts( void );
@@ -140,6 +158,8 @@ extern void vPortCancelThread( void * pxTaskToDelete );
  */
 #define portMEMORY_BARRIER()                        __asm volatile ( "" ::: "memory" )
 
+#define portFORCE_INLINE                            inline __attribute__( ( always_inline ) )
+
 extern uint32_t ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetRunTime()
@@ -104,6 +104,26 @@ typedef unsigned char    UBaseType_t;
 extern void vPortYield( void );
 #define portYIELD()                                           vPortYield()
 
+/* Program the tick timer to interrupt xTicksToNextTick tick periods after the
+ * last tick passed to xTaskCatchUpTicksFromISR(), and return the number of tick
+ * periods that have elapsed since then.  Only used when configUSE_DYNAMIC_TICK
+ * is set to 1. */
+#define portSET_NEXT_TICK_INTERRUPT( xTicksToNextTick )       do { ( void ) ( xTicksToNextTick ); } while( 0 )
+#define portGET_UNPROCESSED_TICKS()                           ( ( TickType_t ) 0 )
+
+/* Return the value of a free running nanosecond counter, and program a one shot
+ * timer to interrupt when the counter reaches ullDeadlineNs.  The timer
+ * interrupt calls xTaskCheckDeadlinesFromISR().  Only used when
+ * configUSE_HIGH_RESOLUTION_TIMEOUTS is set to 1. */
+#define portGET_HIGH_RESOLUTION_TIME_NS()                     ( ( uint64_t ) 0U )
+#define portSET_HIGH_RESOLUTION_TIMER( ullDeadlineNs )        do { ( void ) ( ullDeadlineNs ); } while( 0 )
+
+/* Used by atomic.h to force its functions to be inlined, so the functions a
+ * file does not use are not reported as unused. */
+#if defined( __GNUC__ )
+    #define portFORCE_INLINE                                  inline __attribute__( ( always_inline ) )
+#endif
+
 /* Task function macros as described on the FreeRTOS.org WEB site. */
 #define portTASK_FUNCTION_PROTO( vFunction, pvParameters )    void vFunction( void * pvParameters )
 #define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
@@ -137,6 +157,20 @@ extern void vPortYield( void );
  * it should be released as many times as it is locked. */
     #define portRELEASE_ISR_LOCK()           do {} while( 0 )
 
+/* The type of the spinlock embedded in each kernel object when
+ * configUSE_GRANULAR_LOCKS is set to 1. */
+    #define portSPINLOCK_TYPE                volatile uint32_t
+
+/* Initialise the spinlock pointed to by pxSpinlock to the unlocked state. */
+    #define portINIT_SPINLOCK( pxSpinlock )       do { *( pxSpinlock ) = 0U; } while( 0 )
+
+/* Acquire the spinlock pointed to by pxSpinlock. Like the TASK and ISR locks
+ * this is a recursive lock. */
+    #define portGET_SPINLOCK( pxSpinlock )        do { ( void ) ( pxSpinlock ); } while( 0 )
+
+/* Release the spinlock pointed to by pxSpinlock. */
+    #define portRELEASE_SPINLOCK( pxSpinlock )    do { ( void ) ( pxSpinlock ); } while( 0 )
+
 #endif /* if ( configNUMBER_OF_CORES > 1 ) */
 
 #endif /* PORTMACRO_H */
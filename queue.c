@@ -42,6 +42,10 @@
     #include "croutine.h"
 #endif
 
+#if ( ( configUSE_MPMC_QUEUES == 1 ) || ( configUSE_MUTEX_FAST_PATH == 1 ) )
+    #include "atomic.h"
+#endif
+
 /* The MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
  * correct privileged Vs unprivileged linkage and placement. */
@@ -53,6 +57,13 @@
 #define queueLOCKED_UNMODIFIED    ( ( int8_t ) 0 )
 #define queueINT8_MAX             ( ( int8_t ) 127 )
 
+#if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+
+/* The length of a queue set.  The set has no storage area, so its length only
+ * bounds the number of events it can hold at once. */
+    #define queueSET_READY_LIST_LENGTH    ( ( UBaseType_t ) ~( ( UBaseType_t ) 0U ) )
+#endif
+
 /* When the Queue_t structure is used to represent a base queue its pcHead and
  * pcTail members are used as pointers into the queue storage area.  When the
  * Queue_t structure is used to represent a mutex pcHead and pcTail pointers are
@@ -95,6 +106,60 @@ typedef struct SemaphoreData
     #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 #endif
 
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+/* Queues, semaphores and queue sets are protected by their own spinlock so
+ * operations on different objects can proceed in parallel on different cores.
+ * Mutexes continue to use the kernel critical section as taking and giving a
+ * mutex can change the priority of the mutex holder, which is also why a mutex
+ * cannot be a member of a queue set. */
+    #define queueENTER_CRITICAL( pxQueue )                                \
+    do {                                                                  \
+        if( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )             \
+        {                                                                 \
+            taskENTER_CRITICAL();                                         \
+        }                                                                 \
+        else                                                              \
+        {                                                                 \
+            taskDATA_GROUP_ENTER_CRITICAL( &( ( pxQueue )->xSpinlock ) ); \
+        }                                                                 \
+    } while( 0 )
+
+    #define queueEXIT_CRITICAL( pxQueue )                                \
+    do {                                                                 \
+        if( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )            \
+        {                                                                \
+            taskEXIT_CRITICAL();                                         \
+        }                                                                \
+        else                                                             \
+        {                                                                \
+            taskDATA_GROUP_EXIT_CRITICAL( &( ( pxQueue )->xSpinlock ) ); \
+        }                                                                \
+    } while( 0 )
+
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue )                  \
+    ( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) ?          \
+      ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR() :                \
+      taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( &( ( pxQueue )->xSpinlock ) ) )
+
+    #define queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue )                                \
+    do {                                                                                                  \
+        if( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )                                             \
+        {                                                                                                 \
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                                         \
+        }                                                                                                 \
+        else                                                                                              \
+        {                                                                                                 \
+            taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, &( ( pxQueue )->xSpinlock ) ); \
+        }                                                                                                 \
+    } while( 0 )
+#else /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+    #define queueENTER_CRITICAL( pxQueue )                                    taskENTER_CRITICAL()
+    #define queueEXIT_CRITICAL( pxQueue )                                     taskEXIT_CRITICAL()
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue )                           taskENTER_CRITICAL_FROM_ISR()
+    #define queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue )    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -129,16 +194,158 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         struct QueueDefinition * pxQueueSetContainer;
     #endif
 
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+        void * volatile pvMutexOwner; /**< When the structure is used as a mutex, the task that took the mutex without entering the kernel, NULL if the mutex is free, or queueMUTEX_OWNER_KERNEL when the kernel manages the mutex.  NULL if the structure is not a mutex. */
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxCeilingPriority; /**< When the structure is used as a mutex, the priority its holder runs at while holding it, or queueMUTEX_HAS_NO_CEILING if the mutex uses priority inheritance. */
+    #endif
+
+    #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+        struct QueueDefinition * pxNextReadyMember;  /**< Links a member of a queue set into the set's ready list. */
+        UBaseType_t uxSetEventsPending;              /**< The number of events a member of a queue set has posted to the set that have not yet been selected. */
+        struct QueueDefinition * pxFirstReadyMember; /**< When the structure is used as a queue set, the first member in the set's ready list. */
+        struct QueueDefinition * pxLastReadyMember;  /**< When the structure is used as a queue set, the last member in the set's ready list. */
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xSpinlock; /**< Protects the members of this structure when it is not used as a mutex. */
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucZeroCopyState; /**< Records whether a task holds a slot reserved by xQueueReserve() or an item acquired by xQueueAcquire(). */
+    #endif
+
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        ListPriorityIndex_t xTasksWaitingToSendIndex;    /**< Allows tasks to be inserted into xTasksWaitingToSend in constant time. */
+        ListPriorityIndex_t xTasksWaitingToReceiveIndex; /**< Allows tasks to be inserted into xTasksWaitingToReceive in constant time. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
  * name below to enable the use of older kernel aware debuggers. */
 typedef xQUEUE Queue_t;
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/* Bits used in ucZeroCopyState. */
+    #define queueSLOT_RESERVED    ( ( uint8_t ) 0x01U )
+    #define queueITEM_ACQUIRED    ( ( uint8_t ) 0x02U )
+
+/* A reserved slot is the one pcWriteTo points to, so no other item can be
+ * written to the queue until the slot is committed.  An acquired item is the
+ * next one to be read, so no other item can be read until the item is
+ * released. */
+    #define queueCAN_WRITE( pxQueue )    ( ( ( ( pxQueue )->ucZeroCopyState & queueSLOT_RESERVED ) == 0U ) ? pdTRUE : pdFALSE )
+    #define queueCAN_READ( pxQueue )     ( ( ( ( pxQueue )->ucZeroCopyState & queueITEM_ACQUIRED ) == 0U ) ? pdTRUE : pdFALSE )
+#else
+    #define queueCAN_WRITE( pxQueue )    pdTRUE
+    #define queueCAN_READ( pxQueue )     pdTRUE
+#endif
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+/* A mutex that has a ceiling raises its holder to the ceiling priority when
+ * it is taken, so the priority of the holder is never raised by a task that
+ * attempts to take the mutex while it is held.  Raising a task to the idle
+ * priority has no effect, so a ceiling of tskIDLE_PRIORITY marks a mutex that
+ * uses priority inheritance instead. */
+    #define queueMUTEX_HAS_NO_CEILING                ( ( UBaseType_t ) tskIDLE_PRIORITY )
+    #define queueMUTEX_USES_INHERITANCE( pxQueue )    ( ( ( pxQueue )->uxCeilingPriority == queueMUTEX_HAS_NO_CEILING ) ? pdTRUE : pdFALSE )
+#else
+    #define queueMUTEX_USES_INHERITANCE( pxQueue )    pdTRUE
+#endif
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+/* A free mutex is taken by swapping its pvMutexOwner member from NULL to the
+ * handle of the calling task, and given back by swapping it back again, so an
+ * uncontended mutex is used without entering the kernel.  While a mutex is
+ * held that way its semaphore count still records it as available.  A task
+ * that finds the mutex held by another task sets pvMutexOwner to
+ * queueMUTEX_OWNER_KERNEL and records the holder in the semaphore count and
+ * xMutexHolder, after which the mutex is taken and given through the kernel,
+ * with priority inheritance, until it is given back with no tasks waiting for
+ * it.  The address of the mutex itself cannot be the handle of a task. */
+    #define queueMUTEX_OWNER_KERNEL( pxQueue )    ( ( void * ) ( pxQueue ) )
+    #define queueMUTEX_IS_HELD_WITHOUT_KERNEL( pxQueue ) \
+    ( ( ( ( pxQueue )->pvMutexOwner != NULL ) && ( ( pxQueue )->pvMutexOwner != queueMUTEX_OWNER_KERNEL( pxQueue ) ) ) ? pdTRUE : pdFALSE )
+    #define queueGET_MUTEX_HOLDER( pxQueue ) \
+    ( ( queueMUTEX_IS_HELD_WITHOUT_KERNEL( pxQueue ) != pdFALSE ) ? ( TaskHandle_t ) ( pxQueue )->pvMutexOwner : ( pxQueue )->u.xSemaphore.xMutexHolder )
+
+/* Members of queue sets must notify their set when they are given, and mutexes
+ * that have a priority ceiling must raise their holder when they are taken,
+ * so neither can bypass the kernel. */
+    #if ( configUSE_QUEUE_SETS == 1 )
+        #define queueMUTEX_CAN_BYPASS_KERNEL( pxQueue ) \
+    ( ( ( ( pxQueue )->pxQueueSetContainer == NULL ) && ( queueMUTEX_USES_INHERITANCE( pxQueue ) != pdFALSE ) ) ? pdTRUE : pdFALSE )
+    #else
+        #define queueMUTEX_CAN_BYPASS_KERNEL( pxQueue )    queueMUTEX_USES_INHERITANCE( pxQueue )
+    #endif
+#else
+    #define queueGET_MUTEX_HOLDER( pxQueue )    ( ( pxQueue )->u.xSemaphore.xMutexHolder )
+#endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+/* A reader-writer lock is a mutex whose semaphore count is the number of
+ * tasks and interrupts that hold it for reading, and whose holder is the task
+ * that holds it for writing.  Tasks waiting to write are held in
+ * xTasksWaitingToReceive, and tasks waiting to read in xTasksWaitingToSend.
+ * Writers are preferred, so the lock cannot be taken for reading while a task
+ * is blocked waiting to write.  The waiting writers are counted from their
+ * list, so a writer that is deleted while it waits no longer holds back
+ * readers. */
+    #define queueRW_LOCK_CAN_BE_TAKEN( pxQueue, xWrite )                                         \
+    ( ( ( ( pxQueue )->u.xSemaphore.xMutexHolder == NULL ) &&                                    \
+        ( ( ( xWrite ) != pdFALSE ) ?                                                            \
+          ( ( pxQueue )->uxMessagesWaiting == ( UBaseType_t ) 0 ) :                              \
+          ( listLIST_IS_EMPTY( &( ( pxQueue )->xTasksWaitingToReceive ) ) != pdFALSE ) ) ) ? pdTRUE : pdFALSE )
+
+/* A reader-writer lock has no storage area, so it is told apart from a mutex,
+ * whose pcWriteTo is left pointing at the mutex itself when it is reset, by
+ * setting its pcWriteTo to NULL. */
+    #define queueIS_RW_LOCK( pxQueue ) \
+    ( ( ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX ) && ( ( pxQueue )->pcWriteTo == NULL ) ) ? pdTRUE : pdFALSE )
+#endif
+
+#if ( configUSE_MPMC_QUEUES == 1 )
+
+/*
+ * Definition of the lock-free multi-producer multi-consumer queue.  Each slot
+ * in the storage area has a sequence number that records whether the slot is
+ * free for the producer that next claims it, or holds an item for the
+ * consumer that next claims it.  Producers and consumers claim slots by
+ * advancing ulEnqueuePosition and ulDequeuePosition with a compare-and-swap,
+ * so the kernel is only entered when a task must block because the queue is
+ * full or empty, or when a task is known to be blocked on the queue.
+ */
+    typedef struct MpmcQueueDefinition
+    {
+        volatile uint32_t ulEnqueuePosition;     /**< The position of the next slot to be claimed by a producer. */
+        volatile uint32_t ulDequeuePosition;     /**< The position of the next slot to be claimed by a consumer. */
+        volatile uint32_t * pulSequence;         /**< Points to the array holding the sequence number of each slot. */
+        uint8_t * pucStorage;                    /**< Points to the beginning of the item storage area. */
+        UBaseType_t uxLength;                    /**< The number of items the queue can hold.  Always a power of two. */
+        UBaseType_t uxItemSize;                  /**< The size of each item the queue holds. */
+
+        List_t xTasksWaitingToSend;              /**< List of tasks that are blocked waiting for space in the queue.  Stored in priority order. */
+        List_t xTasksWaitingToReceive;           /**< List of tasks that are blocked waiting for an item in the queue.  Stored in priority order. */
+        volatile UBaseType_t uxSendersWaiting;   /**< The number of tasks that are, or are about to be, blocked waiting for space. */
+        volatile UBaseType_t uxReceiversWaiting; /**< The number of tasks that are, or are about to be, blocked waiting for an item. */
+
+        #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+            uint8_t ucStaticallyAllocated; /**< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
+        #endif
+    } MpmcQueue_t;
+#endif /* configUSE_MPMC_QUEUES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -182,19 +389,33 @@ typedef xQUEUE Queue_t;
  */
 static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Enters the queue's critical section once the queue is not locked.  With
+ * configUSE_GRANULAR_LOCKS set to 1 a task running on another core can hold a
+ * queue locked while it places itself on the queue's event lists, so a task
+ * must wait for the queue to be unlocked before it can access those lists.
+ * Without granular locks a queue is never locked while another task is running
+ * outside of a suspended scheduler, so this is just a critical section.
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    static void prvEnterCriticalWhenUnlocked( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#else
+    #define prvEnterCriticalWhenUnlocked( pxQueue )    queueENTER_CRITICAL( pxQueue )
+#endif
+
 /*
  * Uses a critical section to determine if there is any data in a queue.
  *
  * @return pdTRUE if the queue contains no items, otherwise pdFALSE.
  */
-static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueEmpty( Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
  * Uses a critical section to determine if there is any space in a queue.
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueFull( Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -210,13 +431,160 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+/*
+ * Copies uxItemCount items to the back of a queue, or out of the front of a
+ * queue, using at most two calls to memcpy() as the items wrap around the end
+ * of the queue storage area.  Called from a critical section with enough
+ * space or items in the queue for the whole copy.
+ */
+    static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                     const uint8_t * pucItems,
+                                     const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+    static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                       uint8_t * pucBuffer,
+                                       const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to uxItemCount tasks waiting to receive from, or send to, the
+ * queue after that many items were added to, or removed from, the queue.  If
+ * the queue is a member of a queue set, the queue set is instead notified once
+ * for each item added.
+ *
+ * @return pdTRUE if a task with a priority higher than the calling task was
+ * unblocked, otherwise pdFALSE.
+ */
+    static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue,
+                                           const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvUnblockSenders( Queue_t * const pxQueue,
+                                         const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MPMC_QUEUES == 1 )
+
+/*
+ * Called after an MpmcQueue_t structure has been allocated either statically
+ * or dynamically to fill in the structure's members.
+ */
+    static void prvInitialiseNewMpmcQueue( const UBaseType_t uxQueueLength,
+                                           const UBaseType_t uxItemSize,
+                                           uint8_t * pucQueueStorage,
+                                           MpmcQueue_t * pxNewQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Attempt to claim a slot and copy an item into, or out of, an MPMC queue
+ * without entering a critical section.
+ *
+ * @return pdPASS if an item was copied, or pdFAIL if the queue was full or
+ * empty respectively.
+ */
+    static BaseType_t prvMpmcQueueTryEnqueue( MpmcQueue_t * const pxQueue,
+                                              const void * const pvItemToQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvMpmcQueueTryDequeue( MpmcQueue_t * const pxQueue,
+                                              void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Block the calling task on the event list for as long as the queue remains
+ * full (xWaitingToSend is pdTRUE) or empty (xWaitingToSend is pdFALSE), or
+ * until xTicksToWait expires.
+ */
+    static void prvMpmcQueueWait( MpmcQueue_t * const pxQueue,
+                                  const BaseType_t xWaitingToSend,
+                                  const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the highest priority task waiting on pxEventList, if the waiting
+ * count indicates such a task may exist.
+ */
+    static void prvMpmcQueueUnblockWaiter( List_t * const pxEventList,
+                                           const volatile UBaseType_t * const puxWaiting ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
  * Checks to see if a queue is a member of a queue set, and if so, notifies
  * the queue set that the queue contains data.
  */
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+/*
+ * Attempts to take the mutex pxQueue without entering the kernel.
+ *
+ * @return pdTRUE if the mutex was taken, otherwise pdFALSE.
+ */
+    static BaseType_t prvMutexTakeWithoutKernel( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Attempts to give back the mutex pxQueue without entering the kernel.
+ *
+ * @return pdTRUE if the mutex was given, otherwise pdFALSE.
+ */
+    static BaseType_t prvMutexGiveWithoutKernel( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Hands the mutex pxQueue to the kernel, recording any task that holds the
+ * mutex without the kernel's knowledge as the mutex holder.  Must be called
+ * from the mutex's critical section.
+ */
+    static void prvMutexEnterKernel( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+/*
+ * Configures a newly created queue to be used as a reader-writer lock.
+ */
+    static void prvInitialiseRwLock( Queue_t * pxNewQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks every task waiting to take the reader-writer lock pxQueue for
+ * reading.  Must be called from a critical section.
+ *
+ * @return pdTRUE if a task that has a priority higher than the calling task
+ * was unblocked, otherwise pdFALSE.
+ */
+    static BaseType_t prvUnblockRwLockReaders( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from a critical section when a task that was waiting to take the
+ * reader-writer lock pxQueue for writing stops waiting without taking it.
+ * Returns as prvUnblockRwLockReaders().
+ */
+    static BaseType_t prvRemoveRwLockWaitingWriter( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the priority of the highest priority task waiting to take the
+ * reader-writer lock pxQueue for either reading or writing.
+ */
+    static UBaseType_t prvGetRwLockDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+
+/*
+ * Records one event on pxQueue in the ready list of the queue set pxQueueSet,
+ * appending pxQueue to the list if it is not already in it.
+ */
+    static void prvAddToReadyList( Queue_t * const pxQueueSet,
+                                   Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes one event from the ready list of the queue set pxQueueSet and writes
+ * the handle of the member that posted it to pvBuffer.
+ */
+    static void prvTakeFromReadyList( Queue_t * const pxQueueSet,
+                                      void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes pxQueue, along with any events it posted that were never selected,
+ * from the ready list of the queue set that contains it.
+ */
+    static void prvRemoveFromReadyList( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -256,7 +624,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  * accessing the queue event lists.
  */
 #define prvLockQueue( pxQueue )                            \
-    taskENTER_CRITICAL();                                  \
+    queueENTER_CRITICAL( pxQueue );                        \
     {                                                      \
         if( ( pxQueue )->cRxLock == queueUNLOCKED )        \
         {                                                  \
@@ -267,7 +635,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             ( pxQueue )->cTxLock = queueLOCKED_UNMODIFIED; \
         }                                                  \
     }                                                      \
-    taskEXIT_CRITICAL()
+    queueEXIT_CRITICAL( pxQueue )
 
 /*
  * Macro to increment cTxLock member of the queue data structure. It is
@@ -315,7 +683,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
         /* Check for multiplication overflow. */
         ( ( SIZE_MAX / pxQueue->uxLength ) >= pxQueue->uxItemSize ) )
     {
-        taskENTER_CRITICAL();
+        prvEnterCriticalWhenUnlocked( pxQueue );
         {
             pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize );
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
@@ -324,6 +692,38 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->ucZeroCopyState = 0U;
+            }
+            #endif
+
+            #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+            {
+                if( xNewQueue == pdFALSE )
+                {
+                    /* If the queue is a queue set then discard the events held
+                     * in its ready list. */
+                    while( pxQueue->pxFirstReadyMember != NULL )
+                    {
+                        Queue_t * const pxMember = pxQueue->pxFirstReadyMember;
+
+                        pxQueue->pxFirstReadyMember = pxMember->pxNextReadyMember;
+                        pxMember->pxNextReadyMember = NULL;
+                        pxMember->uxSetEventsPending = ( UBaseType_t ) 0U;
+                    }
+                }
+                else
+                {
+                    pxQueue->pxNextReadyMember = NULL;
+                    pxQueue->uxSetEventsPending = ( UBaseType_t ) 0U;
+                    pxQueue->pxFirstReadyMember = NULL;
+                }
+
+                pxQueue->pxLastReadyMember = NULL;
+            }
+            #endif /* configUSE_QUEUE_SET_READY_LIST */
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -352,9 +752,16 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                 /* Ensure the event queues start in the correct state. */
                 vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
                 vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+
+                #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+                {
+                    vListInitialisePriorityIndex( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->xTasksWaitingToSendIndex ) );
+                    vListInitialisePriorityIndex( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->xTasksWaitingToReceiveIndex ) );
+                }
+                #endif
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
     }
     else
     {
@@ -591,6 +998,18 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
      * defined. */
     pxNewQueue->uxLength = uxQueueLength;
     pxNewQueue->uxItemSize = uxItemSize;
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        /* The queue is reset from within its own critical section, so the
+         * spinlock must be initialised, and the queue marked as unlocked,
+         * first. */
+        portINIT_SPINLOCK( &( pxNewQueue->xSpinlock ) );
+        pxNewQueue->cRxLock = queueUNLOCKED;
+        pxNewQueue->cTxLock = queueUNLOCKED;
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
     ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -605,6 +1024,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        pxNewQueue->pvMutexOwner = NULL;
+    }
+    #endif
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -625,6 +1050,20 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+            {
+                pxNewQueue->uxCeilingPriority = queueMUTEX_HAS_NO_CEILING;
+            }
+            #endif
+
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+            {
+                /* The mutex is given through the kernel below, which leaves
+                 * it free. */
+                pxNewQueue->pvMutexOwner = queueMUTEX_OWNER_KERNEL( pxNewQueue );
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -684,6 +1123,91 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                                UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        traceENTER_xQueueCreateMutexWithCeiling( ucQueueType, uxCeilingPriority );
+
+        configASSERT( uxCeilingPriority < configMAX_PRIORITIES );
+
+        /* Ensure the ceiling is not so large that it causes a ready list
+         * array out of bounds error. */
+        if( uxCeilingPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxCeilingPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xNewQueue = xQueueCreateMutex( ucQueueType );
+
+        if( xNewQueue != NULL )
+        {
+            /* The mutex is not held yet, so the ceiling can be set after it
+             * has been created. */
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateMutexWithCeiling( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                      UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        traceENTER_xQueueCreateMutexWithCeilingStatic( ucQueueType, uxCeilingPriority, pxStaticQueue );
+
+        configASSERT( uxCeilingPriority < configMAX_PRIORITIES );
+
+        /* Ensure the ceiling is not so large that it causes a ready list
+         * array out of bounds error. */
+        if( uxCeilingPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxCeilingPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xNewQueue = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateMutexWithCeilingStatic( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -700,18 +1224,18 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
          * calling task is the mutex holder, but not a good way of determining the
          * identity of the mutex holder, as the holder may change between the
          * following critical section exiting and the function returning. */
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxSemaphore );
         {
             if( pxSemaphore->uxQueueType == queueQUEUE_IS_MUTEX )
             {
-                pxReturn = pxSemaphore->u.xSemaphore.xMutexHolder;
+                pxReturn = queueGET_MUTEX_HOLDER( pxSemaphore );
             }
             else
             {
                 pxReturn = NULL;
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxSemaphore );
 
         traceRETURN_xQueueGetMutexHolder( pxReturn );
 
@@ -736,7 +1260,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
          * not required here. */
         if( ( ( Queue_t * ) xSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
         {
-            pxReturn = ( ( Queue_t * ) xSemaphore )->u.xSemaphore.xMutexHolder;
+            pxReturn = queueGET_MUTEX_HOLDER( ( Queue_t * ) xSemaphore );
         }
         else
         {
@@ -768,7 +1292,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
          * this is the only condition we are interested in it does not matter if
          * pxMutexHolder is accessed simultaneously by another task.  Therefore no
          * mutual exclusion is required to test the pxMutexHolder variable. */
-        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+        if( queueGET_MUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
         {
             traceGIVE_MUTEX_RECURSIVE( pxMutex );
 
@@ -827,7 +1351,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 
         traceTAKE_MUTEX_RECURSIVE( pxMutex );
 
-        if( pxMutex->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+        if( queueGET_MUTEX_HOLDER( pxMutex ) == xTaskGetCurrentTaskHandle() )
         {
             ( pxMutex->u.xSemaphore.uxRecursiveCallCount )++;
             xReturn = pdPASS;
@@ -857,238 +1381,307 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
 
-    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
-                                                       const UBaseType_t uxInitialCount,
-                                                       StaticQueue_t * pxStaticQueue )
+    static BaseType_t prvMutexTakeWithoutKernel( Queue_t * const pxQueue )
     {
-        QueueHandle_t xHandle = NULL;
-
-        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+        BaseType_t xReturn = pdFALSE;
+        TaskHandle_t xCurrentTask;
 
-        if( ( uxMaxCount != 0U ) &&
-            ( uxInitialCount <= uxMaxCount ) )
+        if( ( pxQueue->pvMutexOwner == NULL ) && ( queueMUTEX_CAN_BYPASS_KERNEL( pxQueue ) != pdFALSE ) )
         {
-            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
-
-            if( xHandle != NULL )
+            /* Count the mutex as held before taking it, so a task that finds
+             * the mutex held, and inherits or disinherits a priority, never
+             * sees a held count that misses it.  pvTaskIncrementMutexHeldCount()
+             * only returns NULL if no task has been created yet, in which case
+             * the mutex is taken through the kernel.  Before the scheduler
+             * starts the mutex is recorded as held by the current task, as it
+             * is when the mutex is taken through the kernel. */
+            xCurrentTask = pvTaskIncrementMutexHeldCount();
+
+            if( xCurrentTask != NULL )
             {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
-
-                traceCREATE_COUNTING_SEMAPHORE();
+                if( Atomic_CompareAndSwapPointers_p32( &( pxQueue->pvMutexOwner ), xCurrentTask, NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                {
+                    xReturn = pdTRUE;
+                }
+                else if( xTaskDecrementMutexHeldCount() != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            configASSERT( xHandle );
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
-
-        return xHandle;
+        return xReturn;
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* configUSE_MUTEX_FAST_PATH */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
 
-    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
-                                                 const UBaseType_t uxInitialCount )
+    static BaseType_t prvMutexGiveWithoutKernel( Queue_t * const pxQueue )
     {
-        QueueHandle_t xHandle = NULL;
-
-        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
-
-        if( ( uxMaxCount != 0U ) &&
-            ( uxInitialCount <= uxMaxCount ) )
+        BaseType_t xReturn = pdFALSE;
+        TaskHandle_t const xCurrentTask = xTaskGetCurrentTaskHandle();
+
+        /* Only the task that took the mutex without entering the kernel can
+         * swap pvMutexOwner back to NULL.  If another task has since handed the
+         * mutex to the kernel the swap fails, and the mutex is given through the
+         * kernel so any waiting task is unblocked and any inherited priority is
+         * disinherited. */
+        if( xCurrentTask != NULL )
         {
-            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
-
-            if( xHandle != NULL )
+            if( Atomic_CompareAndSwapPointers_p32( &( pxQueue->pvMutexOwner ), NULL, xCurrentTask ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
             {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+                if( xTaskDecrementMutexHeldCount() != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                traceCREATE_COUNTING_SEMAPHORE();
+                xReturn = pdTRUE;
             }
             else
             {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            configASSERT( xHandle );
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
+        return xReturn;
+    }
 
-        return xHandle;
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+    static void prvMutexEnterKernel( Queue_t * const pxQueue )
+    {
+        void * pvOwner;
+
+        /* Tasks that take or give the mutex without entering the kernel do not
+         * use the critical section, so pvMutexOwner must still be swapped
+         * atomically. */
+        do
+        {
+            pvOwner = pxQueue->pvMutexOwner;
+        } while( ( pvOwner != queueMUTEX_OWNER_KERNEL( pxQueue ) ) &&
+                 ( Atomic_CompareAndSwapPointers_p32( &( pxQueue->pvMutexOwner ), queueMUTEX_OWNER_KERNEL( pxQueue ), pvOwner ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS ) );
+
+        if( ( pvOwner != NULL ) && ( pvOwner != queueMUTEX_OWNER_KERNEL( pxQueue ) ) )
+        {
+            /* A task took the mutex without entering the kernel.  It counted
+             * the mutex in its held count at the time, so only the mutex needs
+             * updating to show it is held. */
+            pxQueue->u.xSemaphore.xMutexHolder = ( TaskHandle_t ) pvOwner;
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* configUSE_MUTEX_FAST_PATH */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
-                              const void * const pvItemToQueue,
-                              TickType_t xTicksToWait,
-                              const BaseType_t xCopyPosition )
-{
-    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
+#if ( configUSE_RW_LOCKS == 1 )
 
-    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+    static void prvInitialiseRwLock( Queue_t * pxNewQueue )
+    {
+        if( pxNewQueue != NULL )
+        {
+            /* A reader-writer lock is created as a mutex that is not held by
+             * any task, so it uses the same critical section as a mutex and
+             * its writer can inherit a priority. */
+            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
+            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = ( UBaseType_t ) 0;
+            pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
+            pxNewQueue->pcWriteTo = NULL;
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+            {
+                pxNewQueue->uxCeilingPriority = queueMUTEX_HAS_NO_CEILING;
+            }
+            #endif
+
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+            {
+                /* A reader-writer lock is always taken through the kernel. */
+                pxNewQueue->pvMutexOwner = queueMUTEX_OWNER_KERNEL( pxNewQueue );
+            }
+            #endif
+
+            traceCREATE_MUTEX( pxNewQueue );
+        }
+        else
+        {
+            traceCREATE_MUTEX_FAILED();
+        }
+    }
+
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateRwLock( void )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxRwLockLength = ( UBaseType_t ) 1, uxRwLockSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateRwLock();
+
+        xNewQueue = xQueueGenericCreate( uxRwLockLength, uxRwLockSize, queueQUEUE_TYPE_RW_LOCK );
+        prvInitialiseRwLock( ( Queue_t * ) xNewQueue );
+
+        traceRETURN_xQueueCreateRwLock( xNewQueue );
+
+        return xNewQueue;
     }
-    #endif
 
-    for( ; ; )
+#endif /* ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateRwLockStatic( StaticQueue_t * pxStaticQueue )
     {
-        taskENTER_CRITICAL();
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxRwLockLength = ( UBaseType_t ) 1, uxRwLockSize = ( UBaseType_t ) 0;
+
+        traceENTER_xQueueCreateRwLockStatic( pxStaticQueue );
+
+        xNewQueue = xQueueGenericCreateStatic( uxRwLockLength, uxRwLockSize, NULL, pxStaticQueue, queueQUEUE_TYPE_RW_LOCK );
+        prvInitialiseRwLock( ( Queue_t * ) xNewQueue );
+
+        traceRETURN_xQueueCreateRwLockStatic( xNewQueue );
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    BaseType_t xQueueTakeRwLock( QueueHandle_t xRwLock,
+                                 const BaseType_t xWrite,
+                                 TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        BaseType_t xInheritanceOccurred = pdFALSE, xYieldRequired = pdFALSE;
+        BaseType_t xCanBeTaken;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xRwLock;
+
+        traceENTER_xQueueTakeRwLock( xRwLock, xWrite, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* Is there room on the queue now?  The running task must be the
-             * highest priority task wanting to access the queue.  If the head item
-             * in the queue is to be overwritten then it does not matter if the
-             * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
-            {
-                traceQUEUE_SEND( pxQueue );
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-                #if ( configUSE_QUEUE_SETS == 1 )
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
+            {
+                if( queueRW_LOCK_CAN_BE_TAKEN( pxQueue, xWrite ) != pdFALSE )
                 {
-                    const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+                    traceQUEUE_RECEIVE( pxQueue );
 
-                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
-
-                    if( pxQueue->pxQueueSetContainer != NULL )
+                    if( xWrite != pdFALSE )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
-                        {
-                            /* Do not notify the queue set as an existing item
-                             * was overwritten in the queue so the number of items
-                             * in the queue has not changed. */
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
-                        {
-                            /* The queue is a member of a queue set, and posting
-                             * to the queue set caused a higher priority task to
-                             * unblock. A context switch is required. */
-                            queueYIELD_IF_USING_PREEMPTION();
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        /* Record the information required to implement
+                         * priority inheritance should it become necessary. */
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
                     }
                     else
                     {
-                        /* If there was a task waiting for data to arrive on the
-                         * queue then unblock it now. */
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                        {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                            {
-                                /* The unblocked task has a priority higher than
-                                 * our own so yield immediately.  Yes it is ok to
-                                 * do this from within the critical section - the
-                                 * kernel takes care of that. */
-                                queueYIELD_IF_USING_PREEMPTION();
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else if( xYieldRequired != pdFALSE )
-                        {
-                            /* This path is a special case that will only get
-                             * executed if the task was holding multiple mutexes
-                             * and the mutexes were given back in an order that is
-                             * different to that in which they were taken. */
-                            queueYIELD_IF_USING_PREEMPTION();
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        ( pxQueue->uxMessagesWaiting )++;
                     }
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_xQueueTakeRwLock( pdPASS );
+
+                    return pdPASS;
                 }
-                #else /* configUSE_QUEUE_SETS */
+                else if( xTicksToWait == ( TickType_t ) 0 )
                 {
-                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+                    /* The lock cannot be taken and no block time is specified
+                     * (or the block time has expired).  A writer that gives up
+                     * waiting must no longer hold back tasks that are waiting
+                     * to read. */
+                    if( ( xWrite != pdFALSE ) && ( xEntryTimeSet != pdFALSE ) )
+                    {
+                        xYieldRequired = prvRemoveRwLockWaitingWriter( pxQueue );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                    /* If there was a task waiting for data to arrive on the
-                     * queue then unblock it now. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    if( xInheritanceOccurred != pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The unblocked task has a priority higher than
-                             * our own so yield immediately.  Yes it is ok to do
-                             * this from within the critical section - the kernel
-                             * takes care of that. */
-                            queueYIELD_IF_USING_PREEMPTION();
-                        }
-                        else
+                        taskENTER_CRITICAL();
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* This task blocking on the lock caused the
+                             * writer to inherit this task's priority, so the
+                             * writer disinherits it again, but only as low as
+                             * the highest priority task still waiting. */
+                            vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, prvGetRwLockDisinheritPriorityAfterTimeout( pxQueue ) );
                         }
+                        taskEXIT_CRITICAL();
                     }
-                    else if( xYieldRequired != pdFALSE )
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xYieldRequired != pdFALSE )
                     {
-                        /* This path is a special case that will only get
-                         * executed if the task was holding multiple mutexes and
-                         * the mutexes were given back in an order that is
-                         * different to that in which they were taken. */
                         queueYIELD_IF_USING_PREEMPTION();
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-                }
-                #endif /* configUSE_QUEUE_SETS */
-
-                taskEXIT_CRITICAL();
-
-                traceRETURN_xQueueGenericSend( pdPASS );
 
-                return pdPASS;
-            }
-            else
-            {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The queue was full and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
-
-                    /* Return to the original privilege level before exiting
-                     * the function. */
-                    traceQUEUE_SEND_FAILED( pxQueue );
-                    traceRETURN_xQueueGenericSend( errQUEUE_FULL );
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueTakeRwLock( errQUEUE_EMPTY );
 
-                    return errQUEUE_FULL;
+                    return errQUEUE_EMPTY;
                 }
                 else if( xEntryTimeSet == pdFALSE )
                 {
-                    /* The queue was full and a block time was specified so
-                     * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
                 }
@@ -1098,371 +1691,286 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-        }
-        taskEXIT_CRITICAL();
+            queueEXIT_CRITICAL( pxQueue );
 
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now the critical section has been exited. */
-
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
-        {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
             {
-                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
-
-                /* Unlocking the queue means queue events can effect the
-                 * event list. It is possible that interrupts occurring now
-                 * remove this task from the event list again - but as the
-                 * scheduler is suspended the task will go onto the pending
-                 * ready list instead of the actual ready list. */
-                prvUnlockQueue( pxQueue );
-
-                /* Resuming the scheduler will move tasks from the pending
-                 * ready list into the ready list - so it is feasible that this
-                 * task is already in the ready list before it yields - in which
-                 * case the yield will not cause a context switch unless there
-                 * is also a higher priority task in the pending ready list. */
-                if( xTaskResumeAll() == pdFALSE )
+                queueENTER_CRITICAL( pxQueue );
                 {
-                    taskYIELD_WITHIN_API();
+                    xCanBeTaken = queueRW_LOCK_CAN_BE_TAKEN( pxQueue, xWrite );
                 }
-            }
-            else
-            {
-                /* Try again. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
-            }
-        }
-        else
-        {
-            /* The timeout has expired. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+                queueEXIT_CRITICAL( pxQueue );
 
-            traceQUEUE_SEND_FAILED( pxQueue );
-            traceRETURN_xQueueGenericSend( errQUEUE_FULL );
+                if( xCanBeTaken == pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
 
-            return errQUEUE_FULL;
-        }
-    }
-}
-/*-----------------------------------------------------------*/
+                    /* Readers and writers that are waiting for a writer raise
+                     * the writer's priority.  The priority of tasks that hold
+                     * the lock for reading is never raised. */
+                    if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
-                                     const void * const pvItemToQueue,
-                                     BaseType_t * const pxHigherPriorityTaskWoken,
-                                     const BaseType_t xCopyPosition )
-{
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    Queue_t * const pxQueue = xQueue;
+                    if( xWrite != pdFALSE )
+                    {
+                        vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    }
+                    else
+                    {
+                        vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    }
 
-    traceENTER_xQueueGenericSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken, xCopyPosition );
+                    prvUnlockQueue( pxQueue );
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The lock can be taken now, so try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  xTicksToWait is now 0, so the next attempt
+                 * either takes the lock or returns without blocking. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+    }
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
 
-    /* Similar to xQueueGenericSend, except without blocking if there is no room
-     * in the queue.  Also don't directly wake a task that was blocked on a queue
-     * read, instead return a flag to say whether a context switch is required or
-     * not (i.e. has a task with a higher priority than us been woken by this
-     * post). */
-    /* MISRA Ref 4.7.1 [Return value shall be checked] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-    /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+#if ( configUSE_RW_LOCKS == 1 )
+
+    BaseType_t xQueueGiveRwLock( QueueHandle_t xRwLock,
+                                 const BaseType_t xWrite )
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
-        {
-            const int8_t cTxLock = pxQueue->cTxLock;
-            const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+        BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+        Queue_t * const pxQueue = xRwLock;
 
-            traceQUEUE_SEND_FROM_ISR( pxQueue );
+        traceENTER_xQueueGiveRwLock( xRwLock, xWrite );
 
-            /* Semaphores use xQueueGiveFromISR(), so pxQueue will not be a
-             *  semaphore or mutex.  That means prvCopyDataToQueue() cannot result
-             *  in a task disinheriting a priority and prvCopyDataToQueue() can be
-             *  called here even though the disinherit function does not check if
-             *  the scheduler is suspended before accessing the ready lists. */
-            ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX );
 
-            /* The event list is not altered if the queue is locked.  This will
-             * be done when the queue is unlocked later. */
-            if( cTxLock == queueUNLOCKED )
+        queueENTER_CRITICAL( pxQueue );
+        {
+            if( xWrite != pdFALSE )
             {
-                #if ( configUSE_QUEUE_SETS == 1 )
+                /* Only the task that holds the lock for writing can give it
+                 * back. */
+                if( pxQueue->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
                 {
-                    if( pxQueue->pxQueueSetContainer != NULL )
+                    xYieldRequired = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                    pxQueue->u.xSemaphore.xMutexHolder = NULL;
+
+                    /* Writers are preferred, so readers are only unblocked if
+                     * no writer is waiting. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
-                        {
-                            /* Do not notify the queue set as an existing item
-                             * was overwritten in the queue so the number of items
-                             * in the queue has not changed. */
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
-                            /* The queue is a member of a queue set, and posting
-                             * to the queue set caused a higher priority task to
-                             * unblock.  A context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            xYieldRequired = pdTRUE;
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
+                    else if( prvUnblockRwLockReaders( pxQueue ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                        {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                            {
-                                /* The task waiting has a higher priority so
-                                 *  record that a context switch is required. */
-                                if( pxHigherPriorityTaskWoken != NULL )
-                                {
-                                    *pxHigherPriorityTaskWoken = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #else /* configUSE_QUEUE_SETS */
+                else
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    xReturn = pdFAIL;
+                }
+            }
+            else
+            {
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                {
+                    ( pxQueue->uxMessagesWaiting )--;
+
+                    /* The last reader to give the lock back unblocks the
+                     * highest priority writer.  If no writer is waiting then
+                     * any readers that were held back by a writer that has
+                     * since been deleted can take the lock. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        xYieldRequired = prvUnblockRwLockReaders( pxQueue );
+                    }
+                    else if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+                    {
+                        xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* Not used in this path. */
-                    ( void ) uxPreviousMessagesWaiting;
                 }
-                #endif /* configUSE_QUEUE_SETS */
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+
+            if( xReturn != pdFAIL )
+            {
+                traceQUEUE_SEND( pxQueue );
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was posted while it was locked. */
-                prvIncrementQueueTxLock( pxQueue, cTxLock );
+                traceQUEUE_SEND_FAILED( pxQueue );
             }
 
-            xReturn = pdPASS;
-        }
-        else
-        {
-            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
-            xReturn = errQUEUE_FULL;
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-    }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        queueEXIT_CRITICAL( pxQueue );
 
-    traceRETURN_xQueueGenericSendFromISR( xReturn );
+        traceRETURN_xQueueGiveRwLock( xReturn );
 
-    return xReturn;
-}
+        return xReturn;
+    }
+
+#endif /* configUSE_RW_LOCKS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
-                              BaseType_t * const pxHigherPriorityTaskWoken )
-{
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    Queue_t * const pxQueue = xQueue;
+#if ( configUSE_RW_LOCKS == 1 )
 
-    traceENTER_xQueueGiveFromISR( xQueue, pxHigherPriorityTaskWoken );
+    BaseType_t xQueueTakeRwLockFromISR( QueueHandle_t xRwLock )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xRwLock;
 
-    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
-     * item size is 0.  Don't directly wake a task that was blocked on a queue
-     * read, instead return a flag to say whether a context switch is required or
-     * not (i.e. has a task with a higher priority than us been woken by this
-     * post). */
+        traceENTER_xQueueTakeRwLockFromISR( xRwLock );
 
-    configASSERT( pxQueue );
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX );
 
-    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
-     * if the item size is not 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
+        /* See the comments in xQueueGiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    /* Normally a mutex would not be given from an interrupt, especially if
-     * there is a mutex holder, as priority inheritance makes no sense for an
-     * interrupts, only tasks. */
-    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+        {
+            /* An interrupt can only hold the lock for reading, and never
+             * blocks, so only succeeds if no writer holds or is waiting for
+             * the lock. */
+            if( queueRW_LOCK_CAN_BE_TAKEN( pxQueue, pdFALSE ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+                ( pxQueue->uxMessagesWaiting )++;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+                xReturn = pdFAIL;
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
 
-    /* MISRA Ref 4.7.1 [Return value shall be checked] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-    /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
-    {
-        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        traceRETURN_xQueueTakeRwLockFromISR( xReturn );
 
-        /* When the queue is used to implement a semaphore no data is ever
-         * moved through the queue but it is still valid to see if the queue 'has
-         * space'. */
-        if( uxMessagesWaiting < pxQueue->uxLength )
-        {
-            const int8_t cTxLock = pxQueue->cTxLock;
+        return xReturn;
+    }
 
-            traceQUEUE_SEND_FROM_ISR( pxQueue );
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
 
-            /* A task can only have an inherited priority if it is a mutex
-             * holder - and if there is a mutex holder then the mutex cannot be
-             * given from an ISR.  As this is the ISR version of the function it
-             * can be assumed there is no mutex holder and no need to determine if
-             * priority disinheritance is needed.  Simply increase the count of
-             * messages (semaphores) available. */
-            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+#if ( configUSE_RW_LOCKS == 1 )
 
-            /* The event list is not altered if the queue is locked.  This will
-             * be done when the queue is unlocked later. */
-            if( cTxLock == queueUNLOCKED )
+    BaseType_t xQueueGiveRwLockFromISR( QueueHandle_t xRwLock,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn, xYieldRequired;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xRwLock;
+
+        traceENTER_xQueueGiveRwLockFromISR( xRwLock, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX );
+
+        /* See the comments in xQueueGiveFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+        {
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                #if ( configUSE_QUEUE_SETS == 1 )
+                const int8_t cTxLock = pxQueue->cTxLock;
+
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                ( pxQueue->uxMessagesWaiting )--;
+
+                if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
                 {
-                    if( pxQueue->pxQueueSetContainer != NULL )
-                    {
-                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
-                        {
-                            /* The semaphore is a member of a queue set, and
-                             * posting to the queue set caused a higher priority
-                             * task to unblock.  A context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
+                    /* The event list is not altered if the lock is locked.
+                     * The highest priority writer is unblocked when the lock
+                     * is unlocked later.  As in xQueueGiveRwLock(), if no
+                     * writer is waiting then readers held back by a writer
+                     * that has since been deleted are unblocked instead. */
+                    if( cTxLock == queueUNLOCKED )
                     {
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                            {
-                                /* The task waiting has a higher priority so
-                                 *  record that a context switch is required. */
-                                if( pxHigherPriorityTaskWoken != NULL )
-                                {
-                                    *pxHigherPriorityTaskWoken = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            xYieldRequired = prvUnblockRwLockReaders( pxQueue );
                         }
-                    }
-                }
-                #else /* configUSE_QUEUE_SETS */
-                {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                    {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+
+                        if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
                         {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            *pxHigherPriorityTaskWoken = pdTRUE;
                         }
                         else
                         {
@@ -1471,265 +1979,376 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
                     }
                 }
-                #endif /* configUSE_QUEUE_SETS */
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was posted while it was locked. */
-                prvIncrementQueueTxLock( pxQueue, cTxLock );
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+                xReturn = pdFAIL;
             }
-
-            xReturn = pdPASS;
-        }
-        else
-        {
-            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
-            xReturn = errQUEUE_FULL;
         }
-    }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
-
-    traceRETURN_xQueueGiveFromISR( xReturn );
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+        queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue,
-                          void * const pvBuffer,
-                          TickType_t xTicksToWait )
-{
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
+        traceRETURN_xQueueGiveRwLockFromISR( xReturn );
 
-    traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
+        return xReturn;
+    }
 
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
 
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer). */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+#if ( configUSE_RW_LOCKS == 1 )
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    static BaseType_t prvUnblockRwLockReaders( Queue_t * const pxQueue )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-    }
-    #endif
+        BaseType_t xReturn = pdFALSE;
 
-    for( ; ; )
-    {
-        taskENTER_CRITICAL();
+        /* Any number of tasks can hold the lock for reading, so every waiting
+         * reader is unblocked, and the time this takes grows with the number
+         * of waiting readers. */
+        while( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
             {
-                /* Data available, remove one item. */
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_RECEIVE( pxQueue );
-                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
-
-                /* There is now space in the queue, were any tasks waiting to
-                 * post to the queue?  If so, unblock the highest priority waiting
-                 * task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-                {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                taskEXIT_CRITICAL();
-
-                traceRETURN_xQueueReceive( pdPASS );
-
-                return pdPASS;
+                xReturn = pdTRUE;
             }
             else
             {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The queue was empty and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+        return xReturn;
+    }
 
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
-                {
-                    /* The queue was empty and a block time was specified so
-                     * configure the timeout structure. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
-                }
-                else
-                {
-                    /* Entry time was already set. */
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    static BaseType_t prvRemoveRwLockWaitingWriter( Queue_t * const pxQueue )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* Readers that were held back only because this writer was waiting
+         * can now take the lock.  The writer is no longer in the list, as it
+         * was removed from it when its block time expired. */
+        if( ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) &&
+            ( pxQueue->u.xSemaphore.xMutexHolder == NULL ) )
+        {
+            xReturn = prvUnblockRwLockReaders( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        taskEXIT_CRITICAL();
 
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now the critical section has been exited. */
+        return xReturn;
+    }
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+#if ( configUSE_RW_LOCKS == 1 )
+
+    static UBaseType_t prvGetRwLockDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY, uxPriority;
+
+        /* As prvGetDisinheritPriorityAfterTimeout(), but both readers and
+         * writers can raise the priority of the writer. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
         {
-            /* The timeout has not expired.  If the queue is still empty place
-             * the task on the list of tasks waiting to receive from the queue. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                if( xTaskResumeAll() == pdFALSE )
-                {
-                    taskYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToSend ) ) > 0U )
+        {
+            uxPriority = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToSend ) ) );
+
+            if( uxPriority > uxHighestPriorityOfWaitingTasks )
+            {
+                uxHighestPriorityOfWaitingTasks = uxPriority;
             }
             else
             {
-                /* The queue contains data again.  Loop back to try and read the
-                 * data. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            /* Timed out.  If there is no data in the queue exit, otherwise loop
-             * back and attempt to read the data. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                       const UBaseType_t uxInitialCount,
+                                                       StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        traceENTER_xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+
+        if( ( uxMaxCount != 0U ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
             {
-                traceQUEUE_RECEIVE_FAILED( pxQueue );
-                traceRETURN_xQueueReceive( errQUEUE_EMPTY );
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
 
-                return errQUEUE_EMPTY;
+                traceCREATE_COUNTING_SEMAPHORE();
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
             }
         }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphoreStatic( xHandle );
+
+        return xHandle;
     }
-}
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait )
-{
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    #if ( configUSE_MUTEXES == 1 )
-        BaseType_t xInheritanceOccurred = pdFALSE;
-    #endif
+    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
+                                                 const UBaseType_t uxInitialCount )
+    {
+        QueueHandle_t xHandle = NULL;
 
-    traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
+        traceENTER_xQueueCreateCountingSemaphore( uxMaxCount, uxInitialCount );
 
-    /* Check the queue pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+        if( ( uxMaxCount != 0U ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
 
-    /* Check this really is a semaphore, in which case the item size will be
-     * 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
 
-    /* Cannot block if the scheduler is suspended. */
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueCreateCountingSemaphore( xHandle );
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
         configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
     }
     #endif
 
-    for( ; ; )
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
     {
-        taskENTER_CRITICAL();
+        if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( prvMutexGiveWithoutKernel( pxQueue ) != pdFALSE ) )
         {
-            /* Semaphores are queues with an item size of 0, and where the
-             * number of messages in the queue is the semaphore's count value. */
-            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+            traceQUEUE_SEND( pxQueue );
+            traceRETURN_xQueueGenericSend( pdPASS );
 
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_MUTEX_FAST_PATH */
+
+    for( ; ; )
+    {
+        prvEnterCriticalWhenUnlocked( pxQueue );
+        {
+            /* Is there room on the queue now?  The running task must be the
+             * highest priority task wanting to access the queue.  If the head item
+             * in the queue is to be overwritten then it does not matter if the
+             * queue is full. */
+            if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) &&
+                ( queueCAN_WRITE( pxQueue ) != pdFALSE ) )
             {
-                traceQUEUE_RECEIVE( pxQueue );
+                #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+                {
+                    /* An item acquired by xQueueAcquire() is at the front of
+                     * the queue, so nothing can be written in front of it. */
+                    configASSERT( ( xCopyPosition == queueSEND_TO_BACK ) || ( ( pxQueue->ucZeroCopyState & queueITEM_ACQUIRED ) == 0U ) );
+                }
+                #endif
 
-                /* Semaphores are queues with a data size of zero and where the
-                 * messages waiting is the semaphore's count.  Reduce the count. */
-                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
+                traceQUEUE_SEND( pxQueue );
 
-                #if ( configUSE_MUTEXES == 1 )
+                #if ( configUSE_MUTEX_FAST_PATH == 1 )
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    /* A mutex that is given back while no tasks are waiting
+                     * for it can be taken without entering the kernel again. */
+                    if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) &&
+                        ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
                     {
-                        /* Record the information required to implement
-                         * priority inheritance should it become necessary. */
-                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                        pxQueue->pvMutexOwner = NULL;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* configUSE_MUTEXES */
+                #endif /* configUSE_MUTEX_FAST_PATH */
 
-                /* Check to see if other tasks are blocked waiting to give the
-                 * semaphore, and if so, unblock the highest priority such task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                #if ( configUSE_QUEUE_SETS == 1 )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+
+                    if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        queueYIELD_IF_USING_PREEMPTION();
+                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+                        {
+                            /* Do not notify the queue set as an existing item
+                             * was overwritten in the queue so the number of items
+                             * in the queue has not changed. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The queue is a member of a queue set, and posting
+                             * to the queue set caused a higher priority task to
+                             * unblock. A context switch is required. */
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* If there was a task waiting for data to arrive on the
+                         * queue then unblock it now. */
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The unblocked task has a priority higher than
+                                 * our own so yield immediately.  Yes it is ok to
+                                 * do this from within the critical section - the
+                                 * kernel takes care of that. */
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else if( xYieldRequired != pdFALSE )
+                        {
+                            /* This path is a special case that will only get
+                             * executed if the task was holding multiple mutexes
+                             * and the mutexes were given back in an order that is
+                             * different to that in which they were taken. */
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                 }
-                else
+                #else /* configUSE_QUEUE_SETS */
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+
+                    /* If there was a task waiting for data to arrive on the
+                     * queue then unblock it now. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The unblocked task has a priority higher than
+                             * our own so yield immediately.  Yes it is ok to do
+                             * this from within the critical section - the kernel
+                             * takes care of that. */
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( xYieldRequired != pdFALSE )
+                    {
+                        /* This path is a special case that will only get
+                         * executed if the task was holding multiple mutexes and
+                         * the mutexes were given back in an order that is
+                         * different to that in which they were taken. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* configUSE_QUEUE_SETS */
 
-                taskEXIT_CRITICAL();
+                queueEXIT_CRITICAL( pxQueue );
 
-                traceRETURN_xQueueSemaphoreTake( pdPASS );
+                traceRETURN_xQueueGenericSend( pdPASS );
 
                 return pdPASS;
             }
@@ -1737,19 +2356,21 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
             {
                 if( xTicksToWait == ( TickType_t ) 0 )
                 {
-                    /* The semaphore count was 0 and no block time is specified
-                     * (or the block time has expired) so exit now. */
-                    taskEXIT_CRITICAL();
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
 
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+                    /* Return to the original privilege level before exiting
+                     * the function. */
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
-                    return errQUEUE_EMPTY;
+                    return errQUEUE_FULL;
                 }
                 else if( xEntryTimeSet == pdFALSE )
                 {
-                    /* The semaphore count was 0 and a block time was specified
-                     * so configure the timeout structure ready to block. */
+                    /* The queue was full and a block time was specified so
+                     * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
                 }
@@ -1760,9 +2381,9 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 }
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
 
-        /* Interrupts and other tasks can give to and take from the semaphore
+        /* Interrupts and other tasks can send to and receive from the queue
          * now the critical section has been exited. */
 
         vTaskSuspendAll();
@@ -1771,279 +2392,256 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            /* A block time is specified and not expired.  If the semaphore
-             * count is 0 then enter the Blocked state to wait for a semaphore to
-             * become available.  As semaphores are implemented with queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
             {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-                    {
-                        taskENTER_CRITICAL();
-                        {
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
-                        }
-                        taskEXIT_CRITICAL();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                /* Unlocking the queue means queue events can effect the
+                 * event list. It is possible that interrupts occurring now
+                 * remove this task from the event list again - but as the
+                 * scheduler is suspended the task will go onto the pending
+                 * ready list instead of the actual ready list. */
                 prvUnlockQueue( pxQueue );
 
+                /* Resuming the scheduler will move tasks from the pending
+                 * ready list into the ready list - so it is feasible that this
+                 * task is already in the ready list before it yields - in which
+                 * case the yield will not cause a context switch unless there
+                 * is also a higher priority task in the pending ready list. */
                 if( xTaskResumeAll() == pdFALSE )
                 {
                     taskYIELD_WITHIN_API();
                 }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
             }
             else
             {
-                /* There was no timeout and the semaphore count was not 0, so
-                 * attempt to take the semaphore again. */
+                /* Try again. */
                 prvUnlockQueue( pxQueue );
                 ( void ) xTaskResumeAll();
             }
         }
         else
         {
-            /* Timed out. */
+            /* The timeout has expired. */
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
-            /* If the semaphore count is 0 exit now as the timeout has
-             * expired.  Otherwise return to attempt to take the semaphore that is
-             * known to be available.  As semaphores are implemented by queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    /* xInheritanceOccurred could only have be set if
-                     * pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
-                     * test the mutex type again to check it is actually a mutex. */
-                    if( xInheritanceOccurred != pdFALSE )
-                    {
-                        taskENTER_CRITICAL();
-                        {
-                            UBaseType_t uxHighestWaitingPriority;
-
-                            /* This task blocking on the mutex caused another
-                             * task to inherit this task's priority.  Now this task
-                             * has timed out the priority should be disinherited
-                             * again, but only as low as the next highest priority
-                             * task that is waiting for the same mutex. */
-                            uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
-
-                            /* vTaskPriorityDisinheritAfterTimeout uses the uxHighestWaitingPriority
-                             * parameter to index pxReadyTasksLists when adding the task holding
-                             * mutex to the ready list for its new priority. Coverity thinks that
-                             * it can result in out-of-bounds access which is not true because
-                             * uxHighestWaitingPriority, as returned by prvGetDisinheritPriorityAfterTimeout,
-                             * is capped at ( configMAX_PRIORITIES - 1 ). */
-                            /* coverity[overrun] */
-                            vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
-                        }
-                        taskEXIT_CRITICAL();
-                    }
-                }
-                #endif /* configUSE_MUTEXES */
-
-                traceQUEUE_RECEIVE_FAILED( pxQueue );
-                traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+            traceQUEUE_SEND_FAILED( pxQueue );
+            traceRETURN_xQueueGenericSend( errQUEUE_FULL );
 
-                return errQUEUE_EMPTY;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            return errQUEUE_FULL;
         }
     }
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeek( QueueHandle_t xQueue,
-                       void * const pvBuffer,
-                       TickType_t xTicksToWait )
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
+                                     const void * const pvItemToQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken,
+                                     const BaseType_t xCopyPosition )
 {
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
-    int8_t * pcOriginalReadPosition;
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
     Queue_t * const pxQueue = xQueue;
 
-    traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait );
-
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    traceENTER_xQueueGenericSendFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken, xCopyPosition );
 
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer. */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
-    {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-    }
-    #endif
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    for( ; ; )
+    /* Similar to xQueueGenericSend, except without blocking if there is no room
+     * in the queue.  Also don't directly wake a task that was blocked on a queue
+     * read, instead return a flag to say whether a context switch is required or
+     * not (i.e. has a task with a higher priority than us been woken by this
+     * post). */
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
     {
-        taskENTER_CRITICAL();
+        if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) &&
+            ( queueCAN_WRITE( pxQueue ) != pdFALSE ) )
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+            const int8_t cTxLock = pxQueue->cTxLock;
+            const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+                /* An item acquired by xQueueAcquire() is at the front of the
+                 * queue, so nothing can be written in front of it. */
+                configASSERT( ( xCopyPosition == queueSEND_TO_BACK ) || ( ( pxQueue->ucZeroCopyState & queueITEM_ACQUIRED ) == 0U ) );
+            }
+            #endif
 
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_PEEK( pxQueue );
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
 
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            /* Semaphores use xQueueGiveFromISR(), so pxQueue will not be a
+             *  semaphore or mutex.  That means prvCopyDataToQueue() cannot result
+             *  in a task disinheriting a priority and prvCopyDataToQueue() can be
+             *  called here even though the disinherit function does not check if
+             *  the scheduler is suspended before accessing the ready lists. */
+            ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
-                /* The data is being left in the queue, so see if there are
-                 * any other tasks waiting for the data. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        /* The task waiting has a higher priority than this task. */
-                        queueYIELD_IF_USING_PREEMPTION();
+                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+                        {
+                            /* Do not notify the queue set as an existing item
+                             * was overwritten in the queue so the number of items
+                             * in the queue has not changed. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The queue is a member of a queue set, and posting
+                             * to the queue set caused a higher priority task to
+                             * unblock.  A context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The task waiting has a higher priority so
+                                 *  record that a context switch is required. */
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                 }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                taskEXIT_CRITICAL();
-
-                traceRETURN_xQueuePeek( pdPASS );
-
-                return pdPASS;
-            }
-            else
-            {
-                if( xTicksToWait == ( TickType_t ) 0 )
+                #else /* configUSE_QUEUE_SETS */
                 {
-                    /* The queue was empty and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
-
-                    traceQUEUE_PEEK_FAILED( pxQueue );
-                    traceRETURN_xQueuePeek( errQUEUE_EMPTY );
-
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
-                {
-                    /* The queue was empty and a block time was specified so
-                     * configure the timeout structure ready to enter the blocked
-                     * state. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
-                }
-                else
-                {
-                    /* Entry time was already set. */
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-        }
-        taskEXIT_CRITICAL();
-
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now that the critical section has been exited. */
-
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
-
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
-        {
-            /* Timeout has not expired yet, check to see if there is data in the
-            * queue now, and if not enter the Blocked state to wait for data. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                if( xTaskResumeAll() == pdFALSE )
-                {
-                    taskYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Not used in this path. */
+                    ( void ) uxPreviousMessagesWaiting;
                 }
+                #endif /* configUSE_QUEUE_SETS */
             }
             else
             {
-                /* There is data in the queue now, so don't enter the blocked
-                 * state, instead return to try and obtain the data. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was posted while it was locked. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
             }
+
+            xReturn = pdPASS;
         }
         else
         {
-            /* The timeout has expired.  If there is still no data in the queue
-             * exit, otherwise go back and try to read the data again. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
-
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceQUEUE_PEEK_FAILED( pxQueue );
-                traceRETURN_xQueuePeek( errQUEUE_EMPTY );
-
-                return errQUEUE_EMPTY;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
         }
     }
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    traceRETURN_xQueueGenericSendFromISR( xReturn );
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
-                                 void * const pvBuffer,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
+BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
 {
     BaseType_t xReturn;
     UBaseType_t uxSavedInterruptStatus;
     Queue_t * const pxQueue = xQueue;
 
-    traceENTER_xQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+    traceENTER_xQueueGiveFromISR( xQueue, pxHigherPriorityTaskWoken );
+
+    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
+     * item size is 0.  Don't directly wake a task that was blocked on a queue
+     * read, instead return a flag to say whether a context switch is required or
+     * not (i.e. has a task with a higher priority than us been woken by this
+     * post). */
 
     configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
+     * if the item size is not 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Normally a mutex would not be given from an interrupt, especially if
+     * there is a mutex holder, as priority inheritance makes no sense for an
+     * interrupts, only tasks. */
+    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -2064,35 +2662,48 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
     {
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-        /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        /* When the queue is used to implement a semaphore no data is ever
+         * moved through the queue but it is still valid to see if the queue 'has
+         * space'. */
+        if( uxMessagesWaiting < pxQueue->uxLength )
         {
-            const int8_t cRxLock = pxQueue->cRxLock;
+            const int8_t cTxLock = pxQueue->cTxLock;
 
-            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
 
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+            /* A task can only have an inherited priority if it is a mutex
+             * holder - and if there is a mutex holder then the mutex cannot be
+             * given from an ISR.  As this is the ISR version of the function it
+             * can be assumed there is no mutex holder and no need to determine if
+             * priority disinheritance is needed.  Simply increase the count of
+             * messages (semaphores) available. */
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
 
-            /* If the queue is locked the event list will not be modified.
-             * Instead update the lock count so the task that unlocks the queue
-             * will know that an ISR has removed data while the queue was
-             * locked. */
-            if( cRxLock == queueUNLOCKED )
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                #if ( configUSE_QUEUE_SETS == 1 )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    if( pxQueue->pxQueueSetContainer != NULL )
                     {
-                        /* The task waiting has a higher priority than us so
-                         * force a context switch. */
-                        if( pxHigherPriorityTaskWoken != NULL )
+                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
                         {
-                            *pxHigherPriorityTaskWoken = pdTRUE;
+                            /* The semaphore is a member of a queue set, and
+                             * posting to the queue set caused a higher priority
+                             * task to unblock.  A context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                         else
                         {
@@ -2101,357 +2712,3215 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The task waiting has a higher priority so
+                                 *  record that a context switch is required. */
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                 }
-                else
+                #else /* configUSE_QUEUE_SETS */
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* configUSE_QUEUE_SETS */
             }
             else
             {
                 /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was removed while it was locked. */
-                prvIncrementQueueRxLock( pxQueue, cRxLock );
+                 * knows that data was posted while it was locked. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
             }
 
             xReturn = pdPASS;
         }
         else
         {
-            xReturn = pdFAIL;
-            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_FULL;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
 
-    traceRETURN_xQueueReceiveFromISR( xReturn );
+    traceRETURN_xQueueGiveFromISR( xReturn );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
-                              void * const pvBuffer )
+BaseType_t xQueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
-    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
+    traceENTER_xQueueReceive( xQueue, pvBuffer, xTicksToWait );
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer). */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
 
-    /* MISRA Ref 4.7.1 [Return value shall be checked] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-    /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
-        /* Cannot block in an ISR, so check there is data available. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
-        {
-            traceQUEUE_PEEK_FROM_ISR( pxQueue );
-
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
-
-            xReturn = pdPASS;
-        }
-        else
-        {
-            xReturn = pdFAIL;
-            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
-        }
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    #endif
 
-    traceRETURN_xQueuePeekFromISR( xReturn );
+    for( ; ; )
+    {
+        prvEnterCriticalWhenUnlocked( pxQueue );
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueCAN_READ( pxQueue ) != pdFALSE ) )
+            {
+                /* Data available, remove one item. */
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
+                /* There is now space in the queue, were any tasks waiting to
+                 * post to the queue?  If so, unblock the highest priority waiting
+                 * task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    traceENTER_uxQueueMessagesWaiting( xQueue );
+                queueEXIT_CRITICAL( pxQueue );
 
-    configASSERT( xQueue );
+                traceRETURN_xQueueReceive( pdPASS );
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
 
-    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueReceive( errQUEUE_EMPTY );
 
-    return uxReturn;
-}
-/*-----------------------------------------------------------*/
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
 
-    traceENTER_uxQueueSpacesAvailable( xQueue );
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
 
-    configASSERT( pxQueue );
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* The timeout has not expired.  If the queue is still empty place
+             * the task on the list of tasks waiting to receive from the queue. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
-    }
-    taskEXIT_CRITICAL();
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  If there is no data in the queue exit, otherwise loop
+             * back and attempt to read the data. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
 
-    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                traceRETURN_xQueueReceive( errQUEUE_EMPTY );
 
-    return uxReturn;
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
 
-    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
+    BaseType_t xQueueReceiveUntilNs( QueueHandle_t xQueue,
+                                     void * const pvBuffer,
+                                     uint64_t ullDeadlineNs )
+    {
+        BaseType_t xReturn;
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+        traceENTER_xQueueReceiveUntilNs( xQueue, pvBuffer, ullDeadlineNs );
 
-    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+        /* The block time only bounds the wait, the task leaves the Blocked
+         * state at the deadline. */
+        xReturn = xQueueReceive( xQueue, pvBuffer, xTaskInternalSetDeadlineNs( ullDeadlineNs ) );
+        vTaskInternalClearDeadlineNs();
 
-    return uxReturn;
-}
+        traceRETURN_xQueueReceiveUntilNs( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMEOUTS */
 /*-----------------------------------------------------------*/
 
-void vQueueDelete( QueueHandle_t xQueue )
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                TickType_t xTicksToWait )
 {
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
-    traceENTER_vQueueDelete( xQueue );
+    #if ( configUSE_MUTEXES == 1 )
+        BaseType_t xInheritanceOccurred = pdFALSE;
+    #endif
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+    traceENTER_xQueueSemaphoreTake( xQueue, xTicksToWait );
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Check this really is a semaphore, in which case the item size will be
+     * 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
-        vQueueUnregisterQueue( pxQueue );
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
     }
     #endif
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
     {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( prvMutexTakeWithoutKernel( pxQueue ) != pdFALSE ) )
         {
-            vPortFree( pxQueue );
+            traceQUEUE_RECEIVE( pxQueue );
+            traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+            return pdPASS;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
-    {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
-    }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-
-    traceRETURN_vQueueDelete();
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
+    #endif /* configUSE_MUTEX_FAST_PATH */
 
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    for( ; ; )
     {
-        traceENTER_uxQueueGetQueueNumber( xQueue );
+        prvEnterCriticalWhenUnlocked( pxQueue );
+        {
+            UBaseType_t uxSemaphoreCount;
 
-        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+            #if ( configUSE_MUTEX_FAST_PATH == 1 )
+            {
+                /* The mutex is taken, or waited for, through the kernel, so
+                 * the semaphore count must record whether it is held. */
+                if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                {
+                    prvMutexEnterKernel( pxQueue );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_MUTEX_FAST_PATH */
 
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+            /* Semaphores are queues with an item size of 0, and where the
+             * number of messages in the queue is the semaphore's count value. */
+            uxSemaphoreCount = pxQueue->uxMessagesWaiting;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+
+                /* Semaphores are queues with a data size of zero and where the
+                 * messages waiting is the semaphore's count.  Reduce the count. */
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxSemaphoreCount - ( UBaseType_t ) 1 );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        /* Record the information required to implement
+                         * priority inheritance should it become necessary. */
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+                        {
+                            if( queueMUTEX_USES_INHERITANCE( pxQueue ) == pdFALSE )
+                            {
+                                vTaskPriorityRaiseToCeiling( pxQueue->u.xSemaphore.xMutexHolder, pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_MUTEXES */
+
+                /* Check to see if other tasks are blocked waiting to give the
+                 * semaphore, and if so, unblock the highest priority such task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+
+                traceRETURN_xQueueSemaphoreTake( pdPASS );
+
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The semaphore count was 0 and no block time is specified
+                     * (or the block time has expired) so exit now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The semaphore count was 0 and a block time was specified
+                     * so configure the timeout structure ready to block. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can give to and take from the semaphore
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* A block time is specified and not expired.  If the semaphore
+             * count is 0 then enter the Blocked state to wait for a semaphore to
+             * become available.  As semaphores are implemented with queues the
+             * queue being empty is equivalent to the semaphore count being 0. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    /* The holder of a mutex that has a ceiling already runs
+                     * at the ceiling priority, so does not inherit. */
+                    if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) &&
+                        ( queueMUTEX_USES_INHERITANCE( pxQueue ) != pdFALSE ) )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* if ( configUSE_MUTEXES == 1 ) */
+
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* There was no timeout and the semaphore count was not 0, so
+                 * attempt to take the semaphore again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            /* If the semaphore count is 0 exit now as the timeout has
+             * expired.  Otherwise return to attempt to take the semaphore that is
+             * known to be available.  As semaphores are implemented by queues the
+             * queue being empty is equivalent to the semaphore count being 0. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    /* xInheritanceOccurred could only have be set if
+                     * pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
+                     * test the mutex type again to check it is actually a mutex. */
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            UBaseType_t uxHighestWaitingPriority;
+
+                            /* This task blocking on the mutex caused another
+                             * task to inherit this task's priority.  Now this task
+                             * has timed out the priority should be disinherited
+                             * again, but only as low as the next highest priority
+                             * task that is waiting for the same mutex. */
+                            uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
+
+                            /* vTaskPriorityDisinheritAfterTimeout uses the uxHighestWaitingPriority
+                             * parameter to index pxReadyTasksLists when adding the task holding
+                             * mutex to the ready list for its new priority. Coverity thinks that
+                             * it can result in out-of-bounds access which is not true because
+                             * uxHighestWaitingPriority, as returned by prvGetDisinheritPriorityAfterTimeout,
+                             * is capped at ( configMAX_PRIORITIES - 1 ). */
+                            /* coverity[overrun] */
+                            vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                }
+                #endif /* configUSE_MUTEXES */
+
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                traceRETURN_xQueueSemaphoreTake( errQUEUE_EMPTY );
+
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    BaseType_t xQueueSemaphoreTakeUntilNs( QueueHandle_t xQueue,
+                                           uint64_t ullDeadlineNs )
+    {
+        BaseType_t xReturn;
+
+        traceENTER_xQueueSemaphoreTakeUntilNs( xQueue, ullDeadlineNs );
+
+        /* The block time only bounds the wait, the task leaves the Blocked
+         * state at the deadline. */
+        xReturn = xQueueSemaphoreTake( xQueue, xTaskInternalSetDeadlineNs( ullDeadlineNs ) );
+        vTaskInternalClearDeadlineNs();
+
+        traceRETURN_xQueueSemaphoreTakeUntilNs( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_HIGH_RESOLUTION_TIMEOUTS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeek( QueueHandle_t xQueue,
+                       void * const pvBuffer,
+                       TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    int8_t * pcOriginalReadPosition;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueuePeek( xQueue, pvBuffer, xTicksToWait );
+
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer. */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    for( ; ; )
+    {
+        prvEnterCriticalWhenUnlocked( pxQueue );
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueCAN_READ( pxQueue ) != pdFALSE ) )
+            {
+                /* Remember the read position so it can be reset after the data
+                 * is read from the queue as this function is only peeking the
+                 * data, not removing it. */
+                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_PEEK( pxQueue );
+
+                /* The data is not being removed, so reset the read pointer. */
+                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+                /* The data is being left in the queue, so see if there are
+                 * any other tasks waiting for the data. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than this task. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+
+                traceRETURN_xQueuePeek( pdPASS );
+
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    traceRETURN_xQueuePeek( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure ready to enter the blocked
+                     * state. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now that the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* Timeout has not expired yet, check to see if there is data in the
+            * queue now, and if not enter the Blocked state to wait for data. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* There is data in the queue now, so don't enter the blocked
+                 * state, instead return to try and obtain the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired.  If there is still no data in the queue
+             * exit, otherwise go back and try to read the data again. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_PEEK_FAILED( pxQueue );
+                traceRETURN_xQueuePeek( errQUEUE_EMPTY );
+
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueReceiveFromISR( xQueue, pvBuffer, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* Cannot block in an ISR, so check there is data available. */
+        if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueCAN_READ( pxQueue ) != pdFALSE ) )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that an ISR has removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than us so
+                         * force a context switch. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was removed while it was locked. */
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    traceRETURN_xQueueReceiveFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    int8_t * pcOriginalReadPosition;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        /* Cannot block in an ISR, so check there is data available. */
+        if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueCAN_READ( pxQueue ) != pdFALSE ) )
+        {
+            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+
+            /* Remember the read position so it can be reset as nothing is
+             * actually being removed from the queue. */
+            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+    traceRETURN_xQueuePeekFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueReserve( QueueHandle_t xQueue,
+                              void ** const ppvSlot,
+                              TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReserve( xQueue, ppvSlot, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+
+        /* Semaphores do not hold items. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            prvEnterCriticalWhenUnlocked( pxQueue );
+            {
+                /* Is there room on the queue now?  The slot handed out is the
+                 * one the next item sent to the back of the queue would be
+                 * copied into.  Nothing is added to the queue yet, so no tasks
+                 * are unblocked. */
+                if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueCAN_WRITE( pxQueue ) != pdFALSE ) )
+                {
+                    pxQueue->ucZeroCopyState |= queueSLOT_RESERVED;
+                    *ppvSlot = ( void * ) pxQueue->pcWriteTo;
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_xQueueReserve( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was full and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        traceRETURN_xQueueReserve( errQUEUE_FULL );
+
+                        return errQUEUE_FULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was full and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_xQueueReserve( errQUEUE_FULL );
+
+                return errQUEUE_FULL;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueCommit( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueCommit( xQueue );
+
+        configASSERT( pxQueue );
+
+        prvEnterCriticalWhenUnlocked( pxQueue );
+        {
+            /* A slot must have been reserved by xQueueReserve(). */
+            configASSERT( ( pxQueue->ucZeroCopyState & queueSLOT_RESERVED ) != 0U );
+
+            traceQUEUE_SEND( pxQueue );
+
+            /* The item is already in the slot pcWriteTo points to, so only the
+             * queue's write position and item count need to be updated. */
+            pxQueue->ucZeroCopyState = ( uint8_t ) ( pxQueue->ucZeroCopyState & ( uint8_t ) ~queueSLOT_RESERVED );
+            pxQueue->pcWriteTo += pxQueue->uxItemSize;
+
+            if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->pcWriteTo = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+
+            #if ( configUSE_QUEUE_SETS == 1 )
+                if( pxQueue->pxQueueSetContainer != NULL )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+            #endif /* configUSE_QUEUE_SETS */
+
+            /* If there was a task waiting for data to arrive on the queue then
+             * unblock it now. */
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Tasks wanting to write to the queue wait while a slot is
+             * reserved, so unblock one if there is still space. */
+            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        traceRETURN_xQueueCommit( pdPASS );
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueAcquire( QueueHandle_t xQueue,
+                              void ** const ppvItem,
+                              TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        int8_t * pcItem;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueAcquire( xQueue, ppvItem, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+
+        /* Semaphores do not hold items. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            prvEnterCriticalWhenUnlocked( pxQueue );
+            {
+                /* Is there data in the queue now?  The item handed out is the
+                 * one the next call to xQueueReceive() would copy out.  It is
+                 * not removed from the queue yet, so no tasks are unblocked. */
+                if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueCAN_READ( pxQueue ) != pdFALSE ) )
+                {
+                    pcItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+
+                    if( pcItem >= pxQueue->u.xQueue.pcTail )
+                    {
+                        pcItem = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxQueue->ucZeroCopyState |= queueITEM_ACQUIRED;
+                    *ppvItem = ( void * ) pcItem;
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_xQueueAcquire( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was empty and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueAcquire( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was empty and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and
+                     * acquire it. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If there is no data in the queue exit, otherwise
+                 * loop back and attempt to acquire the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueAcquire( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueRelease( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueRelease( xQueue );
+
+        configASSERT( pxQueue );
+
+        prvEnterCriticalWhenUnlocked( pxQueue );
+        {
+            /* An item must have been acquired by xQueueAcquire(). */
+            configASSERT( ( pxQueue->ucZeroCopyState & queueITEM_ACQUIRED ) != 0U );
+
+            traceQUEUE_RECEIVE( pxQueue );
+
+            /* Remove the item from the queue as prvCopyDataFromQueue() would,
+             * but without copying it out. */
+            pxQueue->ucZeroCopyState = ( uint8_t ) ( pxQueue->ucZeroCopyState & ( uint8_t ) ~queueITEM_ACQUIRED );
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+
+            /* There is now space in the queue, were any tasks waiting to post
+             * to the queue?  If so, unblock the highest priority waiting task. */
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Tasks wanting to read from the queue wait while an item is
+             * acquired, so unblock one if there are still items to read. */
+            if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        traceRETURN_xQueueRelease( pdPASS );
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                     const void * const pvItemsToQueue,
+                                     UBaseType_t uxItemCount,
+                                     TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxItemsSent = 0;
+        UBaseType_t uxItemsToCopy;
+        const uint8_t * const pucItems = ( const uint8_t * ) pvItemsToQueue;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueSendMultiple( xQueue, pvItemsToQueue, uxItemCount, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0 ) ) );
+
+        /* Semaphores do not hold items. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            prvEnterCriticalWhenUnlocked( pxQueue );
+            {
+                /* Copy as many of the remaining items as there is space for,
+                 * then unblock the tasks waiting for them, all within the one
+                 * critical section. */
+                uxItemsToCopy = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+
+                if( uxItemsToCopy > ( uxItemCount - uxItemsSent ) )
+                {
+                    uxItemsToCopy = ( UBaseType_t ) ( uxItemCount - uxItemsSent );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( uxItemsToCopy > ( UBaseType_t ) 0 ) && ( queueCAN_WRITE( pxQueue ) != pdFALSE ) )
+                {
+                    traceQUEUE_SEND( pxQueue );
+
+                    prvCopyItemsToQueue( pxQueue, &( pucItems[ ( size_t ) uxItemsSent * ( size_t ) pxQueue->uxItemSize ] ), uxItemsToCopy );
+                    uxItemsSent = ( UBaseType_t ) ( uxItemsSent + uxItemsToCopy );
+
+                    if( prvUnblockReceivers( pxQueue, uxItemsToCopy ) != pdFALSE )
+                    {
+                        /* The yield is performed when the critical section is
+                         * exited. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( uxItemsSent == uxItemCount )
+                {
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_uxQueueSendMultiple( uxItemsSent );
+
+                    return uxItemsSent;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue is full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    traceRETURN_uxQueueSendMultiple( uxItemsSent );
+
+                    return uxItemsSent;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue is full and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_uxQueueSendMultiple( uxItemsSent );
+
+                return uxItemsSent;
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                        void * const pvBuffer,
+                                        UBaseType_t uxMaxItems,
+                                        TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxItemsReceived;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueReceiveMultiple( xQueue, pvBuffer, uxMaxItems, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+        configASSERT( uxMaxItems != ( UBaseType_t ) 0 );
+
+        /* Semaphores do not hold items. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            prvEnterCriticalWhenUnlocked( pxQueue );
+            {
+                uxItemsReceived = pxQueue->uxMessagesWaiting;
+
+                /* Is there data in the queue now?  To be running the calling
+                 * task must be the highest priority task wanting to access the
+                 * queue. */
+                if( ( uxItemsReceived > ( UBaseType_t ) 0 ) && ( queueCAN_READ( pxQueue ) != pdFALSE ) )
+                {
+                    if( uxItemsReceived > uxMaxItems )
+                    {
+                        uxItemsReceived = uxMaxItems;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    /* Copy out all the items that are wanted, then unblock the
+                     * tasks waiting for the space they occupied. */
+                    prvCopyItemsFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxItemsReceived );
+
+                    if( prvUnblockSenders( pxQueue, uxItemsReceived ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_uxQueueReceiveMultiple( uxItemsReceived );
+
+                    return uxItemsReceived;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The queue was empty and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_uxQueueReceiveMultiple( ( UBaseType_t ) 0 );
+
+                        return ( UBaseType_t ) 0;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was empty and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and
+                     * read the data. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If there is no data in the queue exit, otherwise
+                 * loop back and attempt to read the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_uxQueueReceiveMultiple( ( UBaseType_t ) 0 );
+
+                    return ( UBaseType_t ) 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                            const void * const pvItemsToQueue,
+                                            UBaseType_t uxItemCount,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxItemsSent;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueSendMultipleFromISR( xQueue, pvItemsToQueue, uxItemCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0 ) ) );
+
+        /* Semaphores do not hold items. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comments in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+        {
+            uxItemsSent = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+
+            if( uxItemsSent > uxItemCount )
+            {
+                uxItemsSent = uxItemCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( queueCAN_WRITE( pxQueue ) == pdFALSE )
+            {
+                uxItemsSent = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxItemsSent > ( UBaseType_t ) 0 )
+            {
+                int8_t cTxLock = pxQueue->cTxLock;
+                UBaseType_t ux;
+
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                prvCopyItemsToQueue( pxQueue, ( const uint8_t * ) pvItemsToQueue, uxItemsSent );
+
+                /* The event list is not altered if the queue is locked.  This
+                 * will be done when the queue is unlocked later. */
+                if( cTxLock == queueUNLOCKED )
+                {
+                    if( prvUnblockReceivers( pxQueue, uxItemsSent ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Increment the lock count once per item so the task that
+                     * unlocks the queue knows how much data was posted while it
+                     * was locked. */
+                    for( ux = 0; ux < uxItemsSent; ux++ )
+                    {
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
+                        cTxLock = pxQueue->cTxLock;
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+        traceRETURN_uxQueueSendMultipleFromISR( uxItemsSent );
+
+        return uxItemsSent;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                               void * const pvBuffer,
+                                               UBaseType_t uxMaxItems,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxItemsReceived;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxMaxItems, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+        configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItems != ( UBaseType_t ) 0 ) ) );
+
+        /* Semaphores do not hold items. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comments in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+        {
+            uxItemsReceived = pxQueue->uxMessagesWaiting;
+
+            if( uxItemsReceived > uxMaxItems )
+            {
+                uxItemsReceived = uxMaxItems;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( queueCAN_READ( pxQueue ) == pdFALSE )
+            {
+                uxItemsReceived = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Cannot block in an ISR, so only receive the data available. */
+            if( uxItemsReceived > ( UBaseType_t ) 0 )
+            {
+                int8_t cRxLock = pxQueue->cRxLock;
+                UBaseType_t ux;
+
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+                prvCopyItemsFromQueue( pxQueue, ( uint8_t * ) pvBuffer, uxItemsReceived );
+
+                /* If the queue is locked the event list will not be modified.
+                 * Instead update the lock count so the task that unlocks the
+                 * queue will know that an ISR has removed data while the queue
+                 * was locked. */
+                if( cRxLock == queueUNLOCKED )
+                {
+                    if( prvUnblockSenders( pxQueue, uxItemsReceived ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    for( ux = 0; ux < uxItemsReceived; ux++ )
+                    {
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                        cRxLock = pxQueue->cRxLock;
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+        traceRETURN_uxQueueReceiveMultipleFromISR( uxItemsReceived );
+
+        return uxItemsReceived;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueSemaphoreGiveMultiple( QueueHandle_t xQueue,
+                                              UBaseType_t uxCount )
+    {
+        UBaseType_t uxGiven;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueSemaphoreGiveMultiple( xQueue, uxCount );
+
+        configASSERT( pxQueue );
+
+        /* Only semaphores that are not mutexes can be given more than once. */
+        configASSERT( pxQueue->uxItemSize == ( UBaseType_t ) 0U );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+        prvEnterCriticalWhenUnlocked( pxQueue );
+        {
+            /* Semaphores are not given with a block time, so add as many of
+             * the units as the semaphore has room for, then unblock a task
+             * for each unit in a single walk of the event list. */
+            uxGiven = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+
+            if( uxGiven > uxCount )
+            {
+                uxGiven = uxCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxGiven > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxGiven );
+
+                if( prvUnblockReceivers( pxQueue, uxGiven ) != pdFALSE )
+                {
+                    /* The yield is performed when the critical section is
+                     * exited. */
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FAILED( pxQueue );
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        traceRETURN_uxQueueSemaphoreGiveMultiple( uxGiven );
+
+        return uxGiven;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueSemaphoreTakeMultiple( QueueHandle_t xQueue,
+                                              UBaseType_t uxMaxCount,
+                                              TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        UBaseType_t uxTaken;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueSemaphoreTakeMultiple( xQueue, uxMaxCount, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( uxMaxCount != ( UBaseType_t ) 0 );
+
+        /* Only semaphores that are not mutexes can be taken more than once. */
+        configASSERT( pxQueue->uxItemSize == ( UBaseType_t ) 0U );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            prvEnterCriticalWhenUnlocked( pxQueue );
+            {
+                uxTaken = pxQueue->uxMessagesWaiting;
+
+                if( uxTaken > ( UBaseType_t ) 0 )
+                {
+                    if( uxTaken > uxMaxCount )
+                    {
+                        uxTaken = uxMaxCount;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxTaken );
+
+                    if( prvUnblockSenders( pxQueue, uxTaken ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceRETURN_uxQueueSemaphoreTakeMultiple( uxTaken );
+
+                    return uxTaken;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The semaphore count was 0 and no block time is
+                         * specified (or the block time has expired) so exit
+                         * now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_uxQueueSemaphoreTakeMultiple( ( UBaseType_t ) 0 );
+
+                        return ( UBaseType_t ) 0;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The semaphore count was 0 and a block time was
+                         * specified so configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The semaphore was given again.  Loop back to try and
+                     * take it. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If the semaphore count is 0 exit, otherwise loop
+                 * back and attempt to take the semaphore. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_uxQueueSemaphoreTakeMultiple( ( UBaseType_t ) 0 );
+
+                    return ( UBaseType_t ) 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueSemaphoreGiveMultipleFromISR( QueueHandle_t xQueue,
+                                                     UBaseType_t uxCount,
+                                                     BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxGiven;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueSemaphoreGiveMultipleFromISR( xQueue, uxCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+
+        /* Only semaphores that are not mutexes can be given more than once. */
+        configASSERT( pxQueue->uxItemSize == ( UBaseType_t ) 0U );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+        /* See the comments in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+        {
+            uxGiven = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+
+            if( uxGiven > uxCount )
+            {
+                uxGiven = uxCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( uxGiven > ( UBaseType_t ) 0 )
+            {
+                int8_t cTxLock = pxQueue->cTxLock;
+                UBaseType_t ux;
+
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxGiven );
+
+                /* The event list is not altered if the queue is locked.  This
+                 * will be done when the queue is unlocked later. */
+                if( cTxLock == queueUNLOCKED )
+                {
+                    if( prvUnblockReceivers( pxQueue, uxGiven ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Increment the lock count once per unit so the task that
+                     * unlocks the queue knows how many tasks to unblock. */
+                    for( ux = 0; ux < uxGiven; ux++ )
+                    {
+                        prvIncrementQueueTxLock( pxQueue, cTxLock );
+                        cTxLock = pxQueue->cTxLock;
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+        traceRETURN_uxQueueSemaphoreGiveMultipleFromISR( uxGiven );
+
+        return uxGiven;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    UBaseType_t uxQueueSemaphoreTakeMultipleFromISR( QueueHandle_t xQueue,
+                                                     UBaseType_t uxMaxCount,
+                                                     BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxTaken;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_uxQueueSemaphoreTakeMultipleFromISR( xQueue, uxMaxCount, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+
+        /* Only semaphores that are not mutexes can be taken more than once. */
+        configASSERT( pxQueue->uxItemSize == ( UBaseType_t ) 0U );
+        configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+        /* See the comments in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) queueENTER_CRITICAL_FROM_ISR( pxQueue );
+        {
+            uxTaken = pxQueue->uxMessagesWaiting;
+
+            if( uxTaken > uxMaxCount )
+            {
+                uxTaken = uxMaxCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Cannot block in an ISR, so only take the units available. */
+            if( uxTaken > ( UBaseType_t ) 0 )
+            {
+                int8_t cRxLock = pxQueue->cRxLock;
+                UBaseType_t ux;
+
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+                pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxTaken );
+
+                if( cRxLock == queueUNLOCKED )
+                {
+                    if( prvUnblockSenders( pxQueue, uxTaken ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    for( ux = 0; ux < uxTaken; ux++ )
+                    {
+                        prvIncrementQueueRxLock( pxQueue, cRxLock );
+                        cRxLock = pxQueue->cRxLock;
+                    }
+                }
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueue );
+
+        traceRETURN_uxQueueSemaphoreTakeMultipleFromISR( uxTaken );
+
+        return uxTaken;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    traceENTER_uxQueueMessagesWaiting( xQueue );
+
+    configASSERT( xQueue );
+
+    queueENTER_CRITICAL( ( Queue_t * ) xQueue );
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+
+        #if ( configUSE_MUTEX_FAST_PATH == 1 )
+        {
+            /* A mutex held without entering the kernel is still recorded as
+             * available in its semaphore count. */
+            if( queueMUTEX_IS_HELD_WITHOUT_KERNEL( ( Queue_t * ) xQueue ) != pdFALSE )
+            {
+                uxReturn = ( UBaseType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+    }
+    queueEXIT_CRITICAL( ( Queue_t * ) xQueue );
+
+    traceRETURN_uxQueueMessagesWaiting( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueSpacesAvailable( xQueue );
+
+    configASSERT( pxQueue );
+
+    queueENTER_CRITICAL( pxQueue );
+    {
+        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+
+        #if ( configUSE_MUTEX_FAST_PATH == 1 )
+        {
+            /* As in uxQueueMessagesWaiting(), a mutex held without entering
+             * the kernel is still recorded as available in its semaphore
+             * count, so report the space the kernel would have. */
+            if( queueMUTEX_IS_HELD_WITHOUT_KERNEL( pxQueue ) != pdFALSE )
+            {
+                uxReturn = pxQueue->uxLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        #if ( configUSE_RW_LOCKS == 1 )
+        {
+            /* The semaphore count of a reader-writer lock is the number of
+             * readers, which can exceed its length, so report whether the lock
+             * could be taken for writing instead. */
+            if( queueIS_RW_LOCK( pxQueue ) != pdFALSE )
+            {
+                if( queueRW_LOCK_CAN_BE_TAKEN( pxQueue, pdTRUE ) != pdFALSE )
+                {
+                    uxReturn = pxQueue->uxLength;
+                }
+                else
+                {
+                    uxReturn = ( UBaseType_t ) 0;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+    }
+    queueEXIT_CRITICAL( pxQueue );
+
+    traceRETURN_uxQueueSpacesAvailable( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_uxQueueMessagesWaitingFromISR( xQueue );
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    #if ( configUSE_MUTEX_FAST_PATH == 1 )
+    {
+        if( queueMUTEX_IS_HELD_WITHOUT_KERNEL( pxQueue ) != pdFALSE )
+        {
+            uxReturn = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
+
+    traceRETURN_uxQueueMessagesWaitingFromISR( uxReturn );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_vQueueDelete( xQueue );
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+    traceRETURN_vQueueDelete();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        traceENTER_uxQueueGetQueueNumber( xQueue );
+
+        traceRETURN_uxQueueGetQueueNumber( ( ( Queue_t * ) xQueue )->uxQueueNumber );
+
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+
+        traceRETURN_vQueueSetQueueNumber();
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        traceENTER_ucQueueGetQueueType( xQueue );
+
+        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueItemSize( xQueue );
+
+    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
+
+    return ( ( Queue_t * ) xQueue )->uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+{
+    traceENTER_uxQueueGetQueueLength( xQueue );
+
+    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+
+    return ( ( Queue_t * ) xQueue )->uxLength;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
+{
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
+
+    /* This function is called from a critical section. */
+
+    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            {
+                /* The mutex is no longer being held. */
+                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MUTEXES */
+    }
+    else if( xPosition == queueSEND_TO_BACK )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+
+        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
+        {
+            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xPosition == queueOVERWRITE )
+        {
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* An item is not being added but overwritten, so subtract
+                 * one from the recorded number of items in the queue so when
+                 * one is added again below the number of recorded items remains
+                 * correct. */
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+    {
+        /* A queue set has no storage area.  Its events are held in its ready
+         * list, which is only ever empty when the set holds no events, and
+         * this function is only called when the queue holds at least one
+         * item. */
+        if( pxQueue->pxFirstReadyMember != NULL )
+        {
+            prvTakeFromReadyList( pxQueue, pvBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_QUEUE_SET_READY_LIST */
+
+    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    {
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                     const uint8_t * pucItems,
+                                     const UBaseType_t uxItemCount )
+    {
+        size_t xBytesToCopy = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        size_t xFirstLength;
+
+        /* This function is called from a critical section. */
+
+        /* Copy as much as will fit before the end of the storage area, then
+         * wrap around to the start for the rest. */
+        xFirstLength = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+        if( xFirstLength > xBytesToCopy )
+        {
+            xFirstLength = xBytesToCopy;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pucItems, xFirstLength );
+        xBytesToCopy -= xFirstLength;
+
+        if( xBytesToCopy > ( size_t ) 0 )
+        {
+            ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pucItems[ xFirstLength ] ), xBytesToCopy );
+            pxQueue->pcWriteTo = pxQueue->pcHead + xBytesToCopy;
+        }
+        else
+        {
+            pxQueue->pcWriteTo += xFirstLength;
+
+            if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->pcWriteTo = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxItemCount );
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                       uint8_t * pucBuffer,
+                                       const UBaseType_t uxItemCount )
+    {
+        size_t xBytesToCopy = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        size_t xFirstLength;
+        int8_t * pcFirstItem;
+
+        /* This function is called from a critical section. */
+
+        /* pcReadFrom points to the last item read, so the first item to copy
+         * out is the one after it. */
+        pcFirstItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+
+        if( pcFirstItem >= pxQueue->u.xQueue.pcTail )
+        {
+            pcFirstItem = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xFirstLength = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcFirstItem );
+
+        if( xFirstLength > xBytesToCopy )
+        {
+            xFirstLength = xBytesToCopy;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pucBuffer, ( const void * ) pcFirstItem, xFirstLength );
+        xBytesToCopy -= xFirstLength;
+
+        if( xBytesToCopy > ( size_t ) 0 )
+        {
+            ( void ) memcpy( ( void * ) &( pucBuffer[ xFirstLength ] ), ( const void * ) pxQueue->pcHead, xBytesToCopy );
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( xBytesToCopy - ( size_t ) pxQueue->uxItemSize );
+        }
+        else
+        {
+            pxQueue->u.xQueue.pcReadFrom = pcFirstItem + ( xFirstLength - ( size_t ) pxQueue->uxItemSize );
+        }
+
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxItemCount );
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue,
+                                           const UBaseType_t uxItemCount )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t ux;
+
+        /* This function is called from a critical section. */
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            if( pxQueue->pxQueueSetContainer != NULL )
+            {
+                /* The queue set holds one entry per item in its member
+                 * queues, so post the queue's handle once per item. */
+                for( ux = 0; ux < uxItemCount; ux++ )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        xHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+        #endif /* configUSE_QUEUE_SETS */
+        {
+            /* Each item can satisfy one waiting task. */
+            for( ux = 0; ( ux < uxItemCount ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ); ux++ )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_BATCH_OPERATIONS == 1 )
+
+    static BaseType_t prvUnblockSenders( Queue_t * const pxQueue,
+                                         const UBaseType_t uxItemCount )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        UBaseType_t ux;
+
+        /* This function is called from a critical section. */
+
+        /* Each free space can satisfy one waiting task. */
+        for( ux = 0; ( ux < uxItemCount ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ); ux++ )
+        {
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+            {
+                xHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+
+#endif /* configUSE_QUEUE_BATCH_OPERATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    static void prvEnterCriticalWhenUnlocked( Queue_t * const pxQueue )
     {
-        traceENTER_vQueueSetQueueNumber( xQueue, uxQueueNumber );
+        queueENTER_CRITICAL( pxQueue );
 
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+        while( ( pxQueue->cRxLock != queueUNLOCKED ) || ( pxQueue->cTxLock != queueUNLOCKED ) )
+        {
+            queueEXIT_CRITICAL( pxQueue );
 
-        traceRETURN_vQueueSetQueueNumber();
+            /* A queue is only locked while the task that locked it holds the
+             * scheduler suspended, so suspending the scheduler here waits for
+             * that task to resume the scheduler, by which time it has unlocked
+             * the queue again. */
+            vTaskSuspendAll();
+            ( void ) xTaskResumeAll();
+
+            queueENTER_CRITICAL( pxQueue );
+        }
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_GRANULAR_LOCKS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+static void prvUnlockQueue( Queue_t * const pxQueue )
+{
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    /* The lock counts contains the number of extra data items placed or
+     * removed from the queue while the queue was locked.  When a queue is
+     * locked items can be added or removed, but the event lists cannot be
+     * updated. */
+    queueENTER_CRITICAL( pxQueue );
     {
-        traceENTER_ucQueueGetQueueType( xQueue );
+        int8_t cTxLock = pxQueue->cTxLock;
 
-        traceRETURN_ucQueueGetQueueType( ( ( Queue_t * ) xQueue )->ucQueueType );
+        /* See if data was added to the queue while it was locked. */
+        while( cTxLock > queueLOCKED_UNMODIFIED )
+        {
+            /* Data was posted while the queue was locked.  Are any tasks
+             * blocked waiting for data to become available? */
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                if( pxQueue->pxQueueSetContainer != NULL )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        /* The queue is a member of a queue set, and posting to
+                         * the queue set caused a higher priority task to unblock.
+                         * A context switch is required. */
+                        vTaskMissedYield();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* Tasks that are removed from the event list will get
+                     * added to the pending ready list as the scheduler is still
+                     * suspended. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            vTaskMissedYield();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+            }
+            #else /* configUSE_QUEUE_SETS */
+            {
+                /* Tasks that are removed from the event list will get added to
+                 * the pending ready list as the scheduler is still suspended. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority so record that
+                         * a context switch is required. */
+                        vTaskMissedYield();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    break;
+                }
+            }
+            #endif /* configUSE_QUEUE_SETS */
 
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+            --cTxLock;
+        }
+
+        pxQueue->cTxLock = queueUNLOCKED;
     }
+    queueEXIT_CRITICAL( pxQueue );
 
-#endif /* configUSE_TRACE_FACILITY */
+    /* Do the same for the Rx lock. */
+    queueENTER_CRITICAL( pxQueue );
+    {
+        int8_t cRxLock = pxQueue->cRxLock;
+
+        while( cRxLock > queueLOCKED_UNMODIFIED )
+        {
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    vTaskMissedYield();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --cRxLock;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        pxQueue->cRxLock = queueUNLOCKED;
+    }
+    queueEXIT_CRITICAL( pxQueue );
+}
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+static BaseType_t prvIsQueueEmpty( Queue_t * pxQueue )
 {
-    traceENTER_uxQueueGetQueueItemSize( xQueue );
+    BaseType_t xReturn;
 
-    traceRETURN_uxQueueGetQueueItemSize( ( ( Queue_t * ) xQueue )->uxItemSize );
+    queueENTER_CRITICAL( pxQueue );
+    {
+        if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) || ( queueCAN_READ( pxQueue ) == pdFALSE ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    queueEXIT_CRITICAL( pxQueue );
 
-    return ( ( Queue_t * ) xQueue )->uxItemSize;
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueGetQueueLength( QueueHandle_t xQueue ) /* PRIVILEGED_FUNCTION */
+BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 {
-    traceENTER_uxQueueGetQueueLength( xQueue );
+    BaseType_t xReturn;
+    Queue_t * const pxQueue = xQueue;
 
-    traceRETURN_uxQueueGetQueueLength( ( ( Queue_t * ) xQueue )->uxLength );
+    traceENTER_xQueueIsQueueEmptyFromISR( xQueue );
 
-    return ( ( Queue_t * ) xQueue )->uxLength;
+    configASSERT( pxQueue );
+
+    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    traceRETURN_xQueueIsQueueEmptyFromISR( xReturn );
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+static BaseType_t prvIsQueueFull( Queue_t * pxQueue )
+{
+    BaseType_t xReturn;
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    queueENTER_CRITICAL( pxQueue );
     {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+        if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) || ( queueCAN_WRITE( pxQueue ) == pdFALSE ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    queueEXIT_CRITICAL( pxQueue );
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
+{
+    BaseType_t xReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueIsQueueFullFromISR( xQueue );
+
+    configASSERT( pxQueue );
+
+    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    traceRETURN_xQueueIsQueueFullFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+    BaseType_t xQueueCRSend( QueueHandle_t xQueue,
+                             const void * pvItemToQueue,
+                             TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueCRSend( xQueue, pvItemToQueue, xTicksToWait );
+
+        /* If the queue is already full we may have to block.  A critical section
+         * is required to prevent an interrupt removing something from the queue
+         * between the check to see if the queue is full and blocking on the queue. */
+        portDISABLE_INTERRUPTS();
         {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) ( ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            {
+                /* The queue is full - do we want to block or just leave without
+                 * posting? */
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    /* As this is called from a coroutine we cannot block directly, but
+                     * return indicating that we need to block. */
+                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_BLOCKED;
+                }
+                else
+                {
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_FULL;
+                }
+            }
         }
-        else
+        portENABLE_INTERRUPTS();
+
+        portDISABLE_INTERRUPTS();
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            {
+                /* There is room in the queue, copy the data into the queue. */
+                prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+                xReturn = pdPASS;
+
+                /* Were any co-routines waiting for data to become available? */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    /* In this instance the co-routine could be placed directly
+                     * into the ready list as we are within a critical section.
+                     * Instead the same pending ready list mechanism is used as if
+                     * the event were caused from within an interrupt. */
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The co-routine waiting has a higher priority so record
+                         * that a yield might be appropriate. */
+                        xReturn = errQUEUE_YIELD;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = errQUEUE_FULL;
+            }
         }
+        portENABLE_INTERRUPTS();
 
-        return uxHighestPriorityOfWaitingTasks;
+        traceRETURN_xQueueCRSend( xReturn );
+
+        return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_CO_ROUTINES */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
-{
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
+#if ( configUSE_CO_ROUTINES == 1 )
 
-    /* This function is called from a critical section. */
+    BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
+                                void * pvBuffer,
+                                TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
 
-    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        traceENTER_xQueueCRReceive( xQueue, pvBuffer, xTicksToWait );
 
-    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
-    {
-        #if ( configUSE_MUTEXES == 1 )
+        /* If the queue is already empty we may have to block.  A critical section
+         * is required to prevent an interrupt adding something to the queue
+         * between the check to see if the queue is empty and blocking on the queue. */
+        portDISABLE_INTERRUPTS();
         {
-            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
             {
-                /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                /* There are no messages in the queue, do we want to block or just
+                 * leave with nothing? */
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    /* As this is a co-routine we cannot block directly, but return
+                     * indicating that we need to block. */
+                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_BLOCKED;
+                }
+                else
+                {
+                    portENABLE_INTERRUPTS();
+                    return errQUEUE_FULL;
+                }
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_MUTEXES */
-    }
-    else if( xPosition == queueSEND_TO_BACK )
-    {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;
+        portENABLE_INTERRUPTS();
 
-        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
-        {
-            pxQueue->pcWriteTo = pxQueue->pcHead;
-        }
-        else
+        portDISABLE_INTERRUPTS();
         {
-            mtCOVERAGE_TEST_MARKER();
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* Data is available from the queue. */
+                pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+                if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+                {
+                    pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --( pxQueue->uxMessagesWaiting );
+                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+
+                xReturn = pdPASS;
+
+                /* Were any co-routines waiting for space to become available? */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    /* In this instance the co-routine could be placed directly
+                     * into the ready list as we are within a critical section.
+                     * Instead the same pending ready list mechanism is used as if
+                     * the event were caused from within an interrupt. */
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        xReturn = errQUEUE_YIELD;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
         }
+        portENABLE_INTERRUPTS();
+
+        traceRETURN_xQueueCRReceive( xReturn );
+
+        return xReturn;
     }
-    else
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+    BaseType_t xQueueCRSendFromISR( QueueHandle_t xQueue,
+                                    const void * pvItemToQueue,
+                                    BaseType_t xCoRoutinePreviouslyWoken )
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
-        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+        Queue_t * const pxQueue = xQueue;
 
-        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead )
-        {
-            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        traceENTER_xQueueCRSendFromISR( xQueue, pvItemToQueue, xCoRoutinePreviouslyWoken );
 
-        if( xPosition == queueOVERWRITE )
+        /* Cannot block within an ISR so if there is no space on the queue then
+         * exit without doing anything. */
+        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
         {
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+
+            /* We only want to wake one co-routine per ISR, so check that a
+             * co-routine has not already been woken. */
+            if( xCoRoutinePreviouslyWoken == pdFALSE )
             {
-                /* An item is not being added but overwritten, so subtract
-                 * one from the recorded number of items in the queue so when
-                 * one is added again below the number of recorded items remains
-                 * correct. */
-                --uxMessagesWaiting;
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        return pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
@@ -2462,62 +5931,52 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
 
-    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting + ( UBaseType_t ) 1 );
+        traceRETURN_xQueueCRSendFromISR( xCoRoutinePreviouslyWoken );
 
-    return xReturn;
-}
+        return xCoRoutinePreviouslyWoken;
+    }
+
+#endif /* configUSE_CO_ROUTINES */
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue,
-                                  void * const pvBuffer )
-{
-    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+#if ( configUSE_CO_ROUTINES == 1 )
+
+    BaseType_t xQueueCRReceiveFromISR( QueueHandle_t xQueue,
+                                       void * pvBuffer,
+                                       BaseType_t * pxCoRoutineWoken )
     {
-        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
 
-        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
-        {
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        traceENTER_xQueueCRReceiveFromISR( xQueue, pvBuffer, pxCoRoutineWoken );
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize );
-    }
-}
-/*-----------------------------------------------------------*/
+        /* We cannot block from an ISR, so check there is data available. If
+         * not then just leave without doing anything. */
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            /* Copy the data from the queue. */
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
 
-static void prvUnlockQueue( Queue_t * const pxQueue )
-{
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    /* The lock counts contains the number of extra data items placed or
-     * removed from the queue while the queue was locked.  When a queue is
-     * locked items can be added or removed, but the event lists cannot be
-     * updated. */
-    taskENTER_CRITICAL();
-    {
-        int8_t cTxLock = pxQueue->cTxLock;
+            --( pxQueue->uxMessagesWaiting );
+            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
 
-        /* See if data was added to the queue while it was locked. */
-        while( cTxLock > queueLOCKED_UNMODIFIED )
-        {
-            /* Data was posted while the queue was locked.  Are any tasks
-             * blocked waiting for data to become available? */
-            #if ( configUSE_QUEUE_SETS == 1 )
+            if( ( *pxCoRoutineWoken ) == pdFALSE )
             {
-                if( pxQueue->pxQueueSetContainer != NULL )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
-                        /* The queue is a member of a queue set, and posting to
-                         * the queue set caused a higher priority task to unblock.
-                         * A context switch is required. */
-                        vTaskMissedYield();
+                        *pxCoRoutineWoken = pdTRUE;
                     }
                     else
                     {
@@ -2526,336 +5985,441 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                 }
                 else
                 {
-                    /* Tasks that are removed from the event list will get
-                     * added to the pending ready list as the scheduler is still
-                     * suspended. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                    {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            vTaskMissedYield();
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        break;
-                    }
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-            #else /* configUSE_QUEUE_SETS */
+            else
             {
-                /* Tasks that are removed from the event list will get added to
-                 * the pending ready list as the scheduler is still suspended. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority so record that
-                         * a context switch is required. */
-                        vTaskMissedYield();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    break;
-                }
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* configUSE_QUEUE_SETS */
 
-            --cTxLock;
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
         }
 
-        pxQueue->cTxLock = queueUNLOCKED;
+        traceRETURN_xQueueCRReceiveFromISR( xReturn );
+
+        return xReturn;
     }
-    taskEXIT_CRITICAL();
 
-    /* Do the same for the Rx lock. */
-    taskENTER_CRITICAL();
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    void vQueueAddToRegistry( QueueHandle_t xQueue,
+                              const char * pcQueueName )
     {
-        int8_t cRxLock = pxQueue->cRxLock;
+        UBaseType_t ux;
+        QueueRegistryItem_t * pxEntryToWrite = NULL;
 
-        while( cRxLock > queueLOCKED_UNMODIFIED )
+        traceENTER_vQueueAddToRegistry( xQueue, pcQueueName );
+
+        configASSERT( xQueue );
+
+        if( pcQueueName != NULL )
         {
-            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            /* See if there is an empty space in the registry.  A NULL name denotes
+             * a free slot. */
+            for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
             {
-                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                /* Replace an existing entry if the queue is already in the registry. */
+                if( xQueue == xQueueRegistry[ ux ].xHandle )
                 {
-                    vTaskMissedYield();
+                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
+                    break;
+                }
+                /* Otherwise, store in the next empty location */
+                else if( ( pxEntryToWrite == NULL ) && ( xQueueRegistry[ ux ].pcQueueName == NULL ) )
+                {
+                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+            }
+        }
 
-                --cRxLock;
+        if( pxEntryToWrite != NULL )
+        {
+            /* Store the information on this queue. */
+            pxEntryToWrite->pcQueueName = pcQueueName;
+            pxEntryToWrite->xHandle = xQueue;
+
+            traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+        }
+
+        traceRETURN_vQueueAddToRegistry();
+    }
+
+#endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+    const char * pcQueueGetName( QueueHandle_t xQueue )
+    {
+        UBaseType_t ux;
+        const char * pcReturn = NULL;
+
+        traceENTER_pcQueueGetName( xQueue );
+
+        configASSERT( xQueue );
+
+        /* Note there is nothing here to protect against another task adding or
+         * removing entries from the registry while it is being searched. */
+
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        {
+            if( xQueueRegistry[ ux ].xHandle == xQueue )
+            {
+                pcReturn = xQueueRegistry[ ux ].pcQueueName;
+                break;
             }
             else
             {
-                break;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
 
-        pxQueue->cRxLock = queueUNLOCKED;
+        traceRETURN_pcQueueGetName( pcReturn );
+
+        return pcReturn;
     }
-    taskEXIT_CRITICAL();
-}
+
+#endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
-{
-    BaseType_t xReturn;
+#if ( configQUEUE_REGISTRY_SIZE > 0 )
 
-    taskENTER_CRITICAL();
+    void vQueueUnregisterQueue( QueueHandle_t xQueue )
     {
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
-        {
-            xReturn = pdTRUE;
-        }
-        else
+        UBaseType_t ux;
+
+        traceENTER_vQueueUnregisterQueue( xQueue );
+
+        configASSERT( xQueue );
+
+        /* See if the handle of the queue being unregistered in actually in the
+         * registry. */
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
         {
-            xReturn = pdFALSE;
+            if( xQueueRegistry[ ux ].xHandle == xQueue )
+            {
+                /* Set the name to NULL to show that this slot if free again. */
+                xQueueRegistry[ ux ].pcQueueName = NULL;
+
+                /* Set the handle to NULL to ensure the same queue handle cannot
+                 * appear in the registry twice if it is added, removed, then
+                 * added again. */
+                xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) 0;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
+
+        traceRETURN_vQueueUnregisterQueue();
     }
-    taskEXIT_CRITICAL();
 
-    return xReturn;
-}
+#endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
-{
-    BaseType_t xReturn;
-    Queue_t * const pxQueue = xQueue;
+#if ( configUSE_TIMERS == 1 )
 
-    traceENTER_xQueueIsQueueEmptyFromISR( xQueue );
+    void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
+                                         TickType_t xTicksToWait,
+                                         const BaseType_t xWaitIndefinitely )
+    {
+        Queue_t * const pxQueue = xQueue;
 
-    configASSERT( pxQueue );
+        traceENTER_vQueueWaitForMessageRestricted( xQueue, xTicksToWait, xWaitIndefinitely );
 
-    if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
-    {
-        xReturn = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
-    }
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements.
+         * It can result in vListInsert() being called on a list that can only
+         * possibly ever have one item in it, so the list will be fast, but even
+         * so it should be called with the scheduler locked and not from a critical
+         * section. */
 
-    traceRETURN_xQueueIsQueueEmptyFromISR( xReturn );
+        /* Only do anything if there are no messages in the queue.  This function
+         *  will not actually cause the task to block, just place it on a blocked
+         *  list.  It will not block until the scheduler is unlocked - at which
+         *  time a yield will be performed.  If an item is added to the queue while
+         *  the queue is locked, and the calling task blocks on the queue, then the
+         *  calling task will be immediately unblocked when the queue is unlocked. */
+        prvLockQueue( pxQueue );
 
-    return xReturn;
-}
+        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
+        {
+            /* There is nothing in the queue, block for the specified period. */
+            vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvUnlockQueue( pxQueue );
+
+        traceRETURN_vQueueWaitForMessageRestricted();
+    }
+
+#endif /* configUSE_TIMERS */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
-{
-    BaseType_t xReturn;
+#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
+    {
+        QueueSetHandle_t pxQueue;
+
+        traceENTER_xQueueCreateSet( uxEventQueueLength );
 
-    taskENTER_CRITICAL();
-    {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
         {
-            xReturn = pdTRUE;
+            /* The set holds its events in a list of the members that posted
+             * them rather than in a storage area, so it has an item size of
+             * zero and uxEventQueueLength does not limit the number of events
+             * it can hold. */
+            ( void ) uxEventQueueLength;
+            pxQueue = xQueueGenericCreate( queueSET_READY_LIST_LENGTH, ( UBaseType_t ) 0, queueQUEUE_TYPE_SET );
         }
-        else
+        #else
         {
-            xReturn = pdFALSE;
+            pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
         }
-    }
-    taskEXIT_CRITICAL();
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
-{
-    BaseType_t xReturn;
-    Queue_t * const pxQueue = xQueue;
-
-    traceENTER_xQueueIsQueueFullFromISR( xQueue );
+        #endif
 
-    configASSERT( pxQueue );
+        traceRETURN_xQueueCreateSet( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
-    {
-        xReturn = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
+        return pxQueue;
     }
 
-    traceRETURN_xQueueIsQueueFullFromISR( xReturn );
-
-    return xReturn;
-}
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    BaseType_t xQueueCRSend( QueueHandle_t xQueue,
-                             const void * pvItemToQueue,
-                             TickType_t xTicksToWait )
+    BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                               QueueSetHandle_t xQueueSet )
     {
         BaseType_t xReturn;
-        Queue_t * const pxQueue = xQueue;
 
-        traceENTER_xQueueCRSend( xQueue, pvItemToQueue, xTicksToWait );
+        traceENTER_xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
 
-        /* If the queue is already full we may have to block.  A critical section
-         * is required to prevent an interrupt removing something from the queue
-         * between the check to see if the queue is full and blocking on the queue. */
-        portDISABLE_INTERRUPTS();
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            /* A mutex is accessed from the kernel critical section, which
+             * holds the ISR lock.  Notifying the set from there would take the
+             * set's spinlock after the ISR lock, whereas a queue in the same
+             * set takes the ISR lock after the set's spinlock when it unblocks
+             * a task, so mutexes cannot be members of a queue set. */
+            configASSERT( ( ( Queue_t * ) xQueueOrSemaphore )->uxQueueType != queueQUEUE_IS_MUTEX );
+        }
+        #endif
+
+        queueENTER_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
+        {
+            #if ( ( configUSE_MUTEX_FAST_PATH == 1 ) && ( configUSE_GRANULAR_LOCKS == 0 ) )
             {
-                /* The queue is full - do we want to block or just leave without
-                 * posting? */
-                if( xTicksToWait > ( TickType_t ) 0 )
+                /* A mutex that is a member of a set is only used through the
+                 * kernel, so its semaphore count must record whether it is
+                 * held. */
+                if( ( ( Queue_t * ) xQueueOrSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
                 {
-                    /* As this is called from a coroutine we cannot block directly, but
-                     * return indicating that we need to block. */
-                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToSend ) );
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_BLOCKED;
+                    prvMutexEnterKernel( ( Queue_t * ) xQueueOrSemaphore );
                 }
                 else
                 {
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_FULL;
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-        }
-        portENABLE_INTERRUPTS();
+            #endif /* configUSE_MUTEX_FAST_PATH */
 
-        portDISABLE_INTERRUPTS();
-        {
-            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
             {
-                /* There is room in the queue, copy the data into the queue. */
-                prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
-                xReturn = pdPASS;
-
-                /* Were any co-routines waiting for data to become available? */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                {
-                    /* In this instance the co-routine could be placed directly
-                     * into the ready list as we are within a critical section.
-                     * Instead the same pending ready list mechanism is used as if
-                     * the event were caused from within an interrupt. */
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        /* The co-routine waiting has a higher priority so record
-                         * that a yield might be appropriate. */
-                        xReturn = errQUEUE_YIELD;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
+                /* Cannot add a queue/semaphore to more than one queue set. */
+                xReturn = pdFAIL;
+            }
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+                else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxQueueType == queueQUEUE_IS_MUTEX )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Cannot add a mutex to a queue set, see above. */
+                    xReturn = pdFAIL;
                 }
+            #endif
+            else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
+            {
+                /* Cannot add a queue/semaphore to a queue set if there are already
+                 * items in the queue/semaphore. */
+                xReturn = pdFAIL;
             }
             else
             {
-                xReturn = errQUEUE_FULL;
+                ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+                xReturn = pdPASS;
             }
         }
-        portENABLE_INTERRUPTS();
+        queueEXIT_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
 
-        traceRETURN_xQueueCRSend( xReturn );
+        traceRETURN_xQueueAddToSet( xReturn );
 
         return xReturn;
     }
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_QUEUE_SETS == 1 )
 
-    BaseType_t xQueueCRReceive( QueueHandle_t xQueue,
-                                void * pvBuffer,
-                                TickType_t xTicksToWait )
+    BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                    QueueSetHandle_t xQueueSet )
     {
         BaseType_t xReturn;
-        Queue_t * const pxQueue = xQueue;
+        Queue_t * const pxQueueOrSemaphore = ( Queue_t * ) xQueueOrSemaphore;
 
-        traceENTER_xQueueCRReceive( xQueue, pvBuffer, xTicksToWait );
+        traceENTER_xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet );
 
-        /* If the queue is already empty we may have to block.  A critical section
-         * is required to prevent an interrupt adding something to the queue
-         * between the check to see if the queue is empty and blocking on the queue. */
-        portDISABLE_INTERRUPTS();
+        if( pxQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
         {
-            if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+            /* The queue was not a member of the set. */
+            xReturn = pdFAIL;
+        }
+        else if( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 )
+        {
+            /* It is dangerous to remove a queue from a set when the queue is
+             * not empty because the queue set will still hold pending events for
+             * the queue. */
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            queueENTER_CRITICAL( pxQueueOrSemaphore );
             {
-                /* There are no messages in the queue, do we want to block or just
-                 * leave with nothing? */
-                if( xTicksToWait > ( TickType_t ) 0 )
-                {
-                    /* As this is a co-routine we cannot block directly, but return
-                     * indicating that we need to block. */
-                    vCoRoutineAddToDelayedList( xTicksToWait, &( pxQueue->xTasksWaitingToReceive ) );
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_BLOCKED;
-                }
-                else
+                #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
                 {
-                    portENABLE_INTERRUPTS();
-                    return errQUEUE_FULL;
+                    prvRemoveFromReadyList( pxQueueOrSemaphore );
                 }
+                #endif
+
+                /* The queue is no longer contained in the set. */
+                pxQueueOrSemaphore->pxQueueSetContainer = NULL;
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            queueEXIT_CRITICAL( pxQueueOrSemaphore );
+            xReturn = pdPASS;
         }
-        portENABLE_INTERRUPTS();
 
-        portDISABLE_INTERRUPTS();
+        traceRETURN_xQueueRemoveFromSet( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+    QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
+                                                TickType_t const xTicksToWait )
+    {
+        QueueSetMemberHandle_t xReturn = NULL;
+
+        traceENTER_xQueueSelectFromSet( xQueueSet, xTicksToWait );
+
+        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait );
+
+        traceRETURN_xQueueSelectFromSet( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+    QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
+    {
+        QueueSetMemberHandle_t xReturn = NULL;
+
+        traceENTER_xQueueSelectFromSetFromISR( xQueueSet );
+
+        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
+
+        traceRETURN_xQueueSelectFromSetFromISR( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SETS == 1 )
+
+    static BaseType_t prvNotifyQueueSetContainer( Queue_t * const pxQueue )
+    {
+        Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+        BaseType_t xReturn = pdFALSE;
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
+
+        /* This function must be called form a critical section. */
+
+        /* The following line is not reachable in unit tests because every call
+         * to prvNotifyQueueSetContainer is preceded by a check that
+         * pxQueueSetContainer != NULL */
+        configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
         {
-            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
-            {
-                /* Data is available from the queue. */
-                pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+            /* The critical section the caller is in only protects the queue
+             * that is a member of the set, so also enter the set's own critical
+             * section.  The member's spinlock is always taken before the set's,
+             * and the member is never a mutex (see xQueueAddToSet()), so the
+             * ISR lock is not already held here. */
+            uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueueSetContainer );
+        }
+        #endif
 
-                if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
-                {
-                    pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-                --( pxQueue->uxMessagesWaiting );
-                ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        {
+            const int8_t cTxLock = pxQueueSetContainer->cTxLock;
 
-                xReturn = pdPASS;
+            traceQUEUE_SET_SEND( pxQueueSetContainer );
 
-                /* Were any co-routines waiting for space to become available? */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-                {
-                    /* In this instance the co-routine could be placed directly
-                     * into the ready list as we are within a critical section.
-                     * Instead the same pending ready list mechanism is used as if
-                     * the event were caused from within an interrupt. */
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+            #if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+            {
+                /* The queue that contains data is recorded in the set's ready
+                 * list. */
+                prvAddToReadyList( pxQueueSetContainer, pxQueue );
+            }
+            #else
+            {
+                /* The data copied is the handle of the queue that contains data. */
+                xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+            }
+            #endif
+
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
-                        xReturn = errQUEUE_YIELD;
+                        /* The task waiting has a higher priority. */
+                        xReturn = pdTRUE;
                     }
                     else
                     {
@@ -2869,496 +6433,794 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             }
             else
             {
-                xReturn = pdFAIL;
+                prvIncrementQueueTxLock( pxQueueSetContainer, cTxLock );
             }
         }
-        portENABLE_INTERRUPTS();
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        traceRETURN_xQueueCRReceive( xReturn );
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+        {
+            queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueueSetContainer );
+        }
+        #endif
 
         return xReturn;
     }
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_QUEUE_SET_READY_LIST == 1 )
 
-    BaseType_t xQueueCRSendFromISR( QueueHandle_t xQueue,
-                                    const void * pvItemToQueue,
-                                    BaseType_t xCoRoutinePreviouslyWoken )
+    static void prvAddToReadyList( Queue_t * const pxQueueSet,
+                                   Queue_t * const pxQueue )
     {
-        Queue_t * const pxQueue = xQueue;
+        /* This function must be called from the queue set's critical section.
+         * A member is only in the ready list while it has events pending, so
+         * it is appended when its first event is posted. */
+        if( pxQueue->uxSetEventsPending == ( UBaseType_t ) 0U )
+        {
+            if( pxQueueSet->pxLastReadyMember == NULL )
+            {
+                pxQueueSet->pxFirstReadyMember = pxQueue;
+            }
+            else
+            {
+                pxQueueSet->pxLastReadyMember->pxNextReadyMember = pxQueue;
+            }
 
-        traceENTER_xQueueCRSendFromISR( xQueue, pvItemToQueue, xCoRoutinePreviouslyWoken );
+            pxQueueSet->pxLastReadyMember = pxQueue;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        /* Cannot block within an ISR so if there is no space on the queue then
-         * exit without doing anything. */
-        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+        ( pxQueue->uxSetEventsPending )++;
+        pxQueueSet->uxMessagesWaiting = ( UBaseType_t ) ( pxQueueSet->uxMessagesWaiting + ( UBaseType_t ) 1 );
+    }
+
+#endif /* configUSE_QUEUE_SET_READY_LIST */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_READY_LIST == 1 )
+
+    static void prvTakeFromReadyList( Queue_t * const pxQueueSet,
+                                      void * const pvBuffer )
+    {
+        Queue_t * const pxQueue = pxQueueSet->pxFirstReadyMember;
+
+        /* This function must be called from the queue set's critical section.
+         * The caller is responsible for decrementing uxMessagesWaiting. */
+        ( void ) memcpy( pvBuffer, ( const void * ) &pxQueue, sizeof( pxQueue ) );
+
+        ( pxQueue->uxSetEventsPending )--;
+
+        if( pxQueue->uxSetEventsPending == ( UBaseType_t ) 0U )
         {
-            prvCopyDataToQueue( pxQueue, pvItemToQueue, queueSEND_TO_BACK );
+            /* The member has no more events pending, so leaves the list. */
+            pxQueueSet->pxFirstReadyMember = pxQueue->pxNextReadyMember;
+            pxQueue->pxNextReadyMember = NULL;
 
-            /* We only want to wake one co-routine per ISR, so check that a
-             * co-routine has not already been woken. */
-            if( xCoRoutinePreviouslyWoken == pdFALSE )
+            if( pxQueueSet->pxFirstReadyMember == NULL )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                {
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        return pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                pxQueueSet->pxLastReadyMember = NULL;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+        else if( pxQueue->pxNextReadyMember != NULL )
+        {
+            /* The member still has events pending so goes to the back of the
+             * list, so a member that receives data in a burst is selected in
+             * turn with the other members rather than ahead of them. */
+            pxQueueSet->pxFirstReadyMember = pxQueue->pxNextReadyMember;
+            pxQueue->pxNextReadyMember = NULL;
+            pxQueueSet->pxLastReadyMember->pxNextReadyMember = pxQueue;
+            pxQueueSet->pxLastReadyMember = pxQueue;
+        }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        traceRETURN_xQueueCRSendFromISR( xCoRoutinePreviouslyWoken );
-
-        return xCoRoutinePreviouslyWoken;
     }
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* configUSE_QUEUE_SET_READY_LIST */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_CO_ROUTINES == 1 )
+#if ( configUSE_QUEUE_SET_READY_LIST == 1 )
 
-    BaseType_t xQueueCRReceiveFromISR( QueueHandle_t xQueue,
-                                       void * pvBuffer,
-                                       BaseType_t * pxCoRoutineWoken )
+    static void prvRemoveFromReadyList( Queue_t * const pxQueue )
     {
-        BaseType_t xReturn;
-        Queue_t * const pxQueue = xQueue;
+        Queue_t * const pxQueueSet = pxQueue->pxQueueSetContainer;
+        Queue_t * pxPrevious = NULL;
+        Queue_t * pxMember;
 
-        traceENTER_xQueueCRReceiveFromISR( xQueue, pvBuffer, pxCoRoutineWoken );
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+            UBaseType_t uxSavedInterruptStatus;
+        #endif
 
-        /* We cannot block from an ISR, so check there is data available. If
-         * not then just leave without doing anything. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        /* This function must be called from the member's critical section. */
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
         {
-            /* Copy the data from the queue. */
-            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+            /* As in prvNotifyQueueSetContainer(), the member's spinlock is
+             * taken before the set's.  xQueueAddToSet() does not accept
+             * mutexes, so the caller never holds the kernel critical section
+             * and with it the ISR lock, which must be taken after the set's
+             * spinlock. */
+            configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+            uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueueSet );
+        }
+        #endif
 
-            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+        if( pxQueue->uxSetEventsPending != ( UBaseType_t ) 0U )
+        {
+            /* The list is only searched when the member is known to be in it,
+             * and members are rarely removed from a set. */
+            pxMember = pxQueueSet->pxFirstReadyMember;
+
+            while( pxMember != pxQueue )
             {
-                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                pxPrevious = pxMember;
+                pxMember = pxMember->pxNextReadyMember;
+            }
+
+            if( pxPrevious == NULL )
+            {
+                pxQueueSet->pxFirstReadyMember = pxQueue->pxNextReadyMember;
+            }
+            else
+            {
+                pxPrevious->pxNextReadyMember = pxQueue->pxNextReadyMember;
+            }
+
+            if( pxQueueSet->pxLastReadyMember == pxQueue )
+            {
+                pxQueueSet->pxLastReadyMember = pxPrevious;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            --( pxQueue->uxMessagesWaiting );
-            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( unsigned ) pxQueue->uxItemSize );
+            /* Discard the events the member posted that were never selected. */
+            pxQueueSet->uxMessagesWaiting = ( UBaseType_t ) ( pxQueueSet->uxMessagesWaiting - pxQueue->uxSetEventsPending );
+            pxQueue->uxSetEventsPending = ( UBaseType_t ) 0U;
+            pxQueue->pxNextReadyMember = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            if( ( *pxCoRoutineWoken ) == pdFALSE )
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+        {
+            queueEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxQueueSet );
+        }
+        #endif
+    }
+
+#endif /* configUSE_QUEUE_SET_READY_LIST */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MPMC_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    MpmcQueueHandle_t xMpmcQueueCreate( const UBaseType_t uxQueueLength,
+                                        const UBaseType_t uxItemSize )
+    {
+        MpmcQueue_t * pxNewQueue = NULL;
+        size_t xQueueSizeInBytes;
+        uint8_t * pucQueueStorage;
+
+        traceENTER_xMpmcQueueCreate( uxQueueLength, uxItemSize );
+
+        if( ( uxQueueLength > ( UBaseType_t ) 1 ) &&
+            /* The sequence numbers only wrap correctly if the length is a
+             * power of two. */
+            ( ( uxQueueLength & ( uxQueueLength - 1U ) ) == 0U ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            /* Check for addition and multiplication overflow. */
+            ( ( ( ( SIZE_MAX - sizeof( MpmcQueue_t ) ) / uxQueueLength ) - sizeof( uint32_t ) ) >= ( size_t ) uxItemSize ) )
+        {
+            /* Each slot needs a sequence number as well as space for an item. */
+            xQueueSizeInBytes = ( size_t ) uxQueueLength * ( sizeof( uint32_t ) + ( size_t ) uxItemSize );
+
+            /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxNewQueue = ( MpmcQueue_t * ) pvPortMalloc( sizeof( MpmcQueue_t ) + xQueueSizeInBytes );
+
+            if( pxNewQueue != NULL )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
-                {
-                    if( xCoRoutineRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        *pxCoRoutineWoken = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
+                /* Jump past the queue structure to find the location of the
+                 * sequence numbers, which are followed by the items. */
+                pucQueueStorage = ( uint8_t * ) pxNewQueue;
+                pucQueueStorage += sizeof( MpmcQueue_t );
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Queues can be created either statically or dynamically,
+                     * so note this queue was created dynamically in case it is
+                     * later deleted. */
+                    pxNewQueue->ucStaticallyAllocated = pdFALSE;
                 }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                prvInitialiseNewMpmcQueue( uxQueueLength, uxItemSize, pucQueueStorage, pxNewQueue );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-
-            xReturn = pdPASS;
         }
         else
         {
-            xReturn = pdFAIL;
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xQueueCRReceiveFromISR( xReturn );
+        traceRETURN_xMpmcQueueCreate( pxNewQueue );
 
-        return xReturn;
+        return pxNewQueue;
     }
 
-#endif /* configUSE_CO_ROUTINES */
+#endif /* ( ( configUSE_MPMC_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( ( configUSE_MPMC_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-    void vQueueAddToRegistry( QueueHandle_t xQueue,
-                              const char * pcQueueName )
+    MpmcQueueHandle_t xMpmcQueueCreateStatic( const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              uint8_t * pucQueueStorage,
+                                              StaticMpmcQueue_t * pxStaticQueue )
     {
-        UBaseType_t ux;
-        QueueRegistryItem_t * pxEntryToWrite = NULL;
+        MpmcQueue_t * pxNewQueue = NULL;
 
-        traceENTER_vQueueAddToRegistry( xQueue, pcQueueName );
+        traceENTER_xMpmcQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue );
 
-        configASSERT( xQueue );
+        /* The StaticMpmcQueue_t structure and the queue storage area must be
+         * supplied, and the storage area must be suitably aligned to hold the
+         * sequence numbers. */
+        configASSERT( pxStaticQueue );
+        configASSERT( pucQueueStorage );
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucQueueStorage ) & ( ( portPOINTER_SIZE_TYPE ) sizeof( uint32_t ) - 1U ) ) == 0U );
 
-        if( pcQueueName != NULL )
+        if( ( uxQueueLength > ( UBaseType_t ) 1 ) &&
+            ( ( uxQueueLength & ( uxQueueLength - 1U ) ) == 0U ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            ( pxStaticQueue != NULL ) &&
+            ( pucQueueStorage != NULL ) )
         {
-            /* See if there is an empty space in the registry.  A NULL name denotes
-             * a free slot. */
-            for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+            #if ( configASSERT_DEFINED == 1 )
             {
-                /* Replace an existing entry if the queue is already in the registry. */
-                if( xQueue == xQueueRegistry[ ux ].xHandle )
-                {
-                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
-                    break;
-                }
-                /* Otherwise, store in the next empty location */
-                else if( ( pxEntryToWrite == NULL ) && ( xQueueRegistry[ ux ].pcQueueName == NULL ) )
-                {
-                    pxEntryToWrite = &( xQueueRegistry[ ux ] );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticMpmcQueue_t equals the size of the real
+                 * queue structure. */
+                volatile size_t xSize = sizeof( StaticMpmcQueue_t );
+
+                /* This assertion cannot be branch covered in unit tests */
+                configASSERT( xSize == sizeof( MpmcQueue_t ) ); /* LCOV_EXCL_BR_LINE */
+                ( void ) xSize;                                 /* Prevent unused variable warning when configASSERT() is not defined. */
             }
-        }
+            #endif /* configASSERT_DEFINED */
 
-        if( pxEntryToWrite != NULL )
-        {
-            /* Store the information on this queue. */
-            pxEntryToWrite->pcQueueName = pcQueueName;
-            pxEntryToWrite->xHandle = xQueue;
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewQueue = ( MpmcQueue_t * ) pxStaticQueue;
 
-            traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* Queues can be allocated either statically or dynamically, so
+                 * note this queue was allocated statically in case the queue
+                 * is later deleted. */
+                pxNewQueue->ucStaticallyAllocated = pdTRUE;
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+            prvInitialiseNewMpmcQueue( uxQueueLength, uxItemSize, pucQueueStorage, pxNewQueue );
+        }
+        else
+        {
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vQueueAddToRegistry();
+        traceRETURN_xMpmcQueueCreateStatic( pxNewQueue );
+
+        return pxNewQueue;
     }
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+#endif /* ( ( configUSE_MPMC_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    const char * pcQueueGetName( QueueHandle_t xQueue )
+    static void prvInitialiseNewMpmcQueue( const UBaseType_t uxQueueLength,
+                                           const UBaseType_t uxItemSize,
+                                           uint8_t * pucQueueStorage,
+                                           MpmcQueue_t * pxNewQueue )
     {
-        UBaseType_t ux;
-        const char * pcReturn = NULL;
+        UBaseType_t uxSlot;
+
+        /* The sequence numbers are held at the start of the storage area,
+         * followed by the items. */
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        pxNewQueue->pulSequence = ( volatile uint32_t * ) pucQueueStorage;
+        pxNewQueue->pucStorage = pucQueueStorage + ( ( size_t ) uxQueueLength * sizeof( uint32_t ) );
+        pxNewQueue->uxLength = uxQueueLength;
+        pxNewQueue->uxItemSize = uxItemSize;
+        pxNewQueue->ulEnqueuePosition = 0U;
+        pxNewQueue->ulDequeuePosition = 0U;
+        pxNewQueue->uxSendersWaiting = ( UBaseType_t ) 0U;
+        pxNewQueue->uxReceiversWaiting = ( UBaseType_t ) 0U;
+
+        /* A slot whose sequence number equals the enqueue position is free to
+         * be written, so initially every slot is free. */
+        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < uxQueueLength; uxSlot++ )
+        {
+            pxNewQueue->pulSequence[ uxSlot ] = ( uint32_t ) uxSlot;
+        }
 
-        traceENTER_pcQueueGetName( xQueue );
+        vListInitialise( &( pxNewQueue->xTasksWaitingToSend ) );
+        vListInitialise( &( pxNewQueue->xTasksWaitingToReceive ) );
+    }
 
-        configASSERT( xQueue );
+#endif /* configUSE_MPMC_QUEUES */
+/*-----------------------------------------------------------*/
 
-        /* Note there is nothing here to protect against another task adding or
-         * removing entries from the registry while it is being searched. */
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+    static BaseType_t prvMpmcQueueTryEnqueue( MpmcQueue_t * const pxQueue,
+                                              const void * const pvItemToQueue )
+    {
+        const uint32_t ulMask = ( uint32_t ) pxQueue->uxLength - 1U;
+        uint32_t ulPosition = pxQueue->ulEnqueuePosition;
+        uint32_t ulSequence;
+        int32_t lDifference;
+        BaseType_t xReturn = pdFAIL;
+
+        for( ; ; )
         {
-            if( xQueueRegistry[ ux ].xHandle == xQueue )
+            ulSequence = pxQueue->pulSequence[ ulPosition & ulMask ];
+            portMEMORY_FENCE();
+            lDifference = ( int32_t ) ( ulSequence - ulPosition );
+
+            if( lDifference == 0 )
             {
-                pcReturn = xQueueRegistry[ ux ].pcQueueName;
+                /* The slot is free.  Try to claim it by advancing the enqueue
+                 * position.  If another producer got there first then try
+                 * again from the position it moved on to. */
+                if( Atomic_CompareAndSwap_u32( &( pxQueue->ulEnqueuePosition ), ulPosition + 1U, ulPosition ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                {
+                    ( void ) memcpy( ( void * ) &( pxQueue->pucStorage[ ( size_t ) ( ulPosition & ulMask ) * ( size_t ) pxQueue->uxItemSize ] ),
+                                     pvItemToQueue,
+                                     ( size_t ) pxQueue->uxItemSize );
+
+                    /* Publish the item to consumers only once it has been
+                     * completely written. */
+                    portMEMORY_FENCE();
+                    pxQueue->pulSequence[ ulPosition & ulMask ] = ulPosition + 1U;
+                    xReturn = pdPASS;
+                    break;
+                }
+                else
+                {
+                    ulPosition = pxQueue->ulEnqueuePosition;
+                }
+            }
+            else if( lDifference < 0 )
+            {
+                /* The slot still holds an item that has not been received, or
+                 * that a consumer is still copying out, so the queue is
+                 * full. */
                 break;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* Another producer claimed the slot after the position was
+                 * read. */
+                ulPosition = pxQueue->ulEnqueuePosition;
             }
         }
 
-        traceRETURN_pcQueueGetName( pcReturn );
-
-        return pcReturn;
+        return xReturn;
     }
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+#endif /* configUSE_MPMC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configQUEUE_REGISTRY_SIZE > 0 )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    void vQueueUnregisterQueue( QueueHandle_t xQueue )
+    static BaseType_t prvMpmcQueueTryDequeue( MpmcQueue_t * const pxQueue,
+                                              void * const pvBuffer )
     {
-        UBaseType_t ux;
-
-        traceENTER_vQueueUnregisterQueue( xQueue );
-
-        configASSERT( xQueue );
-
-        /* See if the handle of the queue being unregistered in actually in the
-         * registry. */
-        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        const uint32_t ulMask = ( uint32_t ) pxQueue->uxLength - 1U;
+        uint32_t ulPosition = pxQueue->ulDequeuePosition;
+        uint32_t ulSequence;
+        int32_t lDifference;
+        BaseType_t xReturn = pdFAIL;
+
+        for( ; ; )
         {
-            if( xQueueRegistry[ ux ].xHandle == xQueue )
-            {
-                /* Set the name to NULL to show that this slot if free again. */
-                xQueueRegistry[ ux ].pcQueueName = NULL;
+            ulSequence = pxQueue->pulSequence[ ulPosition & ulMask ];
+            portMEMORY_FENCE();
+            lDifference = ( int32_t ) ( ulSequence - ( ulPosition + 1U ) );
 
-                /* Set the handle to NULL to ensure the same queue handle cannot
-                 * appear in the registry twice if it is added, removed, then
-                 * added again. */
-                xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) 0;
+            if( lDifference == 0 )
+            {
+                /* The slot holds an item.  Try to claim it by advancing the
+                 * dequeue position. */
+                if( Atomic_CompareAndSwap_u32( &( pxQueue->ulDequeuePosition ), ulPosition + 1U, ulPosition ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                {
+                    ( void ) memcpy( pvBuffer,
+                                     ( void * ) &( pxQueue->pucStorage[ ( size_t ) ( ulPosition & ulMask ) * ( size_t ) pxQueue->uxItemSize ] ),
+                                     ( size_t ) pxQueue->uxItemSize );
+
+                    /* Return the slot to producers, marking it free for the
+                     * producer that reaches it on the next pass around the
+                     * storage area. */
+                    portMEMORY_FENCE();
+                    pxQueue->pulSequence[ ulPosition & ulMask ] = ulPosition + ( uint32_t ) pxQueue->uxLength;
+                    xReturn = pdPASS;
+                    break;
+                }
+                else
+                {
+                    ulPosition = pxQueue->ulDequeuePosition;
+                }
+            }
+            else if( lDifference < 0 )
+            {
+                /* No item has been published to the slot yet, so the queue is
+                 * empty. */
                 break;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* Another consumer claimed the slot after the position was
+                 * read. */
+                ulPosition = pxQueue->ulDequeuePosition;
             }
         }
 
-        traceRETURN_vQueueUnregisterQueue();
+        return xReturn;
     }
 
-#endif /* configQUEUE_REGISTRY_SIZE */
+#endif /* configUSE_MPMC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
-                                         TickType_t xTicksToWait,
-                                         const BaseType_t xWaitIndefinitely )
+    static void prvMpmcQueueWait( MpmcQueue_t * const pxQueue,
+                                  const BaseType_t xWaitingToSend,
+                                  const TickType_t xTicksToWait )
     {
-        Queue_t * const pxQueue = xQueue;
-
-        traceENTER_vQueueWaitForMessageRestricted( xQueue, xTicksToWait, xWaitIndefinitely );
+        List_t * pxEventList;
+        volatile UBaseType_t * puxWaiting;
+        const uint32_t ulMask = ( uint32_t ) pxQueue->uxLength - 1U;
+        uint32_t ulPosition;
+        int32_t lDifference;
+        BaseType_t xMustBlock;
+
+        if( xWaitingToSend != pdFALSE )
+        {
+            pxEventList = &( pxQueue->xTasksWaitingToSend );
+            puxWaiting = &( pxQueue->uxSendersWaiting );
+        }
+        else
+        {
+            pxEventList = &( pxQueue->xTasksWaitingToReceive );
+            puxWaiting = &( pxQueue->uxReceiversWaiting );
+        }
 
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements.
-         * It can result in vListInsert() being called on a list that can only
-         * possibly ever have one item in it, so the list will be fast, but even
-         * so it should be called with the scheduler locked and not from a critical
-         * section. */
+        taskENTER_CRITICAL();
+        {
+            /* Announce the intention to block before checking the queue state
+             * again.  A task that changes the state after the check will then
+             * see the count and unblock this task, and a task that changed
+             * the state before the check will have been seen by it.  That
+             * needs the count to be stored before the sequence number is
+             * loaded, which only a full fence guarantees across cores. */
+            ( *puxWaiting )++;
+            portMEMORY_FENCE();
+
+            if( xWaitingToSend != pdFALSE )
+            {
+                ulPosition = pxQueue->ulEnqueuePosition;
+                lDifference = ( int32_t ) ( pxQueue->pulSequence[ ulPosition & ulMask ] - ulPosition );
+            }
+            else
+            {
+                ulPosition = pxQueue->ulDequeuePosition;
+                lDifference = ( int32_t ) ( pxQueue->pulSequence[ ulPosition & ulMask ] - ( ulPosition + 1U ) );
+            }
 
-        /* Only do anything if there are no messages in the queue.  This function
-         *  will not actually cause the task to block, just place it on a blocked
-         *  list.  It will not block until the scheduler is unlocked - at which
-         *  time a yield will be performed.  If an item is added to the queue while
-         *  the queue is locked, and the calling task blocks on the queue, then the
-         *  calling task will be immediately unblocked when the queue is unlocked. */
-        prvLockQueue( pxQueue );
+            if( lDifference < 0 )
+            {
+                vTaskPlaceOnEventList( pxEventList, xTicksToWait );
+                xMustBlock = pdTRUE;
+            }
+            else
+            {
+                xMustBlock = pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0U )
+        if( xMustBlock != pdFALSE )
         {
-            /* There is nothing in the queue, block for the specified period. */
-            vTaskPlaceOnEventListRestricted( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait, xWaitIndefinitely );
+            taskYIELD_WITHIN_API();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        prvUnlockQueue( pxQueue );
-
-        traceRETURN_vQueueWaitForMessageRestricted();
+        taskENTER_CRITICAL();
+        {
+            ( *puxWaiting )--;
+        }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* configUSE_TIMERS */
+#endif /* configUSE_MPMC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
+    static void prvMpmcQueueUnblockWaiter( List_t * const pxEventList,
+                                           const volatile UBaseType_t * const puxWaiting )
     {
-        QueueSetHandle_t pxQueue;
+        BaseType_t xYieldRequired = pdFALSE;
 
-        traceENTER_xQueueCreateSet( uxEventQueueLength );
-
-        pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+        /* Ensure the update to the sequence number is visible to all cores
+         * before the count of waiting tasks is read - see prvMpmcQueueWait(). */
+        portMEMORY_FENCE();
 
-        traceRETURN_xQueueCreateSet( pxQueue );
+        if( *puxWaiting != ( UBaseType_t ) 0U )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+                {
+                    xYieldRequired = xTaskRemoveFromEventList( pxEventList );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
 
-        return pxQueue;
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_MPMC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    BaseType_t xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
-                               QueueSetHandle_t xQueueSet )
+    BaseType_t xMpmcQueueSend( MpmcQueueHandle_t xQueue,
+                               const void * const pvItemToQueue,
+                               TickType_t xTicksToWait )
     {
+        MpmcQueue_t * const pxQueue = xQueue;
         BaseType_t xReturn;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
 
-        traceENTER_xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
+        traceENTER_xMpmcQueueSend( xQueue, pvItemToQueue, xTicksToWait );
 
-        taskENTER_CRITICAL();
+        configASSERT( pxQueue );
+        configASSERT( pvItemToQueue );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
+        }
+        #endif
+
+        for( ; ; )
+        {
+            if( prvMpmcQueueTryEnqueue( pxQueue, pvItemToQueue ) != pdFAIL )
             {
-                /* Cannot add a queue/semaphore to more than one queue set. */
-                xReturn = pdFAIL;
+                prvMpmcQueueUnblockWaiter( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->uxReceiversWaiting ) );
+                xReturn = pdPASS;
+                break;
             }
-            else if( ( ( Queue_t * ) xQueueOrSemaphore )->uxMessagesWaiting != ( UBaseType_t ) 0 )
+
+            if( xTicksToWait == ( TickType_t ) 0 )
             {
-                /* Cannot add a queue/semaphore to a queue set if there are already
-                 * items in the queue/semaphore. */
-                xReturn = pdFAIL;
+                xReturn = errQUEUE_FULL;
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xReturn = errQUEUE_FULL;
+                break;
             }
             else
             {
-                ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
-                xReturn = pdPASS;
+                mtCOVERAGE_TEST_MARKER();
             }
+
+            prvMpmcQueueWait( pxQueue, pdTRUE, xTicksToWait );
         }
-        taskEXIT_CRITICAL();
 
-        traceRETURN_xQueueAddToSet( xReturn );
+        traceRETURN_xMpmcQueueSend( xReturn );
 
         return xReturn;
     }
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_MPMC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    BaseType_t xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
-                                    QueueSetHandle_t xQueueSet )
+    BaseType_t xMpmcQueueReceive( MpmcQueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  TickType_t xTicksToWait )
     {
+        MpmcQueue_t * const pxQueue = xQueue;
         BaseType_t xReturn;
-        Queue_t * const pxQueueOrSemaphore = ( Queue_t * ) xQueueOrSemaphore;
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
 
-        traceENTER_xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet );
+        traceENTER_xMpmcQueueReceive( xQueue, pvBuffer, xTicksToWait );
 
-        if( pxQueueOrSemaphore->pxQueueSetContainer != xQueueSet )
-        {
-            /* The queue was not a member of the set. */
-            xReturn = pdFAIL;
-        }
-        else if( pxQueueOrSemaphore->uxMessagesWaiting != ( UBaseType_t ) 0 )
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* It is dangerous to remove a queue from a set when the queue is
-             * not empty because the queue set will still hold pending events for
-             * the queue. */
-            xReturn = pdFAIL;
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0U ) ) );
         }
-        else
+        #endif
+
+        for( ; ; )
         {
-            taskENTER_CRITICAL();
+            if( prvMpmcQueueTryDequeue( pxQueue, pvBuffer ) != pdFAIL )
             {
-                /* The queue is no longer contained in the set. */
-                pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+                prvMpmcQueueUnblockWaiter( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->uxSendersWaiting ) );
+                xReturn = pdPASS;
+                break;
             }
-            taskEXIT_CRITICAL();
-            xReturn = pdPASS;
+
+            if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                xReturn = errQUEUE_EMPTY;
+                break;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xReturn = errQUEUE_EMPTY;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvMpmcQueueWait( pxQueue, pdFALSE, xTicksToWait );
         }
 
-        traceRETURN_xQueueRemoveFromSet( xReturn );
+        traceRETURN_xMpmcQueueReceive( xReturn );
 
         return xReturn;
     }
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_MPMC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
-                                                TickType_t const xTicksToWait )
+    UBaseType_t uxMpmcQueueMessagesWaiting( const MpmcQueueHandle_t xQueue )
     {
-        QueueSetMemberHandle_t xReturn = NULL;
-
-        traceENTER_xQueueSelectFromSet( xQueueSet, xTicksToWait );
-
-        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait );
-
-        traceRETURN_xQueueSelectFromSet( xReturn );
-
-        return xReturn;
-    }
-
-#endif /* configUSE_QUEUE_SETS */
-/*-----------------------------------------------------------*/
+        const MpmcQueue_t * const pxQueue = xQueue;
+        uint32_t ulMessagesWaiting;
+        UBaseType_t uxReturn;
 
-#if ( configUSE_QUEUE_SETS == 1 )
+        traceENTER_uxMpmcQueueMessagesWaiting( xQueue );
 
-    QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
-    {
-        QueueSetMemberHandle_t xReturn = NULL;
+        configASSERT( pxQueue );
 
-        traceENTER_xQueueSelectFromSetFromISR( xQueueSet );
+        /* The positions can be updated by other tasks while they are being
+         * read, so the result is only a snapshot and is clamped to the range
+         * the queue can actually hold. */
+        ulMessagesWaiting = pxQueue->ulEnqueuePosition - pxQueue->ulDequeuePosition;
 
-        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL );
+        if( ( int32_t ) ulMessagesWaiting < 0 )
+        {
+            uxReturn = ( UBaseType_t ) 0U;
+        }
+        else if( ulMessagesWaiting > ( uint32_t ) pxQueue->uxLength )
+        {
+            uxReturn = pxQueue->uxLength;
+        }
+        else
+        {
+            uxReturn = ( UBaseType_t ) ulMessagesWaiting;
+        }
 
-        traceRETURN_xQueueSelectFromSetFromISR( xReturn );
+        traceRETURN_uxMpmcQueueMessagesWaiting( uxReturn );
 
-        return xReturn;
+        return uxReturn;
     }
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_MPMC_QUEUES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_QUEUE_SETS == 1 )
+#if ( configUSE_MPMC_QUEUES == 1 )
 
-    static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue )
+    void vMpmcQueueDelete( MpmcQueueHandle_t xQueue )
     {
-        Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
-        BaseType_t xReturn = pdFALSE;
+        MpmcQueue_t * const pxQueue = xQueue;
 
-        /* This function must be called form a critical section. */
+        traceENTER_vMpmcQueueDelete( xQueue );
 
-        /* The following line is not reachable in unit tests because every call
-         * to prvNotifyQueueSetContainer is preceded by a check that
-         * pxQueueSetContainer != NULL */
-        configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+        configASSERT( pxQueue );
 
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
         {
-            const int8_t cTxLock = pxQueueSetContainer->cTxLock;
-
-            traceQUEUE_SET_SEND( pxQueueSetContainer );
-
-            /* The data copied is the handle of the queue that contains data. */
-            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
-
-            if( cTxLock == queueUNLOCKED )
+            /* The queue can only have been allocated dynamically - free it
+             * again. */
+            vPortFree( pxQueue );
+        }
+        #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The queue could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
             {
-                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
-                {
-                    if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority. */
-                        xReturn = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                vPortFree( pxQueue );
             }
             else
             {
-                prvIncrementQueueTxLock( pxQueueSetContainer, cTxLock );
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
+        #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* The queue must have been statically allocated, so is not going to
+             * be deleted.  Avoid compiler warnings about the unused parameter. */
+            ( void ) pxQueue;
         }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 
-        return xReturn;
+        traceRETURN_vMpmcQueueDelete();
     }
 
-#endif /* configUSE_QUEUE_SETS */
+#endif /* configUSE_MPMC_QUEUES */
@@ -58,6 +58,28 @@
  * configUSE_STREAM_BUFFERS is set to 1 in FreeRTOSConfig.h. */
 #if ( configUSE_STREAM_BUFFERS == 1 )
 
+/* With granular locks each stream buffer is protected by its own spinlock,
+ * otherwise the kernel critical section is used.  The sbLOCK() and sbUNLOCK()
+ * macros are used where the default notification macros access the stream
+ * buffer with the scheduler suspended, as suspending the scheduler does not
+ * prevent another core from entering the stream buffer's critical section when
+ * granular locks are used. */
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #define sbENTER_CRITICAL( pxStreamBuffer )                                    taskDATA_GROUP_ENTER_CRITICAL( &( ( pxStreamBuffer )->xSpinlock ) )
+        #define sbEXIT_CRITICAL( pxStreamBuffer )                                     taskDATA_GROUP_EXIT_CRITICAL( &( ( pxStreamBuffer )->xSpinlock ) )
+        #define sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer )                           taskDATA_GROUP_ENTER_CRITICAL_FROM_ISR( &( ( pxStreamBuffer )->xSpinlock ) )
+        #define sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer )    taskDATA_GROUP_EXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, &( ( pxStreamBuffer )->xSpinlock ) )
+        #define sbLOCK( pxStreamBuffer )                                              sbENTER_CRITICAL( pxStreamBuffer )
+        #define sbUNLOCK( pxStreamBuffer )                                            sbEXIT_CRITICAL( pxStreamBuffer )
+    #else
+        #define sbENTER_CRITICAL( pxStreamBuffer )                                    taskENTER_CRITICAL()
+        #define sbEXIT_CRITICAL( pxStreamBuffer )                                     taskEXIT_CRITICAL()
+        #define sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer )                           taskENTER_CRITICAL_FROM_ISR()
+        #define sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer )    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+        #define sbLOCK( pxStreamBuffer )
+        #define sbUNLOCK( pxStreamBuffer )
+    #endif /* configUSE_GRANULAR_LOCKS */
+
 /* If the user has not provided application specific Rx notification macros,
  * or #defined the notification macros away, then provide default implementations
  * that uses task notifications. */
@@ -66,6 +88,7 @@
     do                                                                                \
     {                                                                                 \
         vTaskSuspendAll();                                                            \
+        sbLOCK( pxStreamBuffer );                                                     \
         {                                                                             \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                      \
             {                                                                         \
@@ -76,6 +99,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                        \
             }                                                                         \
         }                                                                             \
+        sbUNLOCK( pxStreamBuffer );                                                   \
         ( void ) xTaskResumeAll();                                                    \
     } while( 0 )
     #endif /* sbRECEIVE_COMPLETED */
@@ -105,7 +129,7 @@
     do {                                                                                     \
         UBaseType_t uxSavedInterruptStatus;                                                  \
                                                                                              \
-        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();                              \
+        uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );                \
         {                                                                                    \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                             \
             {                                                                                \
@@ -117,7 +141,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                               \
             }                                                                                \
         }                                                                                    \
-        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                                \
+        sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );                  \
     } while( 0 )
     #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -146,6 +170,7 @@
     #ifndef sbSEND_COMPLETED
         #define sbSEND_COMPLETED( pxStreamBuffer )                                  \
     vTaskSuspendAll();                                                              \
+    sbLOCK( pxStreamBuffer );                                                       \
     {                                                                               \
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
         {                                                                           \
@@ -156,6 +181,7 @@
             ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                       \
         }                                                                           \
     }                                                                               \
+    sbUNLOCK( pxStreamBuffer );                                                     \
     ( void ) xTaskResumeAll()
     #endif /* sbSEND_COMPLETED */
 
@@ -184,7 +210,7 @@
     do {                                                                                       \
         UBaseType_t uxSavedInterruptStatus;                                                    \
                                                                                                \
-        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();                                \
+        uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );                  \
         {                                                                                      \
             if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                            \
             {                                                                                  \
@@ -196,7 +222,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                              \
             }                                                                                  \
         }                                                                                      \
-        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                                  \
+        sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );                    \
     } while( 0 )
     #endif /* sbSEND_COMPLETE_FROM_ISR */
 
@@ -225,9 +251,56 @@
     #define sbFLAGS_IS_MESSAGE_BUFFER          ( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
     #define sbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
     #define sbFLAGS_IS_BATCHING_BUFFER         ( ( uint8_t ) 4 ) /* Set if the stream buffer was created as a batching buffer, meaning the receiver task will only unblock when the trigger level exceededs. */
+    #define sbFLAGS_IS_SPSC_QUEUE              ( ( uint8_t ) 8 ) /* Set if the stream buffer was created as an SPSC queue, in which case it holds fixed size items and the trigger level is the item size. */
+    #define sbFLAGS_IS_MPMC_BUFFER             ( ( uint8_t ) 16 ) /* Set if the stream or message buffer was created to allow multiple writers and multiple readers. */
+    #define sbFLAGS_IS_BROADCAST_BUFFER        ( ( uint8_t ) 32 ) /* Set if the message buffer was created as a broadcast buffer, in which case every subscriber receives every message. */
+
+/* A stream buffer can only be reset if no tasks are blocked on it and, for
+ * buffers that allow multiple writers and readers, no task is part way through
+ * copying data in or out or has been unblocked but not yet run. */
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+        #define sbIS_IDLE( pxStreamBuffer )                                                       \
+    ( ( ( pxStreamBuffer )->xTaskWaitingToReceive == NULL ) &&                                    \
+      ( ( pxStreamBuffer )->xTaskWaitingToSend == NULL ) &&                                       \
+      ( listLIST_IS_EMPTY( &( ( pxStreamBuffer )->xTasksWaitingToReceive ) ) != pdFALSE ) &&      \
+      ( listLIST_IS_EMPTY( &( ( pxStreamBuffer )->xTasksWaitingToSend ) ) != pdFALSE ) &&         \
+      ( ( pxStreamBuffer )->xWrites.pxOldest == NULL ) &&                                         \
+      ( ( pxStreamBuffer )->xReads.pxOldest == NULL ) &&                                          \
+      ( ( pxStreamBuffer )->xSpacePromised == ( size_t ) 0 ) &&                                   \
+      ( ( pxStreamBuffer )->xDataPromised == ( size_t ) 0 ) )
+    #elif ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+        #define sbIS_IDLE( pxStreamBuffer )                                                       \
+    ( ( ( pxStreamBuffer )->xTaskWaitingToReceive == NULL ) &&                                    \
+      ( ( pxStreamBuffer )->xTaskWaitingToSend == NULL ) &&                                       \
+      ( listLIST_IS_EMPTY( &( ( pxStreamBuffer )->xTasksWaitingToReceive ) ) != pdFALSE ) )
+    #else
+        #define sbIS_IDLE( pxStreamBuffer ) \
+    ( ( ( pxStreamBuffer )->xTaskWaitingToReceive == NULL ) && ( ( pxStreamBuffer )->xTaskWaitingToSend == NULL ) )
+    #endif
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+/* A range of a buffer that allows multiple writers and readers, reserved by
+ * one task that is copying data into or out of it.  The structure lives on the
+ * stack of that task. */
+    typedef struct StreamBufferReservationDef_t
+    {
+        struct StreamBufferReservationDef_t * pxPrevious; /* The reservation made before this one, or NULL if this is the oldest. */
+        struct StreamBufferReservationDef_t * pxNext;     /* The reservation made after this one, or NULL if this is the newest. */
+        size_t xEnd;                                      /* Index after the range, extended by any later ranges that were completed first. */
+    } StreamBufferReservation_t;
+
+/* The outstanding reservations of one kind, oldest first. */
+    typedef struct StreamBufferReservationListDef_t
+    {
+        StreamBufferReservation_t * pxOldest;
+        StreamBufferReservation_t * pxNewest;
+    } StreamBufferReservationList_t;
+
+#endif /* configUSE_MPMC_STREAM_BUFFERS */
+
 /* Structure that hold state information on the buffer. */
 typedef struct StreamBufferDef_t
 {
@@ -249,6 +322,31 @@ typedef struct StreamBufferDef_t
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
     UBaseType_t uxNotificationIndex;                               /* The index we are using for notification, by default tskDEFAULT_INDEX_TO_NOTIFY. */
+
+    #if ( ( configUSE_MPMC_STREAM_BUFFERS == 1 ) || ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 ) )
+        List_t xTasksWaitingToReceive; /* Tasks blocked waiting for data in a buffer that allows multiple readers.  Replaces xTaskWaitingToReceive for such buffers. */
+    #endif
+
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+        List_t xTasksWaitingToSend;            /* Tasks blocked waiting for space in a buffer that allows multiple writers.  Replaces xTaskWaitingToSend for such buffers. */
+        size_t xReservedHead;                  /* Index after the space reserved by writers.  xHead catches up as writers finish copying in. */
+        size_t xReservedTail;                  /* Index after the data reserved by readers.  xTail catches up as readers finish copying out. */
+        StreamBufferReservationList_t xWrites; /* Space reserved by writers that have not yet committed it. */
+        StreamBufferReservationList_t xReads;  /* Data reserved by readers that have not yet released it. */
+        size_t xSpacePromised;                 /* Space that unblocked writers are expected to reserve, but have not yet tried to. */
+        size_t xDataPromised;                  /* Data, in messages for a message buffer, that unblocked readers are expected to reserve, but have not yet tried to. */
+    #endif
+
+    #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+        size_t xBytesPublished;    /* Total bytes, including message lengths, ever written to a broadcast buffer.  Wraps. */
+        size_t xBytesDiscarded;    /* Total bytes ever discarded to make space.  The byte at xTail is byte number xBytesDiscarded. */
+        size_t xMessagesPublished; /* Total messages ever written to a broadcast buffer.  Wraps. */
+        size_t xMessagesDiscarded; /* Total messages ever discarded to make space. */
+    #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xSpinlock; /* Protects the members of this structure.  Must remain the last member, see prvInitialiseNewStreamBuffer(). */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -280,7 +378,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
  * buffer's data storage area.
  */
 static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
-                                        void * pvRxData,
+                                        const StreamBufferVector_t * pxVectors,
                                         size_t xBufferLengthBytes,
                                         size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
 
@@ -292,7 +390,7 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
  * data storage area.
  */
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                       const void * pvTxData,
+                                       const StreamBufferConstVector_t * pxVectors,
                                        size_t xDataLengthBytes,
                                        size_t xSpace,
                                        size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
@@ -314,6 +412,144 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * Moves xHead past the first xBytesWritten bytes of the region returned by
+ * xStreamBufferGetWriteRegion(), making them visible to the reader.  Returns
+ * the number of bytes committed.
+ */
+static size_t prvCommitWriteRegion( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves xTail past the first xBytesRead bytes of the region returned by
+ * xStreamBufferGetReadRegion(), freeing the space for the writer.  Returns the
+ * number of bytes consumed.
+ */
+static size_t prvConsumeReadRegion( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write xCount bytes gathered from the buffers described by pxVectors into the
+ * pxStreamBuffer's data storage area, starting at xHead.  As with
+ * prvWriteBytesToBuffer(), xHead is not updated and the resulting head
+ * position is returned.  The vectors must hold at least xCount bytes.
+ */
+static size_t prvWriteVectorToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                      const StreamBufferConstVector_t * pxVectors,
+                                      size_t xCount,
+                                      size_t xHead ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xCount bytes starting at xTail from the pxStreamBuffer's data storage
+ * area, scattering them across the buffers described by pxVectors.  As with
+ * prvReadBytesFromBuffer(), xTail is not updated and the resulting tail
+ * position is returned.
+ */
+static size_t prvReadVectorFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                       const StreamBufferVector_t * pxVectors,
+                                       size_t xCount,
+                                       size_t xTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the total number of bytes described by an array of vectors.
+ * prvAddVectorLength() adds the length of one vector to a running total.
+ */
+static size_t prvVectorLength( const StreamBufferVector_t * pxVectors,
+                               UBaseType_t uxVectorCount ) PRIVILEGED_FUNCTION;
+static size_t prvConstVectorLength( const StreamBufferConstVector_t * pxVectors,
+                                    UBaseType_t uxVectorCount ) PRIVILEGED_FUNCTION;
+static size_t prvAddVectorLength( size_t xTotalLength,
+                                  const void * pvData,
+                                  size_t xLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * The implementations of xStreamBufferSend() and xStreamBufferReceive(), which
+ * are also used by xStreamBufferSendV() and xStreamBufferReceiveV().
+ * xDataLengthBytes and xBufferLengthBytes are the total length of the
+ * vectors.
+ */
+static size_t prvSendVectorToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                     const StreamBufferConstVector_t * pxVectors,
+                                     size_t xDataLengthBytes,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+static size_t prvReceiveVectorFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                          const StreamBufferVector_t * pxVectors,
+                                          size_t xBufferLengthBytes,
+                                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * The implementations of send and receive used by stream and message buffers
+ * that allow multiple writers and multiple readers.  Space and data are
+ * reserved within a short critical section, copied outside of it, then
+ * committed in the order in which they were reserved.
+ */
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    static size_t prvSendVectorToMPMCBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                             const StreamBufferConstVector_t * pxVectors,
+                                             size_t xDataLengthBytes,
+                                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    static size_t prvReceiveVectorFromMPMCBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                                  const StreamBufferVector_t * pxVectors,
+                                                  size_t xBufferLengthBytes,
+                                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    static size_t prvMPMCSpaceToReserve( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    static size_t prvMPMCBytesToReserve( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    static size_t prvMPMCMessagesToReserve( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    static void prvAddReservation( StreamBufferReservationList_t * const pxList,
+                                   StreamBufferReservation_t * const pxReservation,
+                                   size_t xEnd ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvCompleteReservation( StreamBufferReservationList_t * const pxList,
+                                              StreamBufferReservation_t * const pxReservation,
+                                              size_t * const pxEnd ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Unblock as many of the tasks waiting on a buffer that allows multiple
+ * writers and readers as the space, or data, available can serve, less what
+ * has already been promised to tasks that were unblocked earlier but have not
+ * yet run.  Each waiting task records what it needs in the value of its list
+ * item, which is replaced by what it was promised when it is unblocked.
+ */
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    static void prvNotifyMPMCWaiters( const StreamBuffer_t * const pxStreamBuffer,
+                                      List_t * const pxWaitingList,
+                                      size_t xAvailable,
+                                      size_t * const pxPromised,
+                                      BaseType_t xPartial ) PRIVILEGED_FUNCTION;
+    static void prvNotifyMPMCWriters( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    static void prvNotifyMPMCReaders( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Block on one of the lists of waiting tasks used by buffers that can have
+ * more than one task waiting to send or receive.  Returns pdTRUE if the task
+ * was removed from the list by another task, or pdFALSE if it timed out.
+ */
+    #if ( ( configUSE_MPMC_STREAM_BUFFERS == 1 ) || ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 ) )
+    static BaseType_t prvWaitOnBufferList( StreamBuffer_t * const pxStreamBuffer,
+                                           List_t * const pxWaitingList,
+                                           ListItem_t * const pxWaiter,
+                                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Used by broadcast message buffers.  The writer discards the oldest messages
+ * to make space for a new message, writes it, then publishes it to the
+ * subscribers.
+ */
+    #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+    static size_t prvDiscardForBroadcast( StreamBuffer_t * const pxStreamBuffer,
+                                          size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+    static void prvPublishBroadcast( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xHead,
+                                     size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+    static void prvNotifyBufferList( const StreamBuffer_t * const pxStreamBuffer,
+                                     List_t * const pxWaitingList ) PRIVILEGED_FUNCTION;
+    static void prvNotifyBufferListFromISR( const StreamBuffer_t * const pxStreamBuffer,
+                                            List_t * const pxWaitingList,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+    #endif
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -355,6 +591,40 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             ucFlags = sbFLAGS_IS_BATCHING_BUFFER;
             configASSERT( xBufferSizeBytes > 0 );
         }
+        else if( xStreamBufferType == sbTYPE_SPSC_QUEUE )
+        {
+            /* Is an SPSC queue but not statically allocated.  The trigger
+             * level holds the item size. */
+            ucFlags = sbFLAGS_IS_SPSC_QUEUE;
+            configASSERT( xTriggerLevelBytes > 0 );
+            configASSERT( xBufferSizeBytes > 0 );
+        }
+
+        #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_MPMC_MESSAGE_BUFFER )
+            {
+                /* Is a message buffer that allows multiple writers and
+                 * readers, but not statically allocated. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_MPMC_BUFFER;
+                configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+            }
+            else if( xStreamBufferType == sbTYPE_MPMC_STREAM_BUFFER )
+            {
+                /* Is a stream buffer that allows multiple writers and readers,
+                 * but not statically allocated. */
+                ucFlags = sbFLAGS_IS_MPMC_BUFFER;
+                configASSERT( xBufferSizeBytes > 0 );
+            }
+        #endif /* configUSE_MPMC_STREAM_BUFFERS */
+        #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_BROADCAST_MESSAGE_BUFFER )
+            {
+                /* Is a broadcast message buffer but not statically
+                 * allocated. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_BROADCAST_BUFFER;
+                configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+            }
+        #endif /* configUSE_BROADCAST_MESSAGE_BUFFERS */
         else
         {
             /* Not a message buffer and not statically allocated. */
@@ -405,6 +675,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           pxSendCompletedCallback,
                                           pxReceiveCompletedCallback );
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( ( ( StreamBuffer_t * ) pvAllocatedMemory )->xSpinlock ) );
+            }
+            #endif
+
             traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pvAllocatedMemory ), xStreamBufferType );
         }
         else
@@ -469,6 +745,37 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             ucFlags = sbFLAGS_IS_BATCHING_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
             configASSERT( xBufferSizeBytes > 0 );
         }
+        else if( xStreamBufferType == sbTYPE_SPSC_QUEUE )
+        {
+            /* Statically allocated SPSC queue. */
+            ucFlags = sbFLAGS_IS_SPSC_QUEUE | sbFLAGS_IS_STATICALLY_ALLOCATED;
+            configASSERT( xTriggerLevelBytes > 0 );
+            configASSERT( xBufferSizeBytes > 0 );
+        }
+
+        #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_MPMC_MESSAGE_BUFFER )
+            {
+                /* Statically allocated message buffer that allows multiple
+                 * writers and readers. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_MPMC_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
+                configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+            }
+            else if( xStreamBufferType == sbTYPE_MPMC_STREAM_BUFFER )
+            {
+                /* Statically allocated stream buffer that allows multiple
+                 * writers and readers. */
+                ucFlags = sbFLAGS_IS_MPMC_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
+            }
+        #endif /* configUSE_MPMC_STREAM_BUFFERS */
+        #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_BROADCAST_MESSAGE_BUFFER )
+            {
+                /* Statically allocated broadcast message buffer. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_BROADCAST_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
+                configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+            }
+        #endif /* configUSE_BROADCAST_MESSAGE_BUFFERS */
         else
         {
             /* Statically allocated stream buffer. */
@@ -495,6 +802,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           pxSendCompletedCallback,
                                           pxReceiveCompletedCallback );
 
+            #if ( configUSE_GRANULAR_LOCKS == 1 )
+            {
+                portINIT_SPINLOCK( &( pxStreamBuffer->xSpinlock ) );
+            }
+            #endif
+
             /* Remember this was statically allocated in case it is ever deleted
              * again. */
             pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
@@ -601,6 +914,10 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+        size_t xBytesPublished, xMessagesPublished;
+    #endif
+
     traceENTER_xStreamBufferReset( xStreamBuffer );
 
     configASSERT( pxStreamBuffer );
@@ -614,9 +931,9 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
     #endif
 
     /* Can only reset a message buffer if there are no tasks blocked on it. */
-    taskENTER_CRITICAL();
+    sbENTER_CRITICAL( pxStreamBuffer );
     {
-        if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+        if( sbIS_IDLE( pxStreamBuffer ) )
         {
             #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
             {
@@ -625,6 +942,16 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+            {
+                /* Subscribers record their position as a count of the bytes
+                 * and messages published, so the counts continue across the
+                 * reset, with everything published before it discarded. */
+                xBytesPublished = pxStreamBuffer->xBytesPublished;
+                xMessagesPublished = pxStreamBuffer->xMessagesPublished;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -639,12 +966,21 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+            {
+                pxStreamBuffer->xBytesPublished = xBytesPublished;
+                pxStreamBuffer->xBytesDiscarded = xBytesPublished;
+                pxStreamBuffer->xMessagesPublished = xMessagesPublished;
+                pxStreamBuffer->xMessagesDiscarded = xMessagesPublished;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
         }
     }
-    taskEXIT_CRITICAL();
+    sbEXIT_CRITICAL( pxStreamBuffer );
 
     traceRETURN_xStreamBufferReset( xReturn );
 
@@ -663,6 +999,10 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+        size_t xBytesPublished, xMessagesPublished;
+    #endif
+
     traceENTER_xStreamBufferResetFromISR( xStreamBuffer );
 
     configASSERT( pxStreamBuffer );
@@ -679,9 +1019,9 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
     {
-        if( ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) && ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+        if( sbIS_IDLE( pxStreamBuffer ) )
         {
             #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
             {
@@ -690,6 +1030,16 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+            {
+                /* Subscribers record their position as a count of the bytes
+                 * and messages published, so the counts continue across the
+                 * reset, with everything published before it discarded. */
+                xBytesPublished = pxStreamBuffer->xBytesPublished;
+                xMessagesPublished = pxStreamBuffer->xMessagesPublished;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -704,12 +1054,21 @@ BaseType_t xStreamBufferResetFromISR( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+            {
+                pxStreamBuffer->xBytesPublished = xBytesPublished;
+                pxStreamBuffer->xBytesDiscarded = xBytesPublished;
+                pxStreamBuffer->xMessagesPublished = xMessagesPublished;
+                pxStreamBuffer->xMessagesDiscarded = xMessagesPublished;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET_FROM_ISR( xStreamBuffer );
 
             xReturn = pdPASS;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
 
     traceRETURN_xStreamBufferResetFromISR( xReturn );
 
@@ -734,8 +1093,9 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
     }
 
     /* The trigger level is the number of bytes that must be in the stream
-     * buffer before a task that is waiting for data is unblocked. */
-    if( xTriggerLevel < pxStreamBuffer->xLength )
+     * buffer before a task that is waiting for data is unblocked.  The trigger
+     * level of an SPSC queue is its item size, so cannot be changed. */
+    if( ( xTriggerLevel < pxStreamBuffer->xLength ) && ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_SPSC_QUEUE ) == ( uint8_t ) 0 ) )
     {
         pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
         xReturn = pdPASS;
@@ -810,17 +1170,94 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           size_t xDataLengthBytes,
                           TickType_t xTicksToWait )
 {
-    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    StreamBufferConstVector_t xVector;
+    size_t xReturn;
+
+    traceENTER_xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+
+    configASSERT( pvTxData );
+
+    xVector.pvData = pvTxData;
+    xVector.xLength = xDataLengthBytes;
+
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    {
+        configASSERT( xStreamBuffer );
+
+        if( ( xStreamBuffer->ucFlags & sbFLAGS_IS_MPMC_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xReturn = prvSendVectorToMPMCBuffer( xStreamBuffer, &xVector, xDataLengthBytes, xTicksToWait );
+        }
+        else
+        {
+            xReturn = prvSendVectorToBuffer( xStreamBuffer, &xVector, xDataLengthBytes, xTicksToWait );
+        }
+    }
+    #else /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+    {
+        xReturn = prvSendVectorToBuffer( xStreamBuffer, &xVector, xDataLengthBytes, xTicksToWait );
+    }
+    #endif /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+
+    traceRETURN_xStreamBufferSend( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferConstVector_t * pxVectors,
+                           UBaseType_t uxVectorCount,
+                           TickType_t xTicksToWait )
+{
+    size_t xReturn;
+
+    traceENTER_xStreamBufferSendV( xStreamBuffer, pxVectors, uxVectorCount, xTicksToWait );
+
+    configASSERT( pxVectors );
+
+    /* The vectors are written as one message, or as one run of bytes, so
+     * there is a single length and a single notification. */
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    {
+        configASSERT( xStreamBuffer );
+
+        if( ( xStreamBuffer->ucFlags & sbFLAGS_IS_MPMC_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xReturn = prvSendVectorToMPMCBuffer( xStreamBuffer, pxVectors, prvConstVectorLength( pxVectors, uxVectorCount ), xTicksToWait );
+        }
+        else
+        {
+            xReturn = prvSendVectorToBuffer( xStreamBuffer, pxVectors, prvConstVectorLength( pxVectors, uxVectorCount ), xTicksToWait );
+        }
+    }
+    #else /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+    {
+        xReturn = prvSendVectorToBuffer( xStreamBuffer, pxVectors, prvConstVectorLength( pxVectors, uxVectorCount ), xTicksToWait );
+    }
+    #endif /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+
+    traceRETURN_xStreamBufferSendV( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSendVectorToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                     const StreamBufferConstVector_t * pxVectors,
+                                     size_t xDataLengthBytes,
+                                     TickType_t xTicksToWait )
+{
     size_t xReturn, xSpace = 0;
     size_t xRequiredSpace = xDataLengthBytes;
     TimeOut_t xTimeOut;
     size_t xMaxReportedSpace = 0;
 
-    traceENTER_xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
-
-    configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    /* Broadcast message buffers are written using xMessageBufferPublish(). */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BROADCAST_BUFFER ) == ( uint8_t ) 0 );
+
     /* The maximum amount of space a stream buffer will ever report is its length
      * minus 1. */
     xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
@@ -872,7 +1309,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         {
             /* Wait until the required number of bytes are free in the message
              * buffer. */
-            taskENTER_CRITICAL();
+            sbENTER_CRITICAL( pxStreamBuffer );
             {
                 xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
@@ -887,13 +1324,13 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                 }
                 else
                 {
-                    taskEXIT_CRITICAL();
+                    sbEXIT_CRITICAL( pxStreamBuffer );
                     break;
                 }
             }
-            taskEXIT_CRITICAL();
+            sbEXIT_CRITICAL( pxStreamBuffer );
 
-            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
             ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToSend = NULL;
         } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
@@ -912,11 +1349,11 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pxVectors, xDataLengthBytes, xSpace, xRequiredSpace );
 
     if( xReturn > ( size_t ) 0 )
     {
-        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+        traceSTREAM_BUFFER_SEND( pxStreamBuffer, xReturn );
 
         /* Was a task waiting for the data? */
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
@@ -931,11 +1368,9 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     else
     {
         mtCOVERAGE_TEST_MARKER();
-        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
     }
 
-    traceRETURN_xStreamBufferSend( xReturn );
-
     return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -948,12 +1383,20 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
+    StreamBufferConstVector_t xVector;
 
     traceENTER_xStreamBufferSendFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken );
 
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    /* Buffers that allow multiple writers can only be written from tasks, and
+     * broadcast buffers are written using xMessageBufferPublishFromISR(). */
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MPMC_BUFFER | sbFLAGS_IS_BROADCAST_BUFFER ) ) == ( uint8_t ) 0 );
+
+    xVector.pvData = pvTxData;
+    xVector.xLength = xDataLengthBytes;
+
     /* This send function is used to write to both message buffers and stream
      * buffers.  If this is a message buffer then the space needed must be
      * increased by the amount of bytes needed to store the length of the
@@ -968,7 +1411,7 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     }
 
     xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, &xVector, xDataLengthBytes, xSpace, xRequiredSpace );
 
     if( xReturn > ( size_t ) 0 )
     {
@@ -998,7 +1441,7 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
 /*-----------------------------------------------------------*/
 
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                       const void * pvTxData,
+                                       const StreamBufferConstVector_t * pxVectors,
                                        size_t xDataLengthBytes,
                                        size_t xSpace,
                                        size_t xRequiredSpace )
@@ -1040,10 +1483,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
     if( xDataLengthBytes != ( size_t ) 0 )
     {
         /* Write the data to the buffer. */
-        /* MISRA Ref 11.5.5 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead );
+        pxStreamBuffer->xHead = prvWriteVectorToBuffer( pxStreamBuffer, pxVectors, xDataLengthBytes, xNextHead );
     }
 
     return xDataLengthBytes;
@@ -1055,14 +1495,89 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
                              size_t xBufferLengthBytes,
                              TickType_t xTicksToWait )
 {
-    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+    StreamBufferVector_t xVector;
+    size_t xReceivedLength;
 
     traceENTER_xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
 
     configASSERT( pvRxData );
+
+    xVector.pvData = pvRxData;
+    xVector.xLength = xBufferLengthBytes;
+
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    {
+        configASSERT( xStreamBuffer );
+
+        if( ( xStreamBuffer->ucFlags & sbFLAGS_IS_MPMC_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xReceivedLength = prvReceiveVectorFromMPMCBuffer( xStreamBuffer, &xVector, xBufferLengthBytes, xTicksToWait );
+        }
+        else
+        {
+            xReceivedLength = prvReceiveVectorFromBuffer( xStreamBuffer, &xVector, xBufferLengthBytes, xTicksToWait );
+        }
+    }
+    #else /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+    {
+        xReceivedLength = prvReceiveVectorFromBuffer( xStreamBuffer, &xVector, xBufferLengthBytes, xTicksToWait );
+    }
+    #endif /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+
+    traceRETURN_xStreamBufferReceive( xReceivedLength );
+
+    return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveV( StreamBufferHandle_t xStreamBuffer,
+                              const StreamBufferVector_t * pxVectors,
+                              UBaseType_t uxVectorCount,
+                              TickType_t xTicksToWait )
+{
+    size_t xReceivedLength;
+
+    traceENTER_xStreamBufferReceiveV( xStreamBuffer, pxVectors, uxVectorCount, xTicksToWait );
+
+    configASSERT( pxVectors );
+
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    {
+        configASSERT( xStreamBuffer );
+
+        if( ( xStreamBuffer->ucFlags & sbFLAGS_IS_MPMC_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xReceivedLength = prvReceiveVectorFromMPMCBuffer( xStreamBuffer, pxVectors, prvVectorLength( pxVectors, uxVectorCount ), xTicksToWait );
+        }
+        else
+        {
+            xReceivedLength = prvReceiveVectorFromBuffer( xStreamBuffer, pxVectors, prvVectorLength( pxVectors, uxVectorCount ), xTicksToWait );
+        }
+    }
+    #else /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+    {
+        xReceivedLength = prvReceiveVectorFromBuffer( xStreamBuffer, pxVectors, prvVectorLength( pxVectors, uxVectorCount ), xTicksToWait );
+    }
+    #endif /* if ( configUSE_MPMC_STREAM_BUFFERS == 1 ) */
+
+    traceRETURN_xStreamBufferReceiveV( xReceivedLength );
+
+    return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReceiveVectorFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                          const StreamBufferVector_t * pxVectors,
+                                          size_t xBufferLengthBytes,
+                                          TickType_t xTicksToWait )
+{
+    size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
     configASSERT( pxStreamBuffer );
 
+    /* Broadcast message buffers are read using xMessageBufferReceiveSubscribed(). */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BROADCAST_BUFFER ) == ( uint8_t ) 0 );
+
     /* This receive function is used by both message buffers, which store
      * discrete messages, and stream buffers, which store a continuous stream of
      * bytes.  Discrete messages include an additional
@@ -1087,7 +1602,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     {
         /* Checking if there is data and clearing the notification state must be
          * performed atomically. */
-        taskENTER_CRITICAL();
+        sbENTER_CRITICAL( pxStreamBuffer );
         {
             xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
@@ -1112,12 +1627,12 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        sbEXIT_CRITICAL( pxStreamBuffer );
 
         if( xBytesAvailable <= xBytesToStoreMessageLength )
         {
             /* Wait for data to be available. */
-            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
             ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
             pxStreamBuffer->xTaskWaitingToReceive = NULL;
 
@@ -1141,13 +1656,13 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
      * read bytes from the buffer. */
     if( xBytesAvailable > xBytesToStoreMessageLength )
     {
-        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pxVectors, xBufferLengthBytes, xBytesAvailable );
 
         /* Was a task waiting for space in the buffer? */
         if( xReceivedLength != ( size_t ) 0 )
         {
-            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
-            prvRECEIVE_COMPLETED( xStreamBuffer );
+            traceSTREAM_BUFFER_RECEIVE( pxStreamBuffer, xReceivedLength );
+            prvRECEIVE_COMPLETED( pxStreamBuffer );
         }
         else
         {
@@ -1156,12 +1671,10 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     }
     else
     {
-        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        traceSTREAM_BUFFER_RECEIVE_FAILED( pxStreamBuffer );
         mtCOVERAGE_TEST_MARKER();
     }
 
-    traceRETURN_xStreamBufferReceive( xReceivedLength );
-
     return xReceivedLength;
 }
 /*-----------------------------------------------------------*/
@@ -1217,12 +1730,20 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+    StreamBufferVector_t xVector;
 
     traceENTER_xStreamBufferReceiveFromISR( xStreamBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken );
 
     configASSERT( pvRxData );
     configASSERT( pxStreamBuffer );
 
+    /* Buffers that allow multiple readers can only be read from tasks, and
+     * broadcast buffers are only read using xMessageBufferReceiveSubscribed(). */
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MPMC_BUFFER | sbFLAGS_IS_BROADCAST_BUFFER ) ) == ( uint8_t ) 0 );
+
+    xVector.pvData = pvRxData;
+    xVector.xLength = xBufferLengthBytes;
+
     /* This receive function is used by both message buffers, which store
      * discrete messages, and stream buffers, which store a continuous stream of
      * bytes.  Discrete messages include an additional
@@ -1246,7 +1767,7 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
      * read bytes from the buffer. */
     if( xBytesAvailable > xBytesToStoreMessageLength )
     {
-        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
+        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, &xVector, xBufferLengthBytes, xBytesAvailable );
 
         /* Was a task waiting for space in the buffer? */
         if( xReceivedLength != ( size_t ) 0 )
@@ -1274,7 +1795,7 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 /*-----------------------------------------------------------*/
 
 static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
-                                        void * pvRxData,
+                                        const StreamBufferVector_t * pxVectors,
                                         size_t xBufferLengthBytes,
                                         size_t xBytesAvailable )
 {
@@ -1318,39 +1839,1837 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
     if( xCount != ( size_t ) 0 )
     {
         /* Read the actual data and update the tail to mark the data as officially consumed. */
-        /* MISRA Ref 11.5.5 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        pxStreamBuffer->xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail );
+        pxStreamBuffer->xTail = prvReadVectorFromBuffer( pxStreamBuffer, pxVectors, xCount, xNextTail );
     }
 
     return xCount;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
-{
-    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    BaseType_t xReturn;
-    size_t xTail;
+    #if ( ( configUSE_MPMC_STREAM_BUFFERS == 1 ) || ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 ) )
 
-    traceENTER_xStreamBufferIsEmpty( xStreamBuffer );
+    static BaseType_t prvWaitOnBufferList( StreamBuffer_t * const pxStreamBuffer,
+                                           List_t * const pxWaitingList,
+                                           ListItem_t * const pxWaiter,
+                                           TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
 
-    configASSERT( pxStreamBuffer );
+        /* Must be called from within the stream buffer's critical section,
+         * which is exited before blocking.  The notification state is cleared
+         * before the task is added to the list, so a notification sent as soon
+         * as the critical section is exited is not lost. */
+        ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+        vListInsertEnd( pxWaitingList, pxWaiter );
+        sbEXIT_CRITICAL( pxStreamBuffer );
 
-    /* True if no bytes are available. */
-    xTail = pxStreamBuffer->xTail;
+        ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
 
-    if( pxStreamBuffer->xHead == xTail )
+        /* A task that timed out is still in the list. */
+        sbENTER_CRITICAL( pxStreamBuffer );
+        {
+            if( listLIST_ITEM_CONTAINER( pxWaiter ) != NULL )
+            {
+                ( void ) uxListRemove( pxWaiter );
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        sbEXIT_CRITICAL( pxStreamBuffer );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+
+    static void prvNotifyBufferList( const StreamBuffer_t * const pxStreamBuffer,
+                                     List_t * const pxWaitingList )
     {
-        xReturn = pdTRUE;
+        ListItem_t * pxWaiter;
+
+        /* Must be called from within the stream buffer's critical section, with
+         * the scheduler suspended.  Every waiting task is unblocked as each is
+         * a different subscriber, and every subscriber receives every message. */
+        while( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+        {
+            pxWaiter = listGET_HEAD_ENTRY( pxWaitingList );
+            ( void ) uxListRemove( pxWaiter );
+            ( void ) xTaskNotifyIndexed( ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxWaiter ),
+                                         pxStreamBuffer->uxNotificationIndex,
+                                         ( uint32_t ) 0,
+                                         eNoAction );
+        }
     }
-    else
+/*-----------------------------------------------------------*/
+
+    static void prvNotifyBufferListFromISR( const StreamBuffer_t * const pxStreamBuffer,
+                                            List_t * const pxWaitingList,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
     {
-        xReturn = pdFALSE;
+        ListItem_t * pxWaiter;
+
+        /* As prvNotifyBufferList(), but called from the stream buffer's
+         * critical section within an interrupt. */
+        while( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+        {
+            pxWaiter = listGET_HEAD_ENTRY( pxWaitingList );
+            ( void ) uxListRemove( pxWaiter );
+            ( void ) xTaskNotifyIndexedFromISR( ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxWaiter ),
+                                                pxStreamBuffer->uxNotificationIndex,
+                                                ( uint32_t ) 0,
+                                                eNoAction,
+                                                pxHigherPriorityTaskWoken );
+        }
     }
+/*-----------------------------------------------------------*/
 
-    traceRETURN_xStreamBufferIsEmpty( xReturn );
+    #endif /* configUSE_BROADCAST_MESSAGE_BUFFERS */
+
+    #endif /* ( configUSE_MPMC_STREAM_BUFFERS == 1 ) || ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 )
+
+    static size_t prvDiscardForBroadcast( StreamBuffer_t * const pxStreamBuffer,
+                                          size_t xRequiredSpace )
+    {
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+        size_t xTail, xDiscardedBytes;
+
+        /* Must be called from within the stream buffer's critical section.
+         * The writer never waits for subscribers, so the oldest messages are
+         * discarded until there is space for the new message.  Subscribers
+         * that had not yet read a discarded message detect the overrun by
+         * comparing their position with xBytesDiscarded. */
+        while( ( pxStreamBuffer->xLength - ( size_t ) 1 - prvBytesInBuffer( pxStreamBuffer ) ) < xRequiredSpace )
+        {
+            xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+            xTail += ( size_t ) xTempLength;
+
+            if( xTail >= pxStreamBuffer->xLength )
+            {
+                xTail -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xDiscardedBytes = ( size_t ) xTempLength + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            pxStreamBuffer->xTail = xTail;
+            pxStreamBuffer->xBytesDiscarded += xDiscardedBytes;
+            ( pxStreamBuffer->xMessagesDiscarded )++;
+        }
+
+        /* There is only one writer, so xHead does not change until the
+         * message is published. */
+        return pxStreamBuffer->xHead;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPublishBroadcast( StreamBuffer_t * const pxStreamBuffer,
+                                     size_t xHead,
+                                     size_t xRequiredSpace )
+    {
+        /* Must be called from within the stream buffer's critical section,
+         * after the message has been written to the space ending at xHead. */
+        pxStreamBuffer->xHead = xHead;
+        pxStreamBuffer->xBytesPublished += xRequiredSpace;
+        ( pxStreamBuffer->xMessagesPublished )++;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferPublish( StreamBufferHandle_t xStreamBuffer,
+                                 const void * pvTxData,
+                                 size_t xDataLengthBytes )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn = 0, xRequiredSpace = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+        traceENTER_xStreamBufferPublish( xStreamBuffer, pvTxData, xDataLengthBytes );
+
+        configASSERT( pvTxData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BROADCAST_BUFFER ) != ( uint8_t ) 0 );
+
+        /* Overflow? */
+        configASSERT( xRequiredSpace > xDataLengthBytes );
+
+        xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+        configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+        /* A message that would not fit even if the entire buffer was empty is
+         * not written. */
+        if( xRequiredSpace < pxStreamBuffer->xLength )
+        {
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                xHead = prvDiscardForBroadcast( pxStreamBuffer, xRequiredSpace );
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+
+            /* The space is no longer visible to subscribers, so the message
+             * is written outside of the critical section. */
+            xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+            xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xHead );
+
+            /* The scheduler is suspended so no context switch occurs while the
+             * list of subscribers is walked. */
+            vTaskSuspendAll();
+            {
+                sbENTER_CRITICAL( pxStreamBuffer );
+                {
+                    prvPublishBroadcast( pxStreamBuffer, xHead, xRequiredSpace );
+                    prvNotifyBufferList( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToReceive ) );
+                }
+                sbEXIT_CRITICAL( pxStreamBuffer );
+            }
+            ( void ) xTaskResumeAll();
+
+            xReturn = xDataLengthBytes;
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+        }
+        else
+        {
+            traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        }
+
+        traceRETURN_xStreamBufferPublish( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferPublishFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        const void * pvTxData,
+                                        size_t xDataLengthBytes,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn = 0, xRequiredSpace = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+        UBaseType_t uxSavedInterruptStatus;
+
+        traceENTER_xStreamBufferPublishFromISR( xStreamBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken );
+
+        configASSERT( pvTxData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BROADCAST_BUFFER ) != ( uint8_t ) 0 );
+
+        /* Overflow? */
+        configASSERT( xRequiredSpace > xDataLengthBytes );
+
+        xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+        configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+        if( xRequiredSpace < pxStreamBuffer->xLength )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
+            {
+                xHead = prvDiscardForBroadcast( pxStreamBuffer, xRequiredSpace );
+            }
+            sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
+
+            xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+            xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xHead );
+
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
+            {
+                prvPublishBroadcast( pxStreamBuffer, xHead, xRequiredSpace );
+                prvNotifyBufferListFromISR( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToReceive ), pxHigherPriorityTaskWoken );
+            }
+            sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
+
+            xReturn = xDataLengthBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+        traceRETURN_xStreamBufferPublishFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vStreamBufferSubscribe( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSubscriber_t * const pxSubscriber )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        traceENTER_vStreamBufferSubscribe( xStreamBuffer, pxSubscriber );
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxSubscriber );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BROADCAST_BUFFER ) != ( uint8_t ) 0 );
+
+        /* A new subscriber receives messages published from now on. */
+        sbENTER_CRITICAL( pxStreamBuffer );
+        {
+            pxSubscriber->xNextByte = pxStreamBuffer->xBytesPublished;
+            pxSubscriber->xNextMessage = pxStreamBuffer->xMessagesPublished;
+        }
+        sbEXIT_CRITICAL( pxStreamBuffer );
+
+        traceRETURN_vStreamBufferSubscribe();
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xStreamBufferReceiveSubscribed( StreamBufferHandle_t xStreamBuffer,
+                                           StreamBufferSubscriber_t * const pxSubscriber,
+                                           void * pvRxData,
+                                           size_t xBufferLengthBytes,
+                                           size_t * const pxMessagesLost,
+                                           TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength = 0, xMessagesLost = 0, xOffset, xTail = 0;
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempLength;
+        BaseType_t xCopied = pdFALSE;
+        TimeOut_t xTimeOut;
+        ListItem_t xWaiter;
+
+        traceENTER_xStreamBufferReceiveSubscribed( xStreamBuffer, pxSubscriber, pvRxData, xBufferLengthBytes, pxMessagesLost, xTicksToWait );
+
+        configASSERT( pvRxData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxSubscriber );
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BROADCAST_BUFFER ) != ( uint8_t ) 0 );
+
+        vTaskSetTimeOutState( &xTimeOut );
+        vListInitialiseItem( &xWaiter );
+        listSET_LIST_ITEM_OWNER( &xWaiter, xTaskGetCurrentTaskHandle() );
+
+        for( ; ; )
+        {
+            xReceivedLength = 0;
+
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                if( xCopied != pdFALSE )
+                {
+                    /* The message was copied outside of the critical section,
+                     * so is only valid if the writer did not discard it while
+                     * it was being copied. */
+                    xOffset = pxSubscriber->xNextByte - pxStreamBuffer->xBytesDiscarded;
+
+                    if( xOffset <= ( pxStreamBuffer->xBytesPublished - pxStreamBuffer->xBytesDiscarded ) )
+                    {
+                        xReceivedLength = ( size_t ) xTempLength;
+                        pxSubscriber->xNextByte += xReceivedLength + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+                        ( pxSubscriber->xNextMessage )++;
+                        sbEXIT_CRITICAL( pxStreamBuffer );
+                        break;
+                    }
+                    else
+                    {
+                        xCopied = pdFALSE;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The subscriber's position is counted in bytes published, so
+                 * its offset from the oldest message still in the buffer wraps
+                 * to a large value if the messages it had yet to read were
+                 * discarded. */
+                xOffset = pxSubscriber->xNextByte - pxStreamBuffer->xBytesDiscarded;
+
+                if( xOffset > ( pxStreamBuffer->xBytesPublished - pxStreamBuffer->xBytesDiscarded ) )
+                {
+                    xMessagesLost += pxStreamBuffer->xMessagesDiscarded - pxSubscriber->xNextMessage;
+                    pxSubscriber->xNextByte = pxStreamBuffer->xBytesDiscarded;
+                    pxSubscriber->xNextMessage = pxStreamBuffer->xMessagesDiscarded;
+                    xOffset = 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xOffset < ( pxStreamBuffer->xBytesPublished - pxStreamBuffer->xBytesDiscarded ) )
+                {
+                    xTail = pxStreamBuffer->xTail + xOffset;
+
+                    if( xTail >= pxStreamBuffer->xLength )
+                    {
+                        xTail -= pxStreamBuffer->xLength;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail );
+                    sbEXIT_CRITICAL( pxStreamBuffer );
+
+                    /* As in xMessageBufferReceive(), a message that does not
+                     * fit in the buffer provided is left unread. */
+                    if( ( size_t ) xTempLength > xBufferLengthBytes )
+                    {
+                        break;
+                    }
+                    else
+                    {
+                        ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, ( size_t ) xTempLength, xTail );
+                        xCopied = pdTRUE;
+                    }
+                }
+                else if( xTicksToWait != ( TickType_t ) 0 )
+                {
+                    traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                    ( void ) prvWaitOnBufferList( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToReceive ), &xWaiter, xTicksToWait );
+
+                    if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+                    {
+                        /* Make a final attempt without blocking. */
+                        xTicksToWait = ( TickType_t ) 0;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    sbEXIT_CRITICAL( pxStreamBuffer );
+                    break;
+                }
+            }
+        }
+
+        if( pxMessagesLost != NULL )
+        {
+            *pxMessagesLost = xMessagesLost;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReceivedLength != ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+        }
+        else
+        {
+            traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        }
+
+        traceRETURN_xStreamBufferReceiveSubscribed( xReceivedLength );
+
+        return xReceivedLength;
+    }
+
+    #endif /* configUSE_BROADCAST_MESSAGE_BUFFERS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+
+    static size_t prvMPMCSpaceToReserve( const StreamBuffer_t * const pxStreamBuffer )
+    {
+        size_t xSpace;
+
+        /* Space already reserved by writers that are still copying is not
+         * free, and neither is data reserved by readers that are still copying
+         * out, as xTail only moves once they have finished. */
+        xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+        xSpace -= pxStreamBuffer->xReservedHead;
+        xSpace -= ( size_t ) 1;
+
+        if( xSpace >= pxStreamBuffer->xLength )
+        {
+            xSpace -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xSpace;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvMPMCBytesToReserve( const StreamBuffer_t * const pxStreamBuffer )
+    {
+        size_t xCount;
+
+        /* Only data that has been committed by its writer, and that has not
+         * already been reserved by another reader, can be read. */
+        xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+        xCount -= pxStreamBuffer->xReservedTail;
+
+        if( xCount >= pxStreamBuffer->xLength )
+        {
+            xCount -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvMPMCMessagesToReserve( StreamBuffer_t * const pxStreamBuffer )
+    {
+        size_t xCount, xTail, xMessages = 0;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+        /* Writers only ever commit whole messages, so the data that can be
+         * reserved is a sequence of complete messages. */
+        xCount = prvMPMCBytesToReserve( pxStreamBuffer );
+        xTail = pxStreamBuffer->xReservedTail;
+
+        while( xCount >= sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        {
+            xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail );
+            xTail += ( size_t ) xMessageLength;
+
+            if( xTail >= pxStreamBuffer->xLength )
+            {
+                xTail -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xCount -= sbBYTES_TO_STORE_MESSAGE_LENGTH + ( size_t ) xMessageLength;
+            xMessages++;
+        }
+
+        return xMessages;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddReservation( StreamBufferReservationList_t * const pxList,
+                                   StreamBufferReservation_t * const pxReservation,
+                                   size_t xEnd )
+    {
+        /* Must be called from within the stream buffer's critical section,
+         * immediately after the range ending at xEnd has been reserved. */
+        pxReservation->xEnd = xEnd;
+        pxReservation->pxNext = NULL;
+        pxReservation->pxPrevious = pxList->pxNewest;
+
+        if( pxList->pxNewest != NULL )
+        {
+            pxList->pxNewest->pxNext = pxReservation;
+        }
+        else
+        {
+            pxList->pxOldest = pxReservation;
+        }
+
+        pxList->pxNewest = pxReservation;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCompleteReservation( StreamBufferReservationList_t * const pxList,
+                                              StreamBufferReservation_t * const pxReservation,
+                                              size_t * const pxEnd )
+    {
+        StreamBufferReservation_t * const pxPrevious = pxReservation->pxPrevious;
+        StreamBufferReservation_t * const pxNext = pxReservation->pxNext;
+        BaseType_t xReturn;
+
+        /* Must be called from within the stream buffer's critical section.
+         * Ranges are published in the order in which they were reserved. */
+        if( pxNext != NULL )
+        {
+            pxNext->pxPrevious = pxPrevious;
+        }
+        else
+        {
+            pxList->pxNewest = pxPrevious;
+        }
+
+        if( pxPrevious != NULL )
+        {
+            /* An earlier range is still being copied, so cannot be published
+             * yet.  Hand this range, along with any later ranges that were
+             * handed to it, to the earlier range so they are published as
+             * soon as the earlier range is complete. */
+            pxPrevious->pxNext = pxNext;
+            pxPrevious->xEnd = pxReservation->xEnd;
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            /* This was the oldest range, so it can be published along with
+             * every completed range that follows it. */
+            pxList->pxOldest = pxNext;
+            *pxEnd = pxReservation->xEnd;
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvNotifyMPMCWaiters( const StreamBuffer_t * const pxStreamBuffer,
+                                      List_t * const pxWaitingList,
+                                      size_t xAvailable,
+                                      size_t * const pxPromised,
+                                      BaseType_t xPartial )
+    {
+        ListItem_t * pxWaiter;
+        ListItem_t * pxNext;
+        ListItem_t const * const pxEnd = listGET_END_MARKER( pxWaitingList );
+        size_t xWanted;
+
+        /* Must be called from within the stream buffer's critical section,
+         * with the scheduler suspended so no unblocked task runs before the
+         * list has been walked.  Waiting tasks are considered in the order in
+         * which they blocked, and each task that is unblocked is promised all
+         * it wants, so no more tasks are unblocked than can be served.  A task
+         * that needs more than remains is skipped, unless xPartial is pdTRUE,
+         * in which case it is unblocked to take what remains. */
+        xAvailable -= configMIN( *pxPromised, xAvailable );
+        pxWaiter = listGET_HEAD_ENTRY( pxWaitingList );
+
+        while( ( pxWaiter != pxEnd ) && ( xAvailable > ( size_t ) 0 ) )
+        {
+            pxNext = listGET_NEXT( pxWaiter );
+            xWanted = ( size_t ) listGET_LIST_ITEM_VALUE( pxWaiter );
+
+            if( ( xWanted <= xAvailable ) || ( xPartial != pdFALSE ) )
+            {
+                xWanted = configMIN( xWanted, xAvailable );
+                xAvailable -= xWanted;
+                *pxPromised += xWanted;
+                listSET_LIST_ITEM_VALUE( pxWaiter, ( TickType_t ) xWanted );
+                ( void ) uxListRemove( pxWaiter );
+                ( void ) xTaskNotifyIndexed( ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxWaiter ),
+                                             pxStreamBuffer->uxNotificationIndex,
+                                             ( uint32_t ) 0,
+                                             eNoAction );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxWaiter = pxNext;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvNotifyMPMCWriters( StreamBuffer_t * const pxStreamBuffer )
+    {
+        /* Each writer waits for all the space it needs. */
+        if( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE )
+        {
+            prvNotifyMPMCWaiters( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToSend ), prvMPMCSpaceToReserve( pxStreamBuffer ), &( pxStreamBuffer->xSpacePromised ), pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvNotifyMPMCReaders( StreamBuffer_t * const pxStreamBuffer )
+    {
+        /* A reader of a message buffer waits for one message, and a reader of
+         * a stream buffer for as many bytes as are available up to the size
+         * of its buffer. */
+        if( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToReceive ) ) == pdFALSE )
+        {
+            if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+            {
+                prvNotifyMPMCWaiters( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToReceive ), prvMPMCMessagesToReserve( pxStreamBuffer ), &( pxStreamBuffer->xDataPromised ), pdFALSE );
+            }
+            else
+            {
+                prvNotifyMPMCWaiters( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToReceive ), prvMPMCBytesToReserve( pxStreamBuffer ), &( pxStreamBuffer->xDataPromised ), pdTRUE );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvSendVectorToMPMCBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                             const StreamBufferConstVector_t * pxVectors,
+                                             size_t xDataLengthBytes,
+                                             TickType_t xTicksToWait )
+    {
+        size_t xRequiredSpace = xDataLengthBytes, xSpace, xReservedBytes = 0, xHead = 0, xEnd = 0, xReturn = 0;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength = 0;
+        BaseType_t xIsMessageBuffer, xPromised = pdFALSE;
+        TimeOut_t xTimeOut;
+        TickType_t xWanted;
+        ListItem_t xWaiter;
+        StreamBufferReservation_t xReservation;
+
+        configASSERT( pxStreamBuffer );
+
+        xIsMessageBuffer = ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) ? pdTRUE : pdFALSE;
+
+        /* The space required is calculated as in xStreamBufferSend(). */
+        if( xIsMessageBuffer != pdFALSE )
+        {
+            xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            /* Overflow? */
+            configASSERT( xRequiredSpace > xDataLengthBytes );
+
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+            configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+            if( xRequiredSpace > ( pxStreamBuffer->xLength - ( size_t ) 1 ) )
+            {
+                /* The message would not fit even if the entire buffer was
+                 * empty, so don't wait for space. */
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xRequiredSpace = configMIN( xRequiredSpace, pxStreamBuffer->xLength - ( size_t ) 1 );
+        }
+
+        vTaskSetTimeOutState( &xTimeOut );
+        vListInitialiseItem( &xWaiter );
+        listSET_LIST_ITEM_OWNER( &xWaiter, xTaskGetCurrentTaskHandle() );
+
+        /* The space needed, recorded in the list item while the task waits so
+         * the task is only unblocked when there is enough.  A need too large
+         * to record is recorded as the largest value that can be, so the task
+         * might be unblocked early, in which case it waits again. */
+        xWanted = ( TickType_t ) configMIN( xRequiredSpace, ( size_t ) portMAX_DELAY );
+
+        for( ; ; )
+        {
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                if( xPromised != pdFALSE )
+                {
+                    /* The space promised to this task when it was unblocked
+                     * need no longer be held back from other writers. */
+                    pxStreamBuffer->xSpacePromised -= ( size_t ) listGET_LIST_ITEM_VALUE( &xWaiter );
+                    xPromised = pdFALSE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xSpace = prvMPMCSpaceToReserve( pxStreamBuffer );
+
+                if( ( xSpace >= xRequiredSpace ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+                {
+                    /* A message is written completely or not at all, whereas
+                     * as many bytes as fit are written to a stream. */
+                    if( xIsMessageBuffer != pdFALSE )
+                    {
+                        xReservedBytes = ( xSpace >= xRequiredSpace ) ? xRequiredSpace : ( size_t ) 0;
+                    }
+                    else
+                    {
+                        xReservedBytes = configMIN( xDataLengthBytes, xSpace );
+                    }
+
+                    if( xReservedBytes > ( size_t ) 0 )
+                    {
+                        /* Reserve the space.  Once reserved it belongs to
+                         * this task alone, so can be written to outside of the
+                         * critical section while other writers reserve and
+                         * write the space that follows it. */
+                        xHead = pxStreamBuffer->xReservedHead;
+                        pxStreamBuffer->xReservedHead += xReservedBytes;
+
+                        if( pxStreamBuffer->xReservedHead >= pxStreamBuffer->xLength )
+                        {
+                            pxStreamBuffer->xReservedHead -= pxStreamBuffer->xLength;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        prvAddReservation( &( pxStreamBuffer->xWrites ), &xReservation, pxStreamBuffer->xReservedHead );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    sbEXIT_CRITICAL( pxStreamBuffer );
+                    break;
+                }
+                else
+                {
+                    traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+                    listSET_LIST_ITEM_VALUE( &xWaiter, xWanted );
+                    xPromised = prvWaitOnBufferList( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToSend ), &xWaiter, xTicksToWait );
+                }
+            }
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                /* Make a final attempt without blocking. */
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xReservedBytes > ( size_t ) 0 )
+        {
+            if( xIsMessageBuffer != pdFALSE )
+            {
+                xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+                xReturn = xReservedBytes - sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            }
+            else
+            {
+                xReturn = xReservedBytes;
+            }
+
+            if( xReturn > ( size_t ) 0 )
+            {
+                ( void ) prvWriteVectorToBuffer( pxStreamBuffer, pxVectors, xReturn, xHead );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The scheduler is suspended so a reader unblocked by the commit
+             * does not run until the critical section has been exited. */
+            vTaskSuspendAll();
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                /* xHead can only move past space whose writer has finished, so
+                 * a writer that finishes before the writers that reserved space
+                 * ahead of it leaves its space to be published by them. */
+                if( prvCompleteReservation( &( pxStreamBuffer->xWrites ), &xReservation, &xEnd ) != pdFALSE )
+                {
+                    pxStreamBuffer->xHead = xEnd;
+
+                    if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+                    {
+                        prvNotifyMPMCReaders( pxStreamBuffer );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+            ( void ) xTaskResumeAll();
+
+            traceSTREAM_BUFFER_SEND( pxStreamBuffer, xReturn );
+        }
+        else
+        {
+            traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvReceiveVectorFromMPMCBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                                  const StreamBufferVector_t * pxVectors,
+                                                  size_t xBufferLengthBytes,
+                                                  TickType_t xTicksToWait )
+    {
+        size_t xBytesAvailable, xBytesToStoreMessageLength, xReservedBytes = 0, xTail = 0, xEnd = 0, xReceivedLength = 0;
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+        BaseType_t xPromised = pdFALSE;
+        TimeOut_t xTimeOut;
+        TickType_t xWanted;
+        ListItem_t xWaiter;
+        StreamBufferReservation_t xReservation;
+
+        configASSERT( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        vTaskSetTimeOutState( &xTimeOut );
+        vListInitialiseItem( &xWaiter );
+        listSET_LIST_ITEM_OWNER( &xWaiter, xTaskGetCurrentTaskHandle() );
+
+        /* How much the task takes once unblocked - one message, or up to the
+         * size of its buffer - see prvNotifyMPMCReaders(). */
+        if( xBytesToStoreMessageLength != ( size_t ) 0 )
+        {
+            xWanted = ( TickType_t ) 1;
+        }
+        else
+        {
+            xWanted = ( TickType_t ) configMIN( xBufferLengthBytes, ( size_t ) portMAX_DELAY );
+        }
+
+        for( ; ; )
+        {
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                if( xPromised != pdFALSE )
+                {
+                    pxStreamBuffer->xDataPromised -= ( size_t ) listGET_LIST_ITEM_VALUE( &xWaiter );
+                    xPromised = pdFALSE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xBytesAvailable = prvMPMCBytesToReserve( pxStreamBuffer );
+
+                if( ( xBytesAvailable > xBytesToStoreMessageLength ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+                {
+                    if( xBytesAvailable > xBytesToStoreMessageLength )
+                    {
+                        xTail = pxStreamBuffer->xReservedTail;
+
+                        if( xBytesToStoreMessageLength != ( size_t ) 0 )
+                        {
+                            /* The length is read within the critical section
+                             * so the message can be reserved before another
+                             * reader reaches it.  As in xStreamBufferReceive()
+                             * the message is left in the buffer if it does not
+                             * fit in the buffer provided. */
+                            xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail );
+
+                            if( ( size_t ) xTempNextMessageLength <= xBufferLengthBytes )
+                            {
+                                xReceivedLength = ( size_t ) xTempNextMessageLength;
+                                xReservedBytes = xReceivedLength + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            xReceivedLength = configMIN( xBufferLengthBytes, xBytesAvailable );
+                            xReservedBytes = xReceivedLength;
+                        }
+
+                        if( xReservedBytes > ( size_t ) 0 )
+                        {
+                            pxStreamBuffer->xReservedTail += xReservedBytes;
+
+                            if( pxStreamBuffer->xReservedTail >= pxStreamBuffer->xLength )
+                            {
+                                pxStreamBuffer->xReservedTail -= pxStreamBuffer->xLength;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            prvAddReservation( &( pxStreamBuffer->xReads ), &xReservation, pxStreamBuffer->xReservedTail );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    sbEXIT_CRITICAL( pxStreamBuffer );
+                    break;
+                }
+                else
+                {
+                    traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+                    listSET_LIST_ITEM_VALUE( &xWaiter, xWanted );
+                    xPromised = prvWaitOnBufferList( pxStreamBuffer, &( pxStreamBuffer->xTasksWaitingToReceive ), &xWaiter, xTicksToWait );
+                }
+            }
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xReservedBytes > ( size_t ) 0 )
+        {
+            if( xReceivedLength > ( size_t ) 0 )
+            {
+                ( void ) prvReadVectorFromBuffer( pxStreamBuffer, pxVectors, xReceivedLength, xTail );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            vTaskSuspendAll();
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                /* As when writing, space is freed in the order in which it was
+                 * reserved. */
+                if( prvCompleteReservation( &( pxStreamBuffer->xReads ), &xReservation, &xEnd ) != pdFALSE )
+                {
+                    pxStreamBuffer->xTail = xEnd;
+                    prvNotifyMPMCWriters( pxStreamBuffer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+            ( void ) xTaskResumeAll();
+
+            traceSTREAM_BUFFER_RECEIVE( pxStreamBuffer, xReceivedLength );
+        }
+        else
+        {
+            if( xBytesAvailable > xBytesToStoreMessageLength )
+            {
+                /* The next message is too large for this task's buffer so is
+                 * left for another reader, which might have been unblocked to
+                 * receive it in place of this task. */
+                vTaskSuspendAll();
+                sbENTER_CRITICAL( pxStreamBuffer );
+                {
+                    prvNotifyMPMCReaders( pxStreamBuffer );
+                }
+                sbEXIT_CRITICAL( pxStreamBuffer );
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceSTREAM_BUFFER_RECEIVE_FAILED( pxStreamBuffer );
+        }
+
+        return xReceivedLength;
+    }
+
+    #endif /* configUSE_MPMC_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSendItem( StreamBufferHandle_t xStreamBuffer,
+                                  const void * pvItem,
+                                  TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xItemSize, xSpace, xNextHead;
+    TimeOut_t xTimeOut;
+    BaseType_t xReturn;
+
+    traceENTER_xStreamBufferSendItem( xStreamBuffer, pvItem, xTicksToWait );
+
+    configASSERT( pvItem );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_SPSC_QUEUE ) != ( uint8_t ) 0 );
+
+    /* The trigger level of an SPSC queue is the size of one item. */
+    xItemSize = pxStreamBuffer->xTriggerLevelBytes;
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+    if( ( xSpace < xItemSize ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                /* Clear notification state as going to wait for space. */
+                ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                /* Should only be one writer. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+
+                /* The reader does not enter a critical section before checking
+                 * xTaskWaitingToSend, so the space must be checked again after
+                 * xTaskWaitingToSend is set.  Either this task sees the space
+                 * freed by the reader, or the reader sees this task waiting. */
+                portMEMORY_BARRIER();
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                if( xSpace >= xItemSize )
+                {
+                    pxStreamBuffer->xTaskWaitingToSend = NULL;
+                    sbEXIT_CRITICAL( pxStreamBuffer );
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        } while( ( xSpace < xItemSize ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xSpace >= xItemSize )
+    {
+        /* Only the writer updates xHead, so the item can be copied in and then
+         * published by a single store to xHead without a critical section. */
+        xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvItem, xItemSize, pxStreamBuffer->xHead );
+        portMEMORY_BARRIER();
+        pxStreamBuffer->xHead = xNextHead;
+        portMEMORY_BARRIER();
+
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xItemSize );
+
+        /* Was a task waiting for the data?  The critical section is only
+         * entered if there was. */
+        if( pxStreamBuffer->xTaskWaitingToReceive != NULL )
+        {
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                if( pxStreamBuffer->xTaskWaitingToReceive != NULL )
+                {
+                    ( void ) xTaskNotifyIndexed( pxStreamBuffer->xTaskWaitingToReceive,
+                                                 pxStreamBuffer->uxNotificationIndex,
+                                                 ( uint32_t ) 0,
+                                                 eNoAction );
+                    pxStreamBuffer->xTaskWaitingToReceive = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        xReturn = errQUEUE_FULL;
+    }
+
+    traceRETURN_xStreamBufferSendItem( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSendItemFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         const void * pvItem,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xItemSize, xNextHead;
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xReturn;
+
+    traceENTER_xStreamBufferSendItemFromISR( xStreamBuffer, pvItem, pxHigherPriorityTaskWoken );
+
+    configASSERT( pvItem );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_SPSC_QUEUE ) != ( uint8_t ) 0 );
+
+    xItemSize = pxStreamBuffer->xTriggerLevelBytes;
+
+    if( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= xItemSize )
+    {
+        xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvItem, xItemSize, pxStreamBuffer->xHead );
+        portMEMORY_BARRIER();
+        pxStreamBuffer->xHead = xNextHead;
+        portMEMORY_BARRIER();
+
+        /* Interrupts are only masked if a task is waiting for the data. */
+        if( pxStreamBuffer->xTaskWaitingToReceive != NULL )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
+            {
+                if( pxStreamBuffer->xTaskWaitingToReceive != NULL )
+                {
+                    ( void ) xTaskNotifyIndexedFromISR( pxStreamBuffer->xTaskWaitingToReceive,
+                                                        pxStreamBuffer->uxNotificationIndex,
+                                                        ( uint32_t ) 0,
+                                                        eNoAction,
+                                                        pxHigherPriorityTaskWoken );
+                    pxStreamBuffer->xTaskWaitingToReceive = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_FULL;
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, ( ( xReturn == pdPASS ) ? xItemSize : ( size_t ) 0 ) );
+    traceRETURN_xStreamBufferSendItemFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReceiveItem( StreamBufferHandle_t xStreamBuffer,
+                                     void * pvItem,
+                                     TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xItemSize, xBytesAvailable, xNextTail;
+    TimeOut_t xTimeOut;
+    BaseType_t xReturn;
+
+    traceENTER_xStreamBufferReceiveItem( xStreamBuffer, pvItem, xTicksToWait );
+
+    configASSERT( pvItem );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_SPSC_QUEUE ) != ( uint8_t ) 0 );
+
+    xItemSize = pxStreamBuffer->xTriggerLevelBytes;
+    xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+    if( ( xBytesAvailable < xItemSize ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+
+                /* As in xStreamBufferSendItem(), check again now the writer
+                 * can see this task is waiting. */
+                portMEMORY_BARRIER();
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable >= xItemSize )
+                {
+                    pxStreamBuffer->xTaskWaitingToReceive = NULL;
+                    sbEXIT_CRITICAL( pxStreamBuffer );
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        } while( ( xBytesAvailable < xItemSize ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xBytesAvailable >= xItemSize )
+    {
+        /* Only the reader updates xTail, so the item can be copied out and
+         * then freed by a single store to xTail without a critical section. */
+        portMEMORY_BARRIER();
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvItem, xItemSize, pxStreamBuffer->xTail );
+        portMEMORY_BARRIER();
+        pxStreamBuffer->xTail = xNextTail;
+        portMEMORY_BARRIER();
+
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xItemSize );
+
+        /* Was a task waiting for space in the buffer? */
+        if( pxStreamBuffer->xTaskWaitingToSend != NULL )
+        {
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                if( pxStreamBuffer->xTaskWaitingToSend != NULL )
+                {
+                    ( void ) xTaskNotifyIndexed( pxStreamBuffer->xTaskWaitingToSend,
+                                                 pxStreamBuffer->uxNotificationIndex,
+                                                 ( uint32_t ) 0,
+                                                 eNoAction );
+                    pxStreamBuffer->xTaskWaitingToSend = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        xReturn = errQUEUE_EMPTY;
+    }
+
+    traceRETURN_xStreamBufferReceiveItem( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReceiveItemFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void * pvItem,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xItemSize, xNextTail;
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xReturn;
+
+    traceENTER_xStreamBufferReceiveItemFromISR( xStreamBuffer, pvItem, pxHigherPriorityTaskWoken );
+
+    configASSERT( pvItem );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_SPSC_QUEUE ) != ( uint8_t ) 0 );
+
+    xItemSize = pxStreamBuffer->xTriggerLevelBytes;
+
+    if( prvBytesInBuffer( pxStreamBuffer ) >= xItemSize )
+    {
+        portMEMORY_BARRIER();
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvItem, xItemSize, pxStreamBuffer->xTail );
+        portMEMORY_BARRIER();
+        pxStreamBuffer->xTail = xNextTail;
+        portMEMORY_BARRIER();
+
+        /* Interrupts are only masked if a task is waiting for space. */
+        if( pxStreamBuffer->xTaskWaitingToSend != NULL )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
+            {
+                if( pxStreamBuffer->xTaskWaitingToSend != NULL )
+                {
+                    ( void ) xTaskNotifyIndexedFromISR( pxStreamBuffer->xTaskWaitingToSend,
+                                                        pxStreamBuffer->uxNotificationIndex,
+                                                        ( uint32_t ) 0,
+                                                        eNoAction,
+                                                        pxHigherPriorityTaskWoken );
+                    pxStreamBuffer->xTaskWaitingToSend = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_EMPTY;
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, ( ( xReturn == pdPASS ) ? xItemSize : ( size_t ) 0 ) );
+    traceRETURN_xStreamBufferReceiveItemFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferGetWriteRegion( StreamBufferHandle_t xStreamBuffer,
+                                    void ** ppvRegion,
+                                    TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xSpace, xHead;
+    TimeOut_t xTimeOut;
+
+    traceENTER_xStreamBufferGetWriteRegion( xStreamBuffer, ppvRegion, xTicksToWait );
+
+    configASSERT( ppvRegion );
+    configASSERT( pxStreamBuffer );
+
+    /* Regions bypass the length that precedes each message, so are only
+     * available on stream buffers. */
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_SPSC_QUEUE | sbFLAGS_IS_MPMC_BUFFER ) ) == ( uint8_t ) 0 );
+
+    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+    if( ( xSpace == ( size_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Wait until at least one byte is free in the stream buffer. */
+            sbENTER_CRITICAL( pxStreamBuffer );
+            {
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                if( xSpace == ( size_t ) 0 )
+                {
+                    /* Clear notification state as going to wait for space. */
+                    ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                    /* Should only be one writer. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    sbEXIT_CRITICAL( pxStreamBuffer );
+                    break;
+                }
+            }
+            sbEXIT_CRITICAL( pxStreamBuffer );
+
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        } while( ( xSpace == ( size_t ) 0 ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xSpace > ( size_t ) 0 )
+    {
+        /* Only the writer moves xHead, and the reader can only increase the
+         * free space, so the region remains valid until it is committed.  The
+         * region stops at the end of the storage area. */
+        xHead = pxStreamBuffer->xHead;
+        xSpace = configMIN( xSpace, pxStreamBuffer->xLength - xHead );
+        *ppvRegion = ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        *ppvRegion = NULL;
+    }
+
+    traceRETURN_xStreamBufferGetWriteRegion( xSpace );
+
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommitWriteRegion( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xBytesWritten )
+{
+    size_t xHead, xSpace;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_SPSC_QUEUE | sbFLAGS_IS_MPMC_BUFFER ) ) == ( uint8_t ) 0 );
+
+    /* The region cannot have shrunk since it was obtained, so this is at least
+     * the length xStreamBufferGetWriteRegion() returned. */
+    xHead = pxStreamBuffer->xHead;
+    xSpace = configMIN( xStreamBufferSpacesAvailable( pxStreamBuffer ), pxStreamBuffer->xLength - xHead );
+
+    /* Cannot commit more than the region contains. */
+    configASSERT( xBytesWritten <= xSpace );
+    xBytesWritten = configMIN( xBytesWritten, xSpace );
+
+    if( xBytesWritten > ( size_t ) 0 )
+    {
+        xHead += xBytesWritten;
+
+        if( xHead >= pxStreamBuffer->xLength )
+        {
+            xHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Ensure the data written into the region is visible before the
+         * reader can see the new head. */
+        portMEMORY_BARRIER();
+        pxStreamBuffer->xHead = xHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xBytesWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xBytesWritten )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    traceENTER_xStreamBufferCommitWrite( xStreamBuffer, xBytesWritten );
+
+    xReturn = prvCommitWriteRegion( pxStreamBuffer, xBytesWritten );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xStreamBufferCommitWrite( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xBytesWritten,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    traceENTER_xStreamBufferCommitWriteFromISR( xStreamBuffer, xBytesWritten, pxHigherPriorityTaskWoken );
+
+    xReturn = prvCommitWriteRegion( pxStreamBuffer, xBytesWritten );
+
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            /* MISRA Ref 4.7.1 [Return value shall be checked] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+            /* coverity[misra_c_2012_directive_4_7_violation] */
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+    traceRETURN_xStreamBufferCommitWriteFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferGetReadRegion( StreamBufferHandle_t xStreamBuffer,
+                                   void ** ppvRegion,
+                                   TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xBytesAvailable, xMinimumBytes, xTail;
+
+    traceENTER_xStreamBufferGetReadRegion( xStreamBuffer, ppvRegion, xTicksToWait );
+
+    configASSERT( ppvRegion );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_SPSC_QUEUE | sbFLAGS_IS_MPMC_BUFFER ) ) == ( uint8_t ) 0 );
+
+    /* As in xStreamBufferReceive(), force the task to block if a batching
+     * buffer contains less bytes than the trigger level. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_BATCHING_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xMinimumBytes = pxStreamBuffer->xTriggerLevelBytes;
+    }
+    else
+    {
+        xMinimumBytes = 0;
+    }
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        sbENTER_CRITICAL( pxStreamBuffer );
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            if( xBytesAvailable <= xMinimumBytes )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClearIndexed( NULL, pxStreamBuffer->uxNotificationIndex );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        sbEXIT_CRITICAL( pxStreamBuffer );
+
+        if( xBytesAvailable <= xMinimumBytes )
+        {
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            ( void ) xTaskNotifyWaitIndexed( pxStreamBuffer->uxNotificationIndex, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            /* Recheck the data available after blocking. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    }
+
+    if( xBytesAvailable > xMinimumBytes )
+    {
+        /* Only the reader moves xTail, and the writer can only add data, so
+         * the region remains valid until it is consumed.  The region stops at
+         * the end of the storage area.  Ensure the data is not read before the
+         * head that published it. */
+        portMEMORY_BARRIER();
+        xTail = pxStreamBuffer->xTail;
+        xBytesAvailable = configMIN( xBytesAvailable, pxStreamBuffer->xLength - xTail );
+        *ppvRegion = ( void * ) &( pxStreamBuffer->pucBuffer[ xTail ] );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        xBytesAvailable = 0;
+        *ppvRegion = NULL;
+    }
+
+    traceRETURN_xStreamBufferGetReadRegion( xBytesAvailable );
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvConsumeReadRegion( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xBytesRead )
+{
+    size_t xTail, xBytesAvailable;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & ( sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_SPSC_QUEUE | sbFLAGS_IS_MPMC_BUFFER ) ) == ( uint8_t ) 0 );
+
+    xTail = pxStreamBuffer->xTail;
+    xBytesAvailable = configMIN( prvBytesInBuffer( pxStreamBuffer ), pxStreamBuffer->xLength - xTail );
+
+    /* Cannot consume more than the region contains. */
+    configASSERT( xBytesRead <= xBytesAvailable );
+    xBytesRead = configMIN( xBytesRead, xBytesAvailable );
+
+    if( xBytesRead > ( size_t ) 0 )
+    {
+        xTail += xBytesRead;
+
+        if( xTail >= pxStreamBuffer->xLength )
+        {
+            xTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Ensure the reader has finished with the region before the writer
+         * can reuse the space. */
+        portMEMORY_BARRIER();
+        pxStreamBuffer->xTail = xTail;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xBytesRead;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer,
+                             size_t xBytesRead )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    traceENTER_xStreamBufferConsume( xStreamBuffer, xBytesRead );
+
+    xReturn = prvConsumeReadRegion( pxStreamBuffer, xBytesRead );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn > ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReturn );
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_xStreamBufferConsume( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xBytesRead,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    traceENTER_xStreamBufferConsumeFromISR( xStreamBuffer, xBytesRead, pxHigherPriorityTaskWoken );
+
+    xReturn = prvConsumeReadRegion( pxStreamBuffer, xBytesRead );
+
+    /* Was a task waiting for space in the buffer? */
+    if( xReturn > ( size_t ) 0 )
+    {
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReturn );
+    traceRETURN_xStreamBufferConsumeFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+    size_t xTail;
+
+    traceENTER_xStreamBufferIsEmpty( xStreamBuffer );
+
+    configASSERT( pxStreamBuffer );
+
+    /* True if no bytes are available. */
+    xTail = pxStreamBuffer->xTail;
+
+    if( pxStreamBuffer->xHead == xTail )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    traceRETURN_xStreamBufferIsEmpty( xReturn );
 
     return xReturn;
 }
@@ -1374,6 +3693,11 @@ BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
     {
         xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
     }
+    else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_SPSC_QUEUE ) != ( uint8_t ) 0 )
+    {
+        /* An SPSC queue is full when there is no space for another item. */
+        xBytesToStoreMessageLength = pxStreamBuffer->xTriggerLevelBytes - ( size_t ) 1;
+    }
     else
     {
         xBytesToStoreMessageLength = 0;
@@ -1409,7 +3733,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
     {
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
         {
@@ -1426,7 +3750,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
 
     traceRETURN_xStreamBufferSendCompletedFromISR( xReturn );
 
@@ -1448,7 +3772,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
     /* MISRA Ref 4.7.1 [Return value shall be checked] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
     /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    uxSavedInterruptStatus = sbENTER_CRITICAL_FROM_ISR( pxStreamBuffer );
     {
         if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
         {
@@ -1465,7 +3789,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    sbEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus, pxStreamBuffer );
 
     traceRETURN_xStreamBufferReceiveCompletedFromISR( xReturn );
 
@@ -1563,6 +3887,114 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+static size_t prvWriteVectorToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                      const StreamBufferConstVector_t * pxVectors,
+                                      size_t xCount,
+                                      size_t xHead )
+{
+    size_t xLength;
+    UBaseType_t uxVector = 0;
+
+    while( xCount > ( size_t ) 0 )
+    {
+        xLength = configMIN( pxVectors[ uxVector ].xLength, xCount );
+
+        /* Empty vectors are skipped. */
+        if( xLength > ( size_t ) 0 )
+        {
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxVectors[ uxVector ].pvData, xLength, xHead );
+            xCount -= xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxVector++;
+    }
+
+    return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadVectorFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                       const StreamBufferVector_t * pxVectors,
+                                       size_t xCount,
+                                       size_t xTail )
+{
+    size_t xLength;
+    UBaseType_t uxVector = 0;
+
+    while( xCount > ( size_t ) 0 )
+    {
+        xLength = configMIN( pxVectors[ uxVector ].xLength, xCount );
+
+        if( xLength > ( size_t ) 0 )
+        {
+            /* MISRA Ref 11.5.5 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pxVectors[ uxVector ].pvData, xLength, xTail );
+            xCount -= xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxVector++;
+    }
+
+    return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvVectorLength( const StreamBufferVector_t * pxVectors,
+                               UBaseType_t uxVectorCount )
+{
+    size_t xLength = 0;
+    UBaseType_t uxVector;
+
+    for( uxVector = 0; uxVector < uxVectorCount; uxVector++ )
+    {
+        xLength = prvAddVectorLength( xLength, pxVectors[ uxVector ].pvData, pxVectors[ uxVector ].xLength );
+    }
+
+    return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvConstVectorLength( const StreamBufferConstVector_t * pxVectors,
+                                    UBaseType_t uxVectorCount )
+{
+    size_t xLength = 0;
+    UBaseType_t uxVector;
+
+    for( uxVector = 0; uxVector < uxVectorCount; uxVector++ )
+    {
+        xLength = prvAddVectorLength( xLength, pxVectors[ uxVector ].pvData, pxVectors[ uxVector ].xLength );
+    }
+
+    return xLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAddVectorLength( size_t xTotalLength,
+                                  const void * pvData,
+                                  size_t xLength )
+{
+    configASSERT( ( pvData != NULL ) || ( xLength == ( size_t ) 0 ) );
+
+    /* Overflow? */
+    configASSERT( ( xTotalLength + xLength ) >= xTotalLength );
+
+    return xTotalLength + xLength;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 {
     /* Returns the distance between xTail and xHead. */
@@ -1605,12 +4037,35 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
     }
     #endif
 
-    ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) );
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        /* The stream buffer is reset from within its own critical section, so
+         * the spinlock, which is the last member of the structure, must not be
+         * cleared. */
+        ( void ) memset( ( void * ) pxStreamBuffer, 0x00, offsetof( StreamBuffer_t, xSpinlock ) );
+    }
+    #else
+    {
+        ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) );
+    }
+    #endif
     pxStreamBuffer->pucBuffer = pucBuffer;
     pxStreamBuffer->xLength = xBufferSizeBytes;
     pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
     pxStreamBuffer->ucFlags = ucFlags;
     pxStreamBuffer->uxNotificationIndex = tskDEFAULT_INDEX_TO_NOTIFY;
+
+    #if ( ( configUSE_MPMC_STREAM_BUFFERS == 1 ) || ( configUSE_BROADCAST_MESSAGE_BUFFERS == 1 ) )
+    {
+        vListInitialise( &( pxStreamBuffer->xTasksWaitingToReceive ) );
+    }
+    #endif
+
+    #if ( configUSE_MPMC_STREAM_BUFFERS == 1 )
+    {
+        vListInitialise( &( pxStreamBuffer->xTasksWaitingToSend ) );
+    }
+    #endif
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
     {
         pxStreamBuffer->pxSendCompletedCallback = pxSendCompletedCallback;
@@ -64,6 +64,57 @@
     #include <stdio.h>
 #endif /* configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) */
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* Tasks created with xTaskCreateEDF() have priority configEDF_PRIORITY.  The
+ * ready list for that priority is held in order of absolute deadline, rather
+ * than being used round robin, so the task with the earliest deadline is
+ * always at its head and is the task selected to run at that priority.  Within
+ * that priority a task preempts the running task if its deadline is earlier. */
+    #define taskTASK_PREEMPTS_CURRENT_TASK( pxTCB )                           \
+    ( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||                 \
+      ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&    \
+        ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) && \
+        ( prvEDFDeadlineIsEarlier( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) ) )
+
+/* Before the scheduler starts the last task created at the highest priority
+ * becomes the current task, except at configEDF_PRIORITY where it is the task
+ * with the earliest deadline, as EDF tasks are not time sliced. */
+    #define taskNEW_TASK_RUNS_BEFORE_CURRENT_TASK( pxTCB )              \
+    ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) ? \
+      ( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) ) :                     \
+      ( pxCurrentTCB->uxPriority <= ( pxTCB )->uxPriority ) )
+
+    #define taskINSERT_INTO_READY_LIST( pxTCB )                                                                \
+    do {                                                                                                       \
+        if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )                                      \
+        {                                                                                                      \
+            prvAddTaskToEDFReadyList( pxTCB );                                                                 \
+        }                                                                                                      \
+        else                                                                                                   \
+        {                                                                                                      \
+            listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                      \
+    } while( 0 )
+
+    #define taskGET_OWNER_OF_NEXT_READY_TASK( pxTCB, uxTopPriority )                                 \
+    do {                                                                                             \
+        if( ( uxTopPriority ) == ( UBaseType_t ) configEDF_PRIORITY )                                \
+        {                                                                                            \
+            ( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) ); \
+        }                                                                                            \
+        else                                                                                         \
+        {                                                                                            \
+            listGET_OWNER_OF_NEXT_ENTRY( ( pxTCB ), &( pxReadyTasksLists[ ( uxTopPriority ) ] ) );   \
+        }                                                                                            \
+    } while( 0 )
+#else /* if ( configUSE_EDF_SCHEDULING == 1 ) */
+    #define taskTASK_PREEMPTS_CURRENT_TASK( pxTCB )                     ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+    #define taskNEW_TASK_RUNS_BEFORE_CURRENT_TASK( pxTCB )              ( pxCurrentTCB->uxPriority <= ( pxTCB )->uxPriority )
+    #define taskINSERT_INTO_READY_LIST( pxTCB )                         listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+    #define taskGET_OWNER_OF_NEXT_READY_TASK( pxTCB, uxTopPriority )    listGET_OWNER_OF_NEXT_ENTRY( ( pxTCB ), &( pxReadyTasksLists[ ( uxTopPriority ) ] ) )
+#endif /* if ( configUSE_EDF_SCHEDULING == 1 ) */
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -86,7 +137,7 @@
 
         #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB ) \
     do {                                                        \
-        if( pxCurrentTCB->uxPriority < ( pxTCB )->uxPriority )  \
+        if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )           \
         {                                                       \
             portYIELD_WITHIN_API();                             \
         }                                                       \
@@ -156,7 +207,7 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_READY_PRIORITY_BITMAP == 0 ) )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -188,7 +239,7 @@
                                                                                          \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskGET_OWNER_OF_NEXT_READY_TASK( pxCurrentTCB, uxTopPriority );                     \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } while( 0 ) /* taskSELECT_HIGHEST_PRIORITY_TASK */
     #else /* if ( configNUMBER_OF_CORES == 1 ) */
@@ -205,6 +256,68 @@
     #define taskRESET_READY_PRIORITY( uxPriority )
     #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
 
+#elif ( configUSE_READY_PRIORITY_BITMAP == 1 )
+
+/* If configUSE_READY_PRIORITY_BITMAP is 1 then task selection is performed
+ * using a generic two level bitmap, so the highest priority that has Ready
+ * state tasks is found in constant time on any architecture.  Bit n of
+ * ulReadyPriorityGroups is set if any bit of ulReadyPriorities[ n ] is set, and
+ * bit m of ulReadyPriorities[ n ] is set if there are Ready state tasks of
+ * priority ( ( n * 32 ) + m ). */
+
+    #define taskREADY_PRIORITY_BITMAP_WORDS    ( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+/*-----------------------------------------------------------*/
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                             \
+    do {                                                                                        \
+        ulReadyPriorities[ ( uxPriority ) >> 5 ] |= ( uint32_t ) 1U << ( ( uxPriority ) & 0x1FU ); \
+        ulReadyPriorityGroups |= ( uint32_t ) 1U << ( ( uxPriority ) >> 5 );                    \
+    } while( 0 ) /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskGET_TOP_READY_PRIORITY( uxTopPriority )                                                            \
+    do {                                                                                                           \
+        const UBaseType_t uxGroup = listGET_MSB_POSITION( ulReadyPriorityGroups );                                 \
+        ( uxTopPriority ) = ( UBaseType_t ) ( ( uxGroup << 5 ) + listGET_MSB_POSITION( ulReadyPriorities[ uxGroup ] ) ); \
+    } while( 0 )
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                  \
+    do {                                                                                        \
+        UBaseType_t uxTopPriority;                                                              \
+                                                                                                \
+        /* Find the highest priority list that contains ready tasks. */                         \
+        taskGET_TOP_READY_PRIORITY( uxTopPriority );                                            \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
+        taskGET_OWNER_OF_NEXT_READY_TASK( pxCurrentTCB, uxTopPriority );                       \
+    } while( 0 )
+
+/*-----------------------------------------------------------*/
+
+/* Clear the bit for the priority, and the group bit too if no other priority
+ * in the same group has Ready state tasks.  The second parameter is not used
+ * and is only present to match the port optimised form of the macro. */
+    #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )                             \
+    do {                                                                                           \
+        ulReadyPriorities[ ( uxPriority ) >> 5 ] &= ~( ( uint32_t ) 1U << ( ( uxPriority ) & 0x1FU ) ); \
+                                                                                                   \
+        if( ulReadyPriorities[ ( uxPriority ) >> 5 ] == 0U )                                       \
+        {                                                                                          \
+            ulReadyPriorityGroups &= ~( ( uint32_t ) 1U << ( ( uxPriority ) >> 5 ) );              \
+        }                                                                                          \
+    } while( 0 )
+
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    do {                                                                                               \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );                        \
+        }                                                                                              \
+    } while( 0 )
+
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
@@ -223,7 +336,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskGET_OWNER_OF_NEXT_READY_TASK( pxCurrentTCB, uxTopPriority );                       \
     } while( 0 )
 
 /*-----------------------------------------------------------*/
@@ -245,19 +358,108 @@
 
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
-#define taskSWITCH_DELAYED_LISTS()                                                \
-    do {                                                                          \
-        List_t * pxTemp;                                                          \
-                                                                                  \
-        /* The delayed tasks list should be empty when the lists are switched. */ \
-        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );               \
-                                                                                  \
-        pxTemp = pxDelayedTaskList;                                               \
-        pxDelayedTaskList = pxOverflowDelayedTaskList;                            \
-        pxOverflowDelayedTaskList = pxTemp;                                       \
-        xNumOfOverflows = ( BaseType_t ) ( xNumOfOverflows + 1 );                 \
-        prvResetNextTaskUnblockTime();                                            \
+#if ( configUSE_DELAYED_TASK_HEAP == 0 )
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    do {                                                                              \
+        List_t * pxTemp;                                                              \
+                                                                                      \
+        /* The delayed tasks list should be empty when the lists are switched. */     \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );                   \
+                                                                                      \
+        pxTemp = pxDelayedTaskList;                                                   \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                \
+        pxOverflowDelayedTaskList = pxTemp;                                           \
+        xNumOfOverflows = ( BaseType_t ) ( xNumOfOverflows + 1 );                     \
+        prvResetNextTaskUnblockTime();                                                \
+    } while( 0 )
+#else /* if ( configUSE_DELAYED_TASK_HEAP == 0 ) */
+    #define taskSWITCH_DELAYED_LISTS()                                                \
+    do {                                                                              \
+        List_t * pxTemp;                                                              \
+        TCB_t * pxTempHeap;                                                           \
+                                                                                      \
+        /* The delayed tasks list should be empty when the lists are switched. */     \
+        configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );                   \
+        configASSERT( ( pxDelayedTaskHeap == NULL ) );                                \
+                                                                                      \
+        pxTemp = pxDelayedTaskList;                                                   \
+        pxDelayedTaskList = pxOverflowDelayedTaskList;                                \
+        pxOverflowDelayedTaskList = pxTemp;                                           \
+        pxTempHeap = pxDelayedTaskHeap;                                               \
+        pxDelayedTaskHeap = pxOverflowDelayedTaskHeap;                                \
+        pxOverflowDelayedTaskHeap = pxTempHeap;                                       \
+        xNumOfOverflows = ( BaseType_t ) ( xNumOfOverflows + 1 );                     \
+        prvResetNextTaskUnblockTime();                                                \
+    } while( 0 )
+#endif /* if ( configUSE_DELAYED_TASK_HEAP == 0 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_HEAP == 0 )
+
+/* The delayed task lists are kept sorted in wake time order, so the task that
+ * must be unblocked first is always at the head of the list. */
+    #define taskGET_FIRST_DELAYED_TASK()                        listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList )
+    #define taskINSERT_DELAYED_TASK( pxList, pxHeap, pxTCB )    vListInsert( ( pxList ), &( ( pxTCB )->xStateListItem ) )
+    #define taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB )
+
+#else /* if ( configUSE_DELAYED_TASK_HEAP == 0 ) */
+
+/* The delayed task lists only record which tasks are delayed, and are not kept
+ * in any particular order.  The wake time ordering is instead held in a
+ * pairing heap that is threaded through the TCBs of the delayed tasks, so the
+ * task that must be unblocked first is always at the root of the heap.  That
+ * makes adding a task to the Blocked state O(1) rather than O(n), and removing
+ * a task from the Blocked state O(log n) amortised. */
+    #define taskGET_FIRST_DELAYED_TASK()    ( pxDelayedTaskHeap )
+
+    #define taskINSERT_DELAYED_TASK( pxList, pxHeap, pxTCB )          \
+    do {                                                              \
+        listINSERT_END( ( pxList ), &( ( pxTCB )->xStateListItem ) ); \
+        ( pxHeap ) = prvDelayedHeapInsert( ( pxHeap ), ( pxTCB ) );   \
+    } while( 0 )
+
+/* Must be called before the task's xStateListItem is removed from the list it
+ * is in, as the containing list determines the heap the task is held in. */
+    #define taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB )    prvRemoveTaskFromDelayedHeap( pxTCB )
+
+#endif /* if ( configUSE_DELAYED_TASK_HEAP == 0 ) */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * When the tick is dynamic, a task that enters the Ready state at the priority
+ * of the running task without causing a context switch means the running task
+ * must now be time sliced, so the very next tick interrupt must not be skipped.
+ */
+#if ( ( configUSE_DYNAMIC_TICK == 1 ) && ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+    #define taskDYNAMIC_TICK_TASK_READY( pxTCB )                                                           \
+    do {                                                                                                   \
+        if( ( xSchedulerRunning != pdFALSE ) && ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) )    \
+        {                                                                                                  \
+            portSET_NEXT_TICK_INTERRUPT( ( TickType_t ) 1 );                                               \
+        }                                                                                                  \
     } while( 0 )
+#else
+    #define taskDYNAMIC_TICK_TASK_READY( pxTCB )
+#endif
+
+/*
+ * When configUSE_DYNAMIC_TICK is set to 1 tick interrupts only occur when the
+ * kernel has work to do, so tick periods may have elapsed that are not yet
+ * included in xTickCount.  taskCURRENT_TICK_COUNT() returns the tick count
+ * including those tick periods, and taskOVERFLOW_COUNT_AT() the number of times
+ * that tick count has overflowed.  taskOVERFLOW_COUNT_AT() must be called from
+ * a critical section.
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    #define taskCURRENT_TICK_COUNT()    prvGetCurrentTickCount()
+    #define taskOVERFLOW_COUNT_AT( xCurrentTickCount ) \
+    ( ( ( xCurrentTickCount ) < xTickCount ) ? ( BaseType_t ) ( xNumOfOverflows + ( BaseType_t ) 1 ) : xNumOfOverflows )
+#else
+    #define taskCURRENT_TICK_COUNT()                      xTickCount
+    #define taskOVERFLOW_COUNT_AT( xCurrentTickCount )    xNumOfOverflows
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -265,13 +467,59 @@
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                     \
-    do {                                                                                                   \
-        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-        listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+#if ( configUSE_PER_CORE_READY_LISTS == 0 )
+    #define prvAddTaskToReadyList( pxTCB )                                                                     \
+    do {                                                                                                       \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                               \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                    \
+        taskINSERT_INTO_READY_LIST( pxTCB );                                                                   \
+        taskDYNAMIC_TICK_TASK_READY( pxTCB );                                                                  \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                          \
     } while( 0 )
+
+/* The ready list that holds pxTCB if pxTCB is in the Ready state at priority
+ * uxPriority. */
+    #define taskREADY_LIST_FOR_TASK( pxTCB, uxPriority )    ( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+/* The number of Ready state tasks, including any that are running, at
+ * priority uxPriority. */
+    #define taskREADY_TASK_COUNT( uxPriority )              listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+#else /* if ( configUSE_PER_CORE_READY_LISTS == 0 ) */
+
+/* Each core has its own ready lists.  A task is added to the ready list of the
+ * core it last ran on, or was last assigned to, which is always the core it
+ * is running on if it is running.  uxCoreTopReadyPriority[] holds an upper
+ * bound on the priority of the tasks in each core's ready lists in the same way
+ * uxTopReadyPriority does for all the cores. */
+    #define taskRECORD_CORE_READY_PRIORITY( xCoreID, uxPriority )      \
+    do {                                                               \
+        if( ( uxPriority ) > uxCoreTopReadyPriority[ ( xCoreID ) ] )   \
+        {                                                              \
+            uxCoreTopReadyPriority[ ( xCoreID ) ] = ( uxPriority );    \
+        }                                                              \
+    } while( 0 )
+
+    #define prvAddTaskToReadyList( pxTCB )                                                                                                    \
+    do {                                                                                                                                      \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                                                              \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                                                   \
+        taskRECORD_CORE_READY_PRIORITY( ( pxTCB )->xReadyListCoreID, ( pxTCB )->uxPriority );                                                 \
+        listINSERT_END( &( pxCoreReadyTasksLists[ ( pxTCB )->xReadyListCoreID ][ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                                                         \
+    } while( 0 )
+
+/* Move a Ready state task to the end of the ready list of core xCoreID. */
+    #define prvMoveTaskToCoreReadyList( pxTCB, xCoreID )                                                                                      \
+    do {                                                                                                                                      \
+        ( void ) uxListRemove( &( ( pxTCB )->xStateListItem ) );                                                                              \
+        ( pxTCB )->xReadyListCoreID = ( xCoreID );                                                                                            \
+        taskRECORD_CORE_READY_PRIORITY( ( xCoreID ), ( pxTCB )->uxPriority );                                                                 \
+        listINSERT_END( &( pxCoreReadyTasksLists[ ( xCoreID ) ][ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) );                 \
+    } while( 0 )
+
+    #define taskREADY_LIST_FOR_TASK( pxTCB, uxPriority )    ( &( pxCoreReadyTasksLists[ ( pxTCB )->xReadyListCoreID ][ ( uxPriority ) ] ) )
+    #define taskREADY_TASK_COUNT( uxPriority )              prvGetReadyTaskCount( uxPriority )
+#endif /* if ( configUSE_PER_CORE_READY_LISTS == 0 ) */
 /*-----------------------------------------------------------*/
 
 /*
@@ -298,6 +546,30 @@
     #define taskEVENT_LIST_ITEM_VALUE_IN_USE    ( ( uint64_t ) 0x8000000000000000U )
 #endif
 
+/* Set the value of a task's event list item to reflect a change in the task's
+ * priority.  The value of an item must not change while it is in a list that
+ * has a priority index, so if the task is blocked on such a list the item is
+ * moved to the position that matches its new value. */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    #define taskSET_EVENT_LIST_ITEM_VALUE( pxTCB, xValue )                                      \
+    do {                                                                                        \
+        List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( ( pxTCB )->xEventListItem ) ); \
+                                                                                                \
+        if( ( pxEventList != NULL ) && ( pxEventList->pxPriorityIndex != NULL ) )               \
+        {                                                                                       \
+            ( void ) uxListRemove( &( ( pxTCB )->xEventListItem ) );                            \
+            listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ), ( xValue ) );              \
+            vListInsert( pxEventList, &( ( pxTCB )->xEventListItem ) );                         \
+        }                                                                                       \
+        else                                                                                    \
+        {                                                                                       \
+            listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ), ( xValue ) );              \
+        }                                                                                       \
+    } while( 0 )
+#else
+    #define taskSET_EVENT_LIST_ITEM_VALUE( pxTCB, xValue )    listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xEventListItem ), ( xValue ) )
+#endif
+
 /* Indicates that the task is not actively running on any core. */
 #define taskTASK_NOT_RUNNING           ( ( BaseType_t ) ( -1 ) )
 
@@ -323,8 +595,28 @@
     #define portDECREMENT_CRITICAL_NESTING_COUNT()    ( pxCurrentTCBs[ portGET_CORE_ID() ]->uxCriticalNesting-- )
 #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( portCRITICAL_NESTING_IN_TCB == 1 ) ) */
 
+/* The number of critical sections the calling core is nested within that hold
+ * the kernel locks, as opposed to the spinlock of a single data group.  Both
+ * kinds of critical section share the critical nesting count so interrupts
+ * remain masked, and yields remain pending, until the outermost one exits. */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #define taskKERNEL_CRITICAL_NESTING_COUNT()    ( portGET_CRITICAL_NESTING_COUNT() - uxDataGroupCriticalNesting[ portGET_CORE_ID() ] )
+#elif ( configNUMBER_OF_CORES > 1 )
+    #define taskKERNEL_CRITICAL_NESTING_COUNT()    portGET_CRITICAL_NESTING_COUNT()
+#endif
+
 #define taskBITS_PER_BYTE    ( ( size_t ) 8 )
 
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+/* The length of a tick period in units of the high resolution counter. */
+    #define taskTICK_PERIOD_NS    ( ( uint64_t ) 1000000000U / ( uint64_t ) configTICK_RATE_HZ )
+
+/* The value of ullNextDeadlineNs when no task has a high resolution deadline. */
+    #define taskNO_DEADLINE_NS    ( ~( ( uint64_t ) 0U ) )
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
+
 #if ( configNUMBER_OF_CORES > 1 )
 
 /* Yields the given core. This must be called from a critical section and xCoreID
@@ -369,11 +661,19 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 
     ListItem_t xStateListItem;                  /**< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
     ListItem_t xEventListItem;                  /**< Used to reference a task from an event list. */
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+        struct tskTaskControlBlock * pxHeapChild; /**< Left most child of the task in the delayed task heap. */
+        struct tskTaskControlBlock * pxHeapNext;  /**< Next sibling of the task in the delayed task heap. */
+        struct tskTaskControlBlock * pxHeapPrev;  /**< Previous sibling of the task in the delayed task heap, or its parent if the task is the left most child.  NULL if the task is the root of the heap. */
+    #endif
     UBaseType_t uxPriority;                     /**< The priority of the task.  0 is the lowest priority. */
     StackType_t * pxStack;                      /**< Points to the start of the stack. */
     #if ( configNUMBER_OF_CORES > 1 )
         volatile BaseType_t xTaskRunState;      /**< Used to identify the core the task is running on, if the task is running. Otherwise, identifies the task's state - not running or yielding. */
         UBaseType_t uxTaskAttributes;           /**< Task's attributes - currently used to identify the idle tasks. */
+        #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+            BaseType_t xReadyListCoreID;        /**< Identifies the core whose ready lists hold the task when the task is in the Ready state. */
+        #endif
     #endif
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /**< Descriptive name given to the task when created.  Facilitates debugging only. */
 
@@ -399,6 +699,12 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         UBaseType_t uxMutexesHeld;
     #endif
 
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xRelativeDeadline; /**< The deadline of each job of the task relative to the job's release time.  0 if the task was not created with xTaskCreateEDF(). */
+        TickType_t xPeriod;           /**< The time between the release of successive jobs of the task. */
+        TickType_t xAbsoluteDeadline; /**< The tick count by which the task's current job must complete.  Orders the task within the configEDF_PRIORITY ready list. */
+    #endif
+
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         TaskHookFunction_t pxTaskTag;
     #endif
@@ -411,6 +717,18 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /**< Stores the amount of time the task has spent in the Running state. */
     #endif
 
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulBudget;     /**< The run time the task may use in each budget period.  Zero if the task does not have a budget. */
+        configRUN_TIME_COUNTER_TYPE ulBudgetUsed; /**< The run time the task has used in the current budget period. */
+        TickType_t xBudgetPeriod;                 /**< The length of the budget period in ticks. */
+        TickType_t xBudgetPeriodStart;            /**< The tick count at which the current budget period started. */
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+        ListItem_t xDeadlineListItem; /**< Used to reference the task from xDeadlineTaskList while it is blocked with a high resolution deadline. */
+        uint64_t ullDeadlineNs;       /**< The high resolution deadline of the blocking call the task is making, or 0 if the call is not using a high resolution deadline. */
+    #endif
+
     #if ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 )
         configTLS_BLOCK_TYPE xTLSBlock; /**< Memory block used as Thread Local Storage (TLS) Block for the task. */
     #endif
@@ -456,13 +774,33 @@ typedef tskTCB TCB_t;
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /**< Prioritised ready tasks. */
+#if ( configUSE_PER_CORE_READY_LISTS == 0 )
+    PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /**< Prioritised ready tasks. */
+#else
+    PRIVILEGED_DATA static List_t pxCoreReadyTasksLists[ configNUMBER_OF_CORES ][ configMAX_PRIORITIES ]; /**< Prioritised ready tasks, per core. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxCoreTopReadyPriority[ configNUMBER_OF_CORES ];          /**< Upper bound on the priority of the tasks in each core's ready lists. */
+#endif
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /**< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /**< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+    PRIVILEGED_DATA static TCB_t * volatile pxDelayedTaskHeap = NULL;         /**< Root of the heap that orders the tasks in pxDelayedTaskList by wake time. */
+    PRIVILEGED_DATA static TCB_t * volatile pxOverflowDelayedTaskHeap = NULL; /**< Root of the heap that orders the tasks in pxOverflowDelayedTaskList by wake time. */
+
+#endif
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    PRIVILEGED_DATA static List_t xDeadlineTaskList;                            /**< Blocked tasks that have a high resolution deadline.  Not ordered, as few tasks are expected to block with a high resolution deadline at any one time. */
+    PRIVILEGED_DATA static uint64_t ullNextDeadlineNs = taskNO_DEADLINE_NS;     /**< No task in xDeadlineTaskList has a deadline earlier than this.  The high resolution timer is programmed to interrupt at this time. */
+    PRIVILEGED_DATA static volatile BaseType_t xDeadlineCheckPending = pdFALSE; /**< Set when the high resolution timer interrupts while the scheduler is suspended. */
+
+#endif
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /**< Tasks that have been deleted - but their memory not yet freed. */
@@ -486,14 +824,27 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Ta
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+
+#if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorityGroups = 0U;
+    PRIVILEGED_DATA static volatile uint32_t ulReadyPriorities[ taskREADY_PRIORITY_BITMAP_WORDS ] = { 0U };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+
+#if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+    PRIVILEGED_DATA static BaseType_t xProcessingPendedTicks = pdFALSE; /**< Set while pended ticks are passed to xTaskIncrementTick(), so it processes them rather than deferring them again. */
+#endif
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];       /**< Holds the handles of the idle tasks.  The idle tasks are created automatically when the scheduler is started. */
 
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    PRIVILEGED_DATA static volatile UBaseType_t uxDataGroupCriticalNesting[ configNUMBER_OF_CORES ] = { 0U }; /**< The number of data group critical sections each core is nested within. */
+#endif
+
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
  * to determine the number of priority lists to read back from the remote target. */
@@ -557,6 +908,29 @@ static BaseType_t prvCreateIdleTasks( void );
     static void prvSelectHighestPriorityTask( BaseType_t xCoreID );
 #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+
+/*
+ * Returns a task of priority uxPriority that core xCoreID can run, or NULL if
+ * there is no such task.  Tasks that are not running are preferred over the
+ * task already running on xCoreID, and tasks in xCoreID's own ready list are
+ * preferred over tasks in the ready lists of the other cores.  A task taken
+ * from another core's ready list is moved to xCoreID's ready list.
+ * *pxListsEmpty is set to pdTRUE if no core has Ready state tasks of priority
+ * uxPriority.
+ */
+    static TCB_t * prvSearchCoreReadyLists( BaseType_t xCoreID,
+                                            UBaseType_t uxPriority,
+                                            BaseType_t * pxListsEmpty ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of Ready state tasks of priority uxPriority in the ready
+ * lists of all the cores.
+ */
+    static UBaseType_t prvGetReadyTaskCount( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_PER_CORE_READY_LISTS == 1 ) */
+
 /**
  * Utility task that simply returns pdTRUE if the task referenced by xTask is
  * currently in the Suspended state, or pdFALSE if the task referenced by xTask
@@ -675,12 +1049,100 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Return the number of ticks from the current tick count to the next tick the
+ * kernel must process, which is the sooner of the next time a task leaves the
+ * Blocked state and, if the running task is time sliced or has a budget, the
+ * next tick.  The timer service task blocks until the next timer expires, so
+ * timer expiry times are included in the time a task next leaves the Blocked
+ * state.
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    static TickType_t prvGetTicksToNextEvent( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from xTaskIncrementTick() to move every task whose wake time is at or
+ * before xConstTickCount from the delayed task list to the ready lists, then
+ * update xNextTaskUnblockTime.  Returns pdTRUE if a context switch is required
+ * on a single core system.
+ */
+#if ( configUSE_BATCHED_TICK_WAKE_UP == 1 )
+
+    static BaseType_t prvUnblockExpiredDelayedTasks( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from vTaskSwitchContext() to process the ticks that the tick
+ * interrupt left pending in xPendedTicks.
+ */
+#if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+
+    static void prvProcessDeferredTicks( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Return the tick count including the tick periods that have elapsed since the
+ * last tick interrupt.  Can be called from tasks and interrupts.
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    static TickType_t prvGetCurrentTickCount( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
  * will exit the Blocked state.
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+/*
+ * Return the number of ticks a task must block for to be sure the high
+ * resolution deadline ullDeadlineNs has passed when the block time expires, or
+ * 0 if ullDeadlineNs has already passed.
+ */
+    static TickType_t prvGetTicksToDeadline( uint64_t ullDeadlineNs ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the tasks in xDeadlineTaskList whose deadlines have passed from the
+ * Blocked state to the Ready state, then program the high resolution timer for
+ * the next deadline.  Must be called from a critical section while the
+ * scheduler is not suspended.  Returns pdTRUE if a context switch is required.
+ */
+    static BaseType_t prvCheckForExpiredDeadlines( void ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
+
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+/*
+ * Functions that maintain the pairing heaps used to order the delayed task
+ * lists by wake time when configUSE_DELAYED_TASK_HEAP is set to 1.  Each
+ * function takes the root of a heap and returns the new root of that heap.
+ */
+    static TCB_t * prvDelayedHeapMeld( TCB_t * pxFirst,
+                                       TCB_t * pxSecond ) PRIVILEGED_FUNCTION;
+    static TCB_t * prvDelayedHeapMergePairs( TCB_t * pxFirstSibling ) PRIVILEGED_FUNCTION;
+    static TCB_t * prvDelayedHeapInsert( TCB_t * pxRoot,
+                                         TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static TCB_t * prvDelayedHeapRemove( TCB_t * pxRoot,
+                                         TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove pxTCB from whichever delayed task heap it is in, if any.  Must be
+ * called before pxTCB is removed from the delayed task list.
+ */
+    static void prvRemoveTaskFromDelayedHeap( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_DELAYED_TASK_HEAP == 1 ) */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -711,6 +1173,47 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+/*
+ * Start a new budget period for the task pxTCB if its current budget period
+ * has ended, then return pdTRUE if the task has used its budget for the
+ * current period, otherwise pdFALSE.  ulUnchargedRunTime is run time the task
+ * has used that has not yet been added to its used budget.
+ */
+    static BaseType_t prvTaskBudgetExhausted( TCB_t * const pxTCB,
+                                              const configRUN_TIME_COUNTER_TYPE ulUnchargedRunTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called as the running task is switched out.  If the task has used its budget
+ * for the current period and is still in the Ready state then it is moved to
+ * the Blocked state until its next budget period starts.
+ */
+    static void prvEnforceCurrentTaskBudget( void ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_TASK_BUDGETS == 1 ) */
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/*
+ * Returns pdTRUE if the task pxTCB should run before the task pxOtherTCB when
+ * both have priority configEDF_PRIORITY, otherwise pdFALSE.  A task that is
+ * not an EDF task can only have priority configEDF_PRIORITY by inheriting it,
+ * in which case it runs before the EDF tasks so the mutex it holds is released
+ * as soon as possible.
+ */
+    static BaseType_t prvEDFDeadlineIsEarlier( const TCB_t * const pxTCB,
+                                               const TCB_t * const pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert the task pxTCB into the configEDF_PRIORITY ready list after all the
+ * tasks that should run before it.  Tasks that have the same deadline are held
+ * in the order in which they became ready.
+ */
+    static void prvAddTaskToEDFReadyList( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configUSE_EDF_SCHEDULING == 1 ) */
+
 /*
  * Create a task with static buffer for both TCB and stack. Returns a handle to
  * the task if it is created successfully. Otherwise, returns NULL.
@@ -1007,11 +1510,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
          *
          * To fix these problems, the running task should be put to the end of the
          * ready list before searching for the ready task in the ready list. */
-        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+        if( listIS_CONTAINED_WITHIN( taskREADY_LIST_FOR_TASK( pxCurrentTCBs[ xCoreID ], pxCurrentTCBs[ xCoreID ]->uxPriority ),
                                      &pxCurrentTCBs[ xCoreID ]->xStateListItem ) == pdTRUE )
         {
             ( void ) uxListRemove( &pxCurrentTCBs[ xCoreID ]->xStateListItem );
-            vListInsertEnd( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+            vListInsertEnd( taskREADY_LIST_FOR_TASK( pxCurrentTCBs[ xCoreID ], pxCurrentTCBs[ xCoreID ]->uxPriority ),
                             &pxCurrentTCBs[ xCoreID ]->xStateListItem );
         }
 
@@ -1029,6 +1532,63 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif
 
+            #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+            {
+                BaseType_t xListsEmpty;
+
+                pxTCB = prvSearchCoreReadyLists( xCoreID, uxCurrentPriority, &xListsEmpty );
+
+                if( xListsEmpty == pdFALSE )
+                {
+                    /* There are ready tasks at uxCurrentPriority, so uxTopReadyPriority
+                     * must not be decremented any further. */
+                    xDecrementTopPriority = pdFALSE;
+                }
+                else if( xDecrementTopPriority != pdFALSE )
+                {
+                    uxTopReadyPriority--;
+                    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                    {
+                        xPriorityDropped = pdTRUE;
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                {
+                    configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+
+                    /* The task is already running on this core, mark it as scheduled. */
+                    pxTCB->xTaskRunState = xCoreID;
+                    xTaskScheduled = pdTRUE;
+                }
+                else if( pxTCB != NULL )
+                {
+                    /* The task is not being executed by any core, swap it in. */
+                    pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+                    #if ( configUSE_CORE_AFFINITY == 1 )
+                        pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                    #endif
+                    pxTCB->xTaskRunState = xCoreID;
+                    pxCurrentTCBs[ xCoreID ] = pxTCB;
+                    xTaskScheduled = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskScheduled != pdFALSE )
+                {
+                    /* A task has been selected to run on this core. */
+                    break;
+                }
+            }
+            #else /* #if ( configUSE_PER_CORE_READY_LISTS == 1 ) */
             if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
             {
                 const List_t * const pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
@@ -1115,6 +1675,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                     #endif
                 }
             }
+            #endif /* #if ( configUSE_PER_CORE_READY_LISTS == 1 ) */
 
             /* There are configNUMBER_OF_CORES Idle tasks created when scheduler started.
              * The scheduler should be able to select a task to run when uxCurrentPriority
@@ -1159,7 +1720,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         {
             if( xTaskScheduled == pdTRUE )
             {
-                if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+                if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( taskREADY_LIST_FOR_TASK( pxPreviousTCB, pxPreviousTCB->uxPriority ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
                 {
                     /* A ready task was just evicted from this core. See if it can be
                      * scheduled on any other core. */
@@ -1246,65 +1807,198 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 
 #endif /* ( configNUMBER_OF_CORES > 1 ) */
-
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
 
-    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
-                                        const char * const pcName,
-                                        const configSTACK_DEPTH_TYPE uxStackDepth,
-                                        void * const pvParameters,
-                                        UBaseType_t uxPriority,
-                                        StackType_t * const puxStackBuffer,
-                                        StaticTask_t * const pxTaskBuffer,
-                                        TaskHandle_t * const pxCreatedTask )
+    static TCB_t * prvSearchCoreReadyLists( BaseType_t xCoreID,
+                                            UBaseType_t uxPriority,
+                                            BaseType_t * pxListsEmpty )
     {
-        TCB_t * pxNewTCB;
-
-        configASSERT( puxStackBuffer != NULL );
-        configASSERT( pxTaskBuffer != NULL );
+        TCB_t * pxTCB;
+        TCB_t * pxSelectedTCB = NULL;
+        BaseType_t xOffset;
+        BaseType_t xListCoreID;
 
-        #if ( configASSERT_DEFINED == 1 )
-        {
-            /* Sanity check that the size of the structure used to declare a
-             * variable of type StaticTask_t equals the size of the real task
-             * structure. */
-            volatile size_t xSize = sizeof( StaticTask_t );
-            configASSERT( xSize == sizeof( TCB_t ) );
-            ( void ) xSize; /* Prevent unused variable warning when configASSERT() is not used. */
-        }
-        #endif /* configASSERT_DEFINED */
+        *pxListsEmpty = pdTRUE;
 
-        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+        /* Search this core's own ready list first, then the ready lists of the
+         * other cores in turn starting with the next core, so the cores do not
+         * all take work from the same sibling. */
+        for( xOffset = ( BaseType_t ) 0; ( xOffset < ( BaseType_t ) configNUMBER_OF_CORES ) && ( pxSelectedTCB == NULL ); xOffset++ )
         {
-            /* The memory used for the task's TCB and stack are passed into this
-             * function - use them. */
-            /* MISRA Ref 11.3.1 [Misaligned access] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
-            /* coverity[misra_c_2012_rule_11_3_violation] */
-            pxNewTCB = ( TCB_t * ) pxTaskBuffer;
-            ( void ) memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+            xListCoreID = ( BaseType_t ) ( ( xCoreID + xOffset ) % ( BaseType_t ) configNUMBER_OF_CORES );
 
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            if( uxPriority <= uxCoreTopReadyPriority[ xListCoreID ] )
             {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created statically in case the task is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
-            }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+                const List_t * const pxReadyList = &( pxCoreReadyTasksLists[ xListCoreID ][ uxPriority ] );
+                const ListItem_t * pxEndMarker = listGET_END_MARKER( pxReadyList );
+                ListItem_t * pxIterator;
 
-            prvInitialiseNewTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
-        }
-        else
-        {
-            pxNewTCB = NULL;
-        }
+                if( listLIST_IS_EMPTY( pxReadyList ) == pdFALSE )
+                {
+                    *pxListsEmpty = pdFALSE;
 
-        return pxNewTCB;
-    }
-/*-----------------------------------------------------------*/
+                    for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                    {
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+                        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                        {
+                            /* Only the idle tasks can be scheduled when falling back to
+                             * the idle priority. */
+                            if( ( uxPriority < uxTopReadyPriority ) && ( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U ) )
+                            {
+                                continue;
+                            }
+                        }
+                        #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
+
+                        if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                        {
+                            #if ( configUSE_CORE_AFFINITY == 1 )
+                                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                            #endif
+                            {
+                                pxSelectedTCB = pxTCB;
+                                break;
+                            }
+                        }
+                    }
+
+                    if( ( pxSelectedTCB != NULL ) && ( xListCoreID != xCoreID ) )
+                    {
+                        /* Take the task from the other core. */
+                        prvMoveTaskToCoreReadyList( pxSelectedTCB, xCoreID );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( ( uxPriority == uxCoreTopReadyPriority[ xListCoreID ] ) && ( uxPriority > tskIDLE_PRIORITY ) )
+                {
+                    /* There are no ready tasks at or above uxPriority in this
+                     * core's ready lists. */
+                    uxCoreTopReadyPriority[ xListCoreID ]--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        if( pxSelectedTCB == NULL )
+        {
+            /* No other task can run, so keep the task that is already running on
+             * this core if it is still eligible. */
+            pxTCB = pxCurrentTCBs[ xCoreID ];
+
+            if( listIS_CONTAINED_WITHIN( &( pxCoreReadyTasksLists[ xCoreID ][ uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+            {
+                #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+                    if( ( uxPriority >= uxTopReadyPriority ) || ( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U ) )
+                #endif
+                {
+                    #if ( configUSE_CORE_AFFINITY == 1 )
+                        if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+                    #endif
+                    {
+                        pxSelectedTCB = pxTCB;
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pxSelectedTCB;
+    }
+
+#endif /* #if ( configUSE_PER_CORE_READY_LISTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PER_CORE_READY_LISTS == 1 )
+
+    static UBaseType_t prvGetReadyTaskCount( UBaseType_t uxPriority )
+    {
+        UBaseType_t uxCount = 0U;
+        BaseType_t xCoreID;
+
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            uxCount += listCURRENT_LIST_LENGTH( &( pxCoreReadyTasksLists[ xCoreID ][ uxPriority ] ) );
+        }
+
+        return uxCount;
+    }
+
+#endif /* #if ( configUSE_PER_CORE_READY_LISTS == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
+                                        const char * const pcName,
+                                        const configSTACK_DEPTH_TYPE uxStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        StackType_t * const puxStackBuffer,
+                                        StaticTask_t * const pxTaskBuffer,
+                                        TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+
+        configASSERT( puxStackBuffer != NULL );
+        configASSERT( pxTaskBuffer != NULL );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticTask_t equals the size of the real task
+             * structure. */
+            volatile size_t xSize = sizeof( StaticTask_t );
+            configASSERT( xSize == sizeof( TCB_t ) );
+            ( void ) xSize; /* Prevent unused variable warning when configASSERT() is not used. */
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+        {
+            /* The memory used for the task's TCB and stack are passed into this
+             * function - use them. */
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewTCB = ( TCB_t * ) pxTaskBuffer;
+            ( void ) memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created statically in case the task is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+        }
+        else
+        {
+            pxNewTCB = NULL;
+        }
+
+        return pxNewTCB;
+    }
+/*-----------------------------------------------------------*/
 
     TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
                                     const char * const pcName,
@@ -1752,6 +2446,50 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        BaseType_t xTaskCreateEDF( TaskFunction_t pxTaskCode,
+                                   const char * const pcName,
+                                   const configSTACK_DEPTH_TYPE uxStackDepth,
+                                   void * const pvParameters,
+                                   const TickType_t xRelativeDeadline,
+                                   const TickType_t xPeriod,
+                                   TaskHandle_t * const pxCreatedTask )
+        {
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
+
+            traceENTER_xTaskCreateEDF( pxTaskCode, pcName, uxStackDepth, pvParameters, xRelativeDeadline, xPeriod, pxCreatedTask );
+
+            /* A relative deadline of zero is used to mark tasks that are not
+             * EDF tasks. */
+            configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+            configASSERT( xRelativeDeadline <= xPeriod );
+
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, ( UBaseType_t ) configEDF_PRIORITY, pxCreatedTask );
+
+            if( pxNewTCB != NULL )
+            {
+                /* Set the task's deadline before scheduling it.  The first
+                 * period starts when the task is created. */
+                pxNewTCB->xRelativeDeadline = xRelativeDeadline;
+                pxNewTCB->xPeriod = xPeriod;
+                pxNewTCB->xAbsoluteDeadline = xTaskGetTickCount() + xRelativeDeadline;
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+            }
+
+            traceRETURN_xTaskCreateEDF( xReturn );
+
+            return xReturn;
+        }
+    #endif /* #if ( configUSE_EDF_SCHEDULING == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
         BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
                                            const char * const pcName,
@@ -1914,6 +2652,13 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
      * back to  the containing TCB from a generic item in a list. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    {
+        vListInitialiseItem( &( pxNewTCB->xDeadlineListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxNewTCB->xDeadlineListItem ), pxNewTCB );
+    }
+    #endif
+
     /* Event lists are always in priority order. */
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority );
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
@@ -2018,6 +2763,15 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
     static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
+        #if ( configUSE_EDF_SCHEDULING == 1 )
+        {
+            /* Only tasks created with xTaskCreateEDF() can have priority
+             * configEDF_PRIORITY, as any other task at that priority is treated
+             * as having inherited it and always runs before the EDF tasks. */
+            configASSERT( ( pxNewTCB->uxPriority != ( UBaseType_t ) configEDF_PRIORITY ) || ( pxNewTCB->xRelativeDeadline != ( TickType_t ) 0U ) );
+        }
+        #endif
+
         /* Ensure interrupts don't access the task lists while the lists are being
          * updated. */
         taskENTER_CRITICAL();
@@ -2049,7 +2803,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * so far. */
                 if( xSchedulerRunning == pdFALSE )
                 {
-                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    if( taskNEW_TASK_RUNS_BEFORE_CURRENT_TASK( pxNewTCB ) )
                     {
                         pxCurrentTCB = pxNewTCB;
                     }
@@ -2131,6 +2885,14 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             #endif /* configUSE_TRACE_FACILITY */
             traceTASK_CREATE( pxNewTCB );
 
+            #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+            {
+                /* Spread new tasks across the cores' ready lists.  The task is
+                 * moved to another core's ready list if that core runs it. */
+                pxNewTCB->xReadyListCoreID = ( BaseType_t ) ( uxTaskNumber % ( UBaseType_t ) configNUMBER_OF_CORES );
+            }
+            #endif
+
             prvAddTaskToReadyList( pxNewTCB );
 
             portSETUP_TCB( pxNewTCB );
@@ -2153,6 +2915,154 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static BaseType_t prvEDFDeadlineIsEarlier( const TCB_t * const pxTCB,
+                                               const TCB_t * const pxOtherTCB )
+    {
+        BaseType_t xReturn;
+
+        if( pxTCB->xRelativeDeadline == ( TickType_t ) 0U )
+        {
+            /* pxTCB is not an EDF task so has inherited its priority.  It
+             * runs before any EDF task, but after any other task that has
+             * also inherited its priority. */
+            if( pxOtherTCB->xRelativeDeadline != ( TickType_t ) 0U )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        else if( pxOtherTCB->xRelativeDeadline == ( TickType_t ) 0U )
+        {
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            /* The deadlines are compared using the difference between them so
+             * the comparison remains correct when the tick count overflows,
+             * provided the deadlines are less than half the tick range
+             * apart. */
+            if( ( TickType_t ) ( pxTCB->xAbsoluteDeadline - pxOtherTCB->xAbsoluteDeadline ) > ( portMAX_DELAY >> 1 ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddTaskToEDFReadyList( TCB_t * pxTCB )
+    {
+        List_t * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+        ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+        ListItem_t * pxIterator;
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( pxList );
+
+        /* Find the first task that pxTCB should run before.  Tasks that have
+         * the same deadline as pxTCB remain ahead of it. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            if( prvEDFDeadlineIsEarlier( pxTCB, listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        /* Insert the task in front of pxIterator, which is the end marker if
+         * pxTCB has the latest deadline. */
+        pxNewListItem->pxNext = pxIterator;
+        pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+        pxIterator->pxPrevious->pxNext = pxNewListItem;
+        pxIterator->pxPrevious = pxNewListItem;
+
+        pxNewListItem->pxContainer = pxList;
+
+        pxList->uxNumberOfItems = ( UBaseType_t ) ( pxList->uxNumberOfItems + 1U );
+    }
+
+#endif /* #if ( configUSE_EDF_SCHEDULING == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    static BaseType_t prvTaskBudgetExhausted( TCB_t * const pxTCB,
+                                              const configRUN_TIME_COUNTER_TYPE ulUnchargedRunTime )
+    {
+        BaseType_t xReturn = pdFALSE;
+        TickType_t xElapsed;
+
+        if( pxTCB->ulBudget != ( configRUN_TIME_COUNTER_TYPE ) 0U )
+        {
+            /* Has the current budget period ended?  Periods that ended while
+             * the task was not running are skipped so the new period is the
+             * one that contains the current tick count. */
+            xElapsed = taskCURRENT_TICK_COUNT() - pxTCB->xBudgetPeriodStart;
+
+            if( xElapsed >= pxTCB->xBudgetPeriod )
+            {
+                pxTCB->xBudgetPeriodStart += xElapsed - ( xElapsed % pxTCB->xBudgetPeriod );
+                pxTCB->ulBudgetUsed = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( pxTCB->ulBudgetUsed + ulUnchargedRunTime ) >= pxTCB->ulBudget )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEnforceCurrentTaskBudget( void )
+    {
+        /* Only a task that is still Ready is held back - a task that is being
+         * switched out because it blocked, suspended or deleted itself has
+         * already left the ready list. */
+        if( ( prvTaskBudgetExhausted( pxCurrentTCB, ( configRUN_TIME_COUNTER_TYPE ) 0U ) != pdFALSE ) &&
+            ( listIS_CONTAINED_WITHIN( taskREADY_LIST_FOR_TASK( pxCurrentTCB, pxCurrentTCB->uxPriority ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            traceTASK_BUDGET_EXHAUSTED( pxCurrentTCB );
+
+            /* The budget period cannot have ended, as prvTaskBudgetExhausted()
+             * would have started a new one, so the block time is at least one
+             * tick. */
+            prvAddCurrentTaskToDelayedList( ( pxCurrentTCB->xBudgetPeriodStart + pxCurrentTCB->xBudgetPeriod ) - taskCURRENT_TICK_COUNT(), pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* #if ( configUSE_TASK_BUDGETS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
     static size_t prvSnprintfReturnValueToCharsWritten( int iSnprintfReturnValue,
@@ -2203,6 +3113,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
             /* Remove task from the ready/delayed list. */
+            taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
+
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -2222,7 +3134,20 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
+            #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xDeadlineListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxTCB->xDeadlineListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
              * not return. */
@@ -2355,7 +3280,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         {
             /* Minor optimisation.  The tick count cannot change in this
              * block. */
-            const TickType_t xConstTickCount = xTickCount;
+            const TickType_t xConstTickCount = taskCURRENT_TICK_COUNT();
 
             configASSERT( uxSchedulerSuspended == 1U );
 
@@ -2396,6 +3321,35 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             /* Update the wake time ready for the next call. */
             *pxPreviousWakeTime = xTimeToWake;
 
+            #if ( configUSE_EDF_SCHEDULING == 1 )
+            {
+                /* The next period of an EDF task starts at the wake time, so
+                 * its deadline is measured from there. */
+                if( pxCurrentTCB->xRelativeDeadline != ( TickType_t ) 0U )
+                {
+                    pxCurrentTCB->xAbsoluteDeadline = xTimeToWake + pxCurrentTCB->xRelativeDeadline;
+
+                    if( ( xShouldDelay == pdFALSE ) && ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) )
+                    {
+                        /* The task is not going to delay, so move it to the
+                         * position in the ready list its new deadline gives
+                         * it.  The yield below lets an EDF task that now has
+                         * an earlier deadline run. */
+                        ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+                        prvAddTaskToReadyList( pxCurrentTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* #if ( configUSE_EDF_SCHEDULING == 1 ) */
+
             if( xShouldDelay != pdFALSE )
             {
                 traceTASK_DELAY_UNTIL( xTimeToWake );
@@ -2430,6 +3384,55 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+
+    BaseType_t xTaskDelayUntilNextPeriod( TickType_t * const pxPreviousWakeTime )
+    {
+        BaseType_t xShouldDelay;
+
+        traceENTER_xTaskDelayUntilNextPeriod( pxPreviousWakeTime );
+
+        /* Only EDF tasks have a period. */
+        configASSERT( pxCurrentTCB->xPeriod > ( TickType_t ) 0U );
+
+        xShouldDelay = xTaskDelayUntil( pxPreviousWakeTime, pxCurrentTCB->xPeriod );
+
+        traceRETURN_xTaskDelayUntilNextPeriod( xShouldDelay );
+
+        return xShouldDelay;
+    }
+
+#endif /* #if ( ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    TickType_t xTaskGetDeadline( TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        TickType_t xDeadline;
+
+        traceENTER_xTaskGetDeadline( xTask );
+
+        /* If null is passed in here then it is the deadline of the calling
+         * task that is being queried. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxTCB != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            xDeadline = pxTCB->xAbsoluteDeadline;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xTaskGetDeadline( xDeadline );
+
+        return xDeadline;
+    }
+
+#endif /* #if ( configUSE_EDF_SCHEDULING == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
     void vTaskDelay( const TickType_t xTicksToDelay )
@@ -2793,6 +3796,16 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
              * task that is being changed. */
             pxTCB = prvGetTCBFromHandle( xTask );
 
+            #if ( configUSE_EDF_SCHEDULING == 1 )
+            {
+                /* configEDF_PRIORITY is reserved for tasks created with
+                 * xTaskCreateEDF(), and the priority of those tasks must not be
+                 * changed. */
+                configASSERT( uxNewPriority != ( UBaseType_t ) configEDF_PRIORITY );
+                configASSERT( pxTCB->xRelativeDeadline == ( TickType_t ) 0U );
+            }
+            #endif
+
             traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
 
             #if ( configUSE_MUTEXES == 1 )
@@ -2893,7 +3906,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * being used for anything else. */
                 if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) );
+                    taskSET_EVENT_LIST_ITEM_VALUE( pxTCB, ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) );
                 }
                 else
                 {
@@ -2904,7 +3917,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                  * nothing more than change its priority variable. However, if
                  * the task is in a ready list it needs to be removed and placed
                  * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                if( listIS_CONTAINED_WITHIN( taskREADY_LIST_FOR_TASK( pxTCB, uxPriorityUsedOnEntry ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                 {
                     /* The task is currently in its ready list - remove before
                      * adding it to its new ready list.  As we are in a critical
@@ -3134,6 +4147,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
             /* Remove task from the ready/delayed list and place in the
              * suspended list. */
+            taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
+
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -3455,7 +4470,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     {
                         /* Ready lists can be accessed so move the task from the
                          * suspended list to the ready list directly. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             xYieldRequired = pdTRUE;
 
@@ -3652,6 +4667,14 @@ static BaseType_t prvCreateIdleTasks( void )
                 /* Assign idle task to each core before SMP scheduler is running. */
                 xIdleTaskHandles[ xCoreID ]->xTaskRunState = xCoreID;
                 pxCurrentTCBs[ xCoreID ] = xIdleTaskHandles[ xCoreID ];
+
+                #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+                {
+                    /* A running task is always held in the ready list of the core
+                     * it is running on. */
+                    prvMoveTaskToCoreReadyList( xIdleTaskHandles[ xCoreID ], xCoreID );
+                }
+                #endif
             }
             #endif
         }
@@ -3900,7 +4923,18 @@ void vTaskSuspendAll( void )
          * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
          * task that are in the Ready state, even though the idle task is
          * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+        {
+            UBaseType_t uxTopPriority;
+
+            taskGET_TOP_READY_PRIORITY( uxTopPriority );
+
+            if( uxTopPriority > tskIDLE_PRIORITY )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
         {
             if( uxTopReadyPriority > tskIDLE_PRIORITY )
             {
@@ -3921,13 +4955,13 @@ void vTaskSuspendAll( void )
                 uxHigherPriorityReadyTasks = pdTRUE;
             }
         }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+        #endif /* if ( configUSE_READY_PRIORITY_BITMAP == 1 ) */
 
         if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
         {
             xReturn = 0;
         }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1U )
+        else if( taskREADY_TASK_COUNT( tskIDLE_PRIORITY ) > 1U )
         {
             /* There are other idle priority tasks in the ready state.  If
              * time slicing is used then the very next tick interrupt must be
@@ -3953,6 +4987,76 @@ void vTaskSuspendAll( void )
 #endif /* configUSE_TICKLESS_IDLE */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    static TickType_t prvGetTicksToNextEvent( void )
+    {
+        TickType_t xReturn = ( TickType_t ) 1;
+
+        if( uxSchedulerSuspended != ( UBaseType_t ) 0U )
+        {
+            /* Ticks that occur while the scheduler is suspended are held
+             * pending, so keep the tick running until it is resumed. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+            else if( taskREADY_TASK_COUNT( pxCurrentTCB->uxPriority ) > 1U )
+            {
+                /* The running task is sharing processing time with other
+                 * tasks of equal priority. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        #endif
+
+        #if ( configUSE_TASK_BUDGETS == 1 )
+            else if( pxCurrentTCB->ulBudget != ( configRUN_TIME_COUNTER_TYPE ) 0U )
+            {
+                /* The running task's budget is checked on each tick. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        #endif
+        else if( xNextTaskUnblockTime > xTickCount )
+        {
+            /* xNextTaskUnblockTime is portMAX_DELAY when no tasks are in a
+             * delayed list, so the tick count overflow is always processed. */
+            xReturn = xNextTaskUnblockTime - xTickCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    static TickType_t prvGetCurrentTickCount( void )
+    {
+        TickType_t xConstTickCount;
+        TickType_t xConstPendedTicks;
+        TickType_t xUnprocessedTicks;
+
+        /* The tick interrupt passes ticks to the kernel by updating either
+         * xTickCount or xPendedTicks, so if neither changed while the
+         * unprocessed ticks were read then the three values are consistent. */
+        do
+        {
+            xConstTickCount = xTickCount;
+            xConstPendedTicks = xPendedTicks;
+            xUnprocessedTicks = portGET_UNPROCESSED_TICKS();
+        } while( ( xConstTickCount != xTickCount ) || ( xConstPendedTicks != xPendedTicks ) );
+
+        return xConstTickCount + xConstPendedTicks + xUnprocessedTicks;
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*----------------------------------------------------------*/
+
 BaseType_t xTaskResumeAll( void )
 {
     TCB_t * pxTCB = NULL;
@@ -3995,6 +5099,7 @@ BaseType_t xTaskResumeAll( void )
                         pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) );
                         listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
                         portMEMORY_BARRIER();
+                        taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
                         listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                         prvAddTaskToReadyList( pxTCB );
 
@@ -4002,7 +5107,7 @@ BaseType_t xTaskResumeAll( void )
                         {
                             /* If the moved task has a priority higher than the current
                              * task then a yield must be performed. */
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xYieldPendings[ xCoreID ] = pdTRUE;
                             }
@@ -4045,6 +5150,12 @@ BaseType_t xTaskResumeAll( void )
 
                         if( xPendedCounts > ( TickType_t ) 0U )
                         {
+                            #if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+                            {
+                                xProcessingPendedTicks = pdTRUE;
+                            }
+                            #endif
+
                             do
                             {
                                 if( xTaskIncrementTick() != pdFALSE )
@@ -4062,12 +5173,43 @@ BaseType_t xTaskResumeAll( void )
                             } while( xPendedCounts > ( TickType_t ) 0U );
 
                             xPendedTicks = 0;
+
+                            #if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+                            {
+                                xProcessingPendedTicks = pdFALSE;
+                            }
+                            #endif
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+                    {
+                        /* The high resolution timer interrupted while the
+                         * scheduler was suspended, so the deadlines could not
+                         * be checked then. */
+                        if( xDeadlineCheckPending != pdFALSE )
+                        {
+                            xDeadlineCheckPending = pdFALSE;
+
+                            if( prvCheckForExpiredDeadlines() != pdFALSE )
+                            {
+                                xYieldPendings[ xCoreID ] = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
+                    #endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
 
                     if( xYieldPendings[ xCoreID ] != pdFALSE )
                     {
@@ -4112,7 +5254,7 @@ TickType_t xTaskGetTickCount( void )
     /* Critical section required if running on a 16 bit processor. */
     portTICK_TYPE_ENTER_CRITICAL();
     {
-        xTicks = xTickCount;
+        xTicks = taskCURRENT_TICK_COUNT();
     }
     portTICK_TYPE_EXIT_CRITICAL();
 
@@ -4147,7 +5289,7 @@ TickType_t xTaskGetTickCountFromISR( void )
 
     uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
     {
-        xReturn = xTickCount;
+        xReturn = taskCURRENT_TICK_COUNT();
     }
     portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -4276,7 +5418,22 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
             do
             {
                 uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+                #if ( configUSE_PER_CORE_READY_LISTS == 0 )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+                }
+                #else
+                {
+                    BaseType_t xCoreID;
+
+                    pxTCB = NULL;
+
+                    for( xCoreID = ( BaseType_t ) 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( pxTCB == NULL ); xCoreID++ )
+                    {
+                        pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxCoreReadyTasksLists[ xCoreID ][ uxQueue ] ), pcNameToQuery );
+                    }
+                }
+                #endif /* #if ( configUSE_PER_CORE_READY_LISTS == 0 ) */
 
                 if( pxTCB != NULL )
                 {
@@ -4400,7 +5557,20 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                 do
                 {
                     uxQueue--;
-                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady ) );
+                    #if ( configUSE_PER_CORE_READY_LISTS == 0 )
+                    {
+                        uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady ) );
+                    }
+                    #else
+                    {
+                        BaseType_t xCoreID;
+
+                        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                        {
+                            uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxCoreReadyTasksLists[ xCoreID ][ uxQueue ] ), eReady ) );
+                        }
+                    }
+                    #endif /* #if ( configUSE_PER_CORE_READY_LISTS == 0 ) */
                 } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY );
 
                 /* Fill in an TaskStatus_t structure with information on each
@@ -4571,6 +5741,76 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 }
 /*----------------------------------------------------------*/
 
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    BaseType_t xTaskCatchUpTicksFromISR( TickType_t xTicksToCatchUp )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+        TickType_t xTicksToJump;
+
+        traceENTER_xTaskCatchUpTicksFromISR( xTicksToCatchUp );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+        {
+            /* No task leaves the Blocked state before xNextTaskUnblockTime, so
+             * the tick count can be moved straight to the tick before it
+             * instead of processing each tick in turn.  xNextTaskUnblockTime
+             * is never more than portMAX_DELAY, so this never jumps over a
+             * tick count overflow, which xTaskIncrementTick() must process.
+             * Note the tick hook is not called for the ticks jumped over. */
+            if( ( xTicksToCatchUp > ( TickType_t ) 1 ) && ( xNextTaskUnblockTime > xTickCount ) )
+            {
+                xTicksToJump = ( xNextTaskUnblockTime - xTickCount ) - ( TickType_t ) 1;
+
+                if( xTicksToJump > ( xTicksToCatchUp - ( TickType_t ) 1 ) )
+                {
+                    xTicksToJump = xTicksToCatchUp - ( TickType_t ) 1;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xTickCount += xTicksToJump;
+                traceINCREASE_TICK_COUNT( xTicksToJump );
+                xTicksToCatchUp -= xTicksToJump;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            while( xTicksToCatchUp > ( TickType_t ) 0 )
+            {
+                if( xTaskIncrementTick() != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xTicksToCatchUp--;
+            }
+        }
+        else
+        {
+            /* The ticks are processed when the scheduler is resumed. */
+            xPendedTicks += xTicksToCatchUp;
+        }
+
+        /* The tick count has moved, so program the next tick interrupt. */
+        portSET_NEXT_TICK_INTERRUPT( prvGetTicksToNextEvent() );
+
+        traceRETURN_xTaskCatchUpTicksFromISR( xSwitchRequired );
+
+        return xSwitchRequired;
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskAbortDelay == 1 )
 
     BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
@@ -4593,6 +5833,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 /* Remove the reference to the task from the blocked list.  An
                  * interrupt won't touch the xStateListItem because the
                  * scheduler is suspended. */
+                taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
                 ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 
                 /* Is the task waiting on an event also?  If so remove it from
@@ -4629,7 +5870,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                         /* Preemption is on, but a context switch should only be
                          * performed if the unblocked task has a priority that is
                          * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )
                         {
                             /* Pend the yield to be performed when the scheduler
                              * is unsuspended. */
@@ -4667,61 +5908,223 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 #endif /* INCLUDE_xTaskAbortDelay */
 /*----------------------------------------------------------*/
 
-BaseType_t xTaskIncrementTick( void )
-{
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
-    BaseType_t xSwitchRequired = pdFALSE;
-
-    #if ( configUSE_PREEMPTION == 1 ) && ( configNUMBER_OF_CORES > 1 )
-    BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
-    #endif /* #if ( configUSE_PREEMPTION == 1 ) && ( configNUMBER_OF_CORES > 1 ) */
-
-    traceENTER_xTaskIncrementTick();
-
-    /* Called by the portable layer each time a tick interrupt occurs.
-     * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
-    traceTASK_INCREMENT_TICK( xTickCount );
+#if ( configUSE_BATCHED_TICK_WAKE_UP == 1 )
 
-    /* Tick increment should occur on every kernel timer event. Core 0 has the
-     * responsibility to increment the tick, or increment the pended ticks if the
-     * scheduler is suspended.  If pended ticks is greater than zero, the core that
-     * calls xTaskResumeAll has the responsibility to increment the tick. */
-    if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+    static BaseType_t prvUnblockExpiredDelayedTasks( const TickType_t xConstTickCount )
     {
-        /* Minor optimisation.  The tick count cannot change in this
-         * block. */
-        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+        TCB_t * pxTCB;
+        ListItem_t * pxFirstExpired;
+        ListItem_t * pxListItem;
+        ListItem_t * pxNextListItem;
+        UBaseType_t uxExpired = ( UBaseType_t ) 0U;
+        BaseType_t xSwitchRequired = pdFALSE;
 
-        /* Increment the RTOS tick, switching the delayed and overflowed
-         * delayed lists if it wraps to 0. */
-        xTickCount = xConstTickCount;
+        /* The delayed task list is sorted in wake time order, so the tasks to
+         * unblock are the run of items at its head.  Find the end of that run,
+         * which is either the first task that is still to wait or the list end
+         * marker, whose item value is portMAX_DELAY. */
+        pxFirstExpired = listGET_HEAD_ENTRY( pxDelayedTaskList );
+        pxListItem = pxFirstExpired;
 
-        if( xConstTickCount == ( TickType_t ) 0U )
-        {
-            taskSWITCH_DELAYED_LISTS();
-        }
-        else
+        while( ( pxListItem != listGET_END_MARKER( pxDelayedTaskList ) ) &&
+               ( listGET_LIST_ITEM_VALUE( pxListItem ) <= xConstTickCount ) )
         {
-            mtCOVERAGE_TEST_MARKER();
+            uxExpired++;
+            pxListItem = listGET_NEXT( pxListItem );
         }
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+        /* Remove the whole run from the delayed task list at once.  If the
+         * list is now empty then set xNextTaskUnblockTime to the maximum
+         * possible value so it is extremely unlikely that the
+         * if( xTickCount >= xNextTaskUnblockTime ) test will pass next time
+         * through. */
+        listREMOVE_HEAD_ITEMS( pxDelayedTaskList, pxListItem, uxExpired );
+        xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( pxListItem );
+
+        /* Place each unblocked task into the appropriate ready list.  The next
+         * item must be read first as inserting an item into a ready list
+         * overwrites its link to the next item in the run. */
+        pxListItem = pxFirstExpired;
+
+        while( uxExpired > ( UBaseType_t ) 0U )
         {
-            for( ; ; )
+            uxExpired--;
+            pxNextListItem = listGET_NEXT( pxListItem );
+
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_LIST_ITEM_OWNER( pxListItem );
+
+            /* Is the task waiting on an event also?  If so remove it from the
+             * event list. */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvAddTaskToReadyList( pxTCB );
+
+            /* A task being unblocked cannot cause an immediate context switch
+             * if preemption is turned off. */
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
+                    /* Once one unblocked task preempts the current task there
+                     * is no need to check the rest.  The case of equal
+                     * priority tasks sharing processing time is handled by
+                     * the caller. */
+                    if( ( xSwitchRequired == pdFALSE ) && ( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) ) )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                {
+                    prvYieldForTask( pxTCB );
+                }
+                #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+            }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+
+            pxListItem = pxNextListItem;
+        }
+
+        return xSwitchRequired;
+    }
+
+#endif /* #if ( configUSE_BATCHED_TICK_WAKE_UP == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+
+    static void prvProcessDeferredTicks( void )
+    {
+        TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+        /* A context switch is about to occur anyway, so whether processing
+         * the ticks requires one is not relevant.  xPendedTicks is not cleared
+         * until all the ticks have been processed so the tick hook, which was
+         * called when each tick occurred, is not called again. */
+        if( xPendedCounts > ( TickType_t ) 0U )
+        {
+            xProcessingPendedTicks = pdTRUE;
+
+            do
+            {
+                ( void ) xTaskIncrementTick();
+                --xPendedCounts;
+            } while( xPendedCounts > ( TickType_t ) 0U );
+
+            xPendedTicks = 0;
+            xProcessingPendedTicks = pdFALSE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* #if ( configUSE_DEFERRED_TICK_PROCESSING == 1 ) */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+    #if ( configUSE_BATCHED_TICK_WAKE_UP == 0 )
+        TCB_t * pxTCB;
+        TickType_t xItemValue;
+    #endif
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    #if ( configUSE_PREEMPTION == 1 ) && ( configNUMBER_OF_CORES > 1 )
+    BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #endif /* #if ( configUSE_PREEMPTION == 1 ) && ( configNUMBER_OF_CORES > 1 ) */
+
+    traceENTER_xTaskIncrementTick();
+
+    /* Called by the portable layer each time a tick interrupt occurs.
+     * Increments the tick then checks to see if the new tick value will cause any
+     * tasks to be unblocked. */
+    traceTASK_INCREMENT_TICK( xTickCount );
+
+    /* Tick increment should occur on every kernel timer event. Core 0 has the
+     * responsibility to increment the tick, or increment the pended ticks if the
+     * scheduler is suspended.  If pended ticks is greater than zero, the core that
+     * calls xTaskResumeAll has the responsibility to increment the tick. */
+    #if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+        if( ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) &&
+            ( xProcessingPendedTicks == pdFALSE ) &&
+            ( ( xPendedTicks != ( TickType_t ) 0U ) ||
+              ( ( xTickCount + ( TickType_t ) 1 ) >= xNextTaskUnblockTime ) ||
+              ( ( xTickCount + ( TickType_t ) 1 ) == ( TickType_t ) 0U ) ) )
+        {
+            /* This tick unblocks tasks, or switches the delayed lists, so only
+             * count it and request a context switch.  vTaskSwitchContext()
+             * then processes the tick before selecting the task to run, which
+             * keeps the time spent in the tick interrupt constant however many
+             * tasks the tick unblocks. */
+            xPendedTicks += 1U;
+            xSwitchRequired = pdTRUE;
+
+            #if ( configUSE_TICK_HOOK == 1 )
+            {
+                vApplicationTickHook();
+            }
+            #endif
+        }
+        else
+    #endif /* #if ( configUSE_DEFERRED_TICK_PROCESSING == 1 ) */
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+        /* Increment the RTOS tick, switching the delayed and overflowed
+         * delayed lists if it wraps to 0. */
+        xTickCount = xConstTickCount;
+
+        if( xConstTickCount == ( TickType_t ) 0U )
+        {
+            taskSWITCH_DELAYED_LISTS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_BATCHED_TICK_WAKE_UP == 1 )
+            if( xConstTickCount >= xNextTaskUnblockTime )
+            {
+                xSwitchRequired = prvUnblockExpiredDelayedTasks( xConstTickCount );
+            }
+        #else /* #if ( configUSE_BATCHED_TICK_WAKE_UP == 1 ) */
+
+        /* See if this tick has made a timeout expire.  Tasks are stored in
+         * the  queue in the order of their wake time - meaning once one task
+         * has been found whose block time has not expired there is no need to
+         * look any further down the list. */
+        if( xConstTickCount >= xNextTaskUnblockTime )
+        {
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                {
+                    /* The delayed list is empty.  Set xNextTaskUnblockTime
+                     * to the maximum possible value so it is extremely
+                     * unlikely that the
+                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                     * next time through. */
                     xNextTaskUnblockTime = portMAX_DELAY;
                     break;
                 }
@@ -4734,7 +6137,7 @@ BaseType_t xTaskIncrementTick( void )
                     /* MISRA Ref 11.5.3 [Void pointer assignment] */
                     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
                     /* coverity[misra_c_2012_rule_11_5_violation] */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+                    pxTCB = taskGET_FIRST_DELAYED_TASK();
                     xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
 
                     if( xConstTickCount < xItemValue )
@@ -4753,6 +6156,7 @@ BaseType_t xTaskIncrementTick( void )
                     }
 
                     /* It is time to remove the item from the Blocked state. */
+                    taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
                     /* Is the task waiting on an event also?  If so remove
@@ -4784,7 +6188,7 @@ BaseType_t xTaskIncrementTick( void )
                              * processing time (which happens when both
                              * preemption and time slicing are on) is
                              * handled below.*/
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )
                             {
                                 xSwitchRequired = pdTRUE;
                             }
@@ -4803,6 +6207,7 @@ BaseType_t xTaskIncrementTick( void )
                 }
             }
         }
+        #endif /* #if ( configUSE_BATCHED_TICK_WAKE_UP == 1 ) */
 
         /* Tasks of equal priority to the currently running task will share
          * processing time (time slice) if preemption is on, and the application
@@ -4811,7 +6216,15 @@ BaseType_t xTaskIncrementTick( void )
         {
             #if ( configNUMBER_OF_CORES == 1 )
             {
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
+                #if ( configUSE_EDF_SCHEDULING == 1 )
+
+                    /* EDF tasks are not time sliced.  The EDF task with the
+                     * earliest deadline runs until it blocks or is preempted. */
+                    if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U ) &&
+                        ( pxCurrentTCB->uxPriority != ( UBaseType_t ) configEDF_PRIORITY ) )
+                #else
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
+                #endif
                 {
                     xSwitchRequired = pdTRUE;
                 }
@@ -4826,7 +6239,7 @@ BaseType_t xTaskIncrementTick( void )
 
                 for( xCoreID = 0; xCoreID < ( ( BaseType_t ) configNUMBER_OF_CORES ); xCoreID++ )
                 {
-                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > 1U )
+                    if( taskREADY_TASK_COUNT( pxCurrentTCBs[ xCoreID ]->uxPriority ) > 1U )
                     {
                         xYieldRequiredForCore[ xCoreID ] = pdTRUE;
                     }
@@ -4840,6 +6253,52 @@ BaseType_t xTaskIncrementTick( void )
         }
         #endif /* #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
+        /* Switch away from a running task that has used its budget for the
+         * current period.  vTaskSwitchContext() then holds the task in the
+         * Blocked state until its next budget period starts. */
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_BUDGETS == 1 ) )
+        {
+            configRUN_TIME_COUNTER_TYPE ulRunTimeNow;
+
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulRunTimeNow );
+            #else
+                ulRunTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                if( ( ulRunTimeNow > ulTaskSwitchedInTime[ 0 ] ) &&
+                    ( prvTaskBudgetExhausted( pxCurrentTCB, ulRunTimeNow - ulTaskSwitchedInTime[ 0 ] ) != pdFALSE ) )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+            {
+                BaseType_t xCoreID;
+
+                for( xCoreID = 0; xCoreID < ( ( BaseType_t ) configNUMBER_OF_CORES ); xCoreID++ )
+                {
+                    if( ( ulRunTimeNow > ulTaskSwitchedInTime[ xCoreID ] ) &&
+                        ( prvTaskBudgetExhausted( pxCurrentTCBs[ xCoreID ], ulRunTimeNow - ulTaskSwitchedInTime[ xCoreID ] ) != pdFALSE ) )
+                    {
+                        xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+        }
+        #endif /* #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TASK_BUDGETS == 1 ) ) */
+
         #if ( configUSE_TICK_HOOK == 1 )
         {
             /* Guard against the tick hook being called when the pended tick
@@ -5066,6 +6525,15 @@ BaseType_t xTaskIncrementTick( void )
         else
         {
             xYieldPendings[ 0 ] = pdFALSE;
+
+            /* Unblock the tasks the deferred ticks unblock before the task
+             * to run is selected. */
+            #if ( configUSE_DEFERRED_TICK_PROCESSING == 1 )
+            {
+                prvProcessDeferredTicks();
+            }
+            #endif
+
             traceTASK_SWITCHED_OUT();
 
             #if ( configGENERATE_RUN_TIME_STATS == 1 )
@@ -5086,6 +6554,15 @@ BaseType_t xTaskIncrementTick( void )
                 if( ulTotalRunTime[ 0 ] > ulTaskSwitchedInTime[ 0 ] )
                 {
                     pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime[ 0 ] - ulTaskSwitchedInTime[ 0 ] );
+
+                    #if ( configUSE_TASK_BUDGETS == 1 )
+                    {
+                        /* Start a new budget period first if the current one has
+                         * ended so the run time is charged to the correct period. */
+                        ( void ) prvTaskBudgetExhausted( pxCurrentTCB, ( configRUN_TIME_COUNTER_TYPE ) 0U );
+                        pxCurrentTCB->ulBudgetUsed += ( ulTotalRunTime[ 0 ] - ulTaskSwitchedInTime[ 0 ] );
+                    }
+                    #endif
                 }
                 else
                 {
@@ -5106,6 +6583,12 @@ BaseType_t xTaskIncrementTick( void )
             }
             #endif
 
+            #if ( configUSE_TASK_BUDGETS == 1 )
+            {
+                prvEnforceCurrentTaskBudget();
+            }
+            #endif
+
             /* Select a new task to run using either the generic C or port
              * optimised asm code. */
             /* MISRA Ref 11.5.3 [Void pointer assignment] */
@@ -5133,6 +6616,15 @@ BaseType_t xTaskIncrementTick( void )
                 configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
             }
             #endif
+
+            #if ( configUSE_DYNAMIC_TICK == 1 )
+            {
+                /* The task that is running, and therefore whether it is time
+                 * sliced, may have changed, so program the next tick
+                 * interrupt. */
+                portSET_NEXT_TICK_INTERRUPT( prvGetTicksToNextEvent() );
+            }
+            #endif
         }
 
         traceRETURN_vTaskSwitchContext();
@@ -5187,6 +6679,15 @@ BaseType_t xTaskIncrementTick( void )
                     if( ulTotalRunTime[ xCoreID ] > ulTaskSwitchedInTime[ xCoreID ] )
                     {
                         pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ] );
+
+                        #if ( configUSE_TASK_BUDGETS == 1 )
+                        {
+                            /* Start a new budget period first if the current one has
+                             * ended so the run time is charged to the correct period. */
+                            ( void ) prvTaskBudgetExhausted( pxCurrentTCBs[ xCoreID ], ( configRUN_TIME_COUNTER_TYPE ) 0U );
+                            pxCurrentTCBs[ xCoreID ]->ulBudgetUsed += ( ulTotalRunTime[ xCoreID ] - ulTaskSwitchedInTime[ xCoreID ] );
+                        }
+                        #endif
                     }
                     else
                     {
@@ -5207,6 +6708,12 @@ BaseType_t xTaskIncrementTick( void )
                 }
                 #endif
 
+                #if ( configUSE_TASK_BUDGETS == 1 )
+                {
+                    prvEnforceCurrentTaskBudget();
+                }
+                #endif
+
                 /* Select a new task to run. */
                 taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
                 traceTASK_SWITCHED_IN();
@@ -5318,8 +6825,25 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
         /* Place the event list item of the TCB in the appropriate event list.
          * In this case it is assume that this is the only task that is going to
          * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+         * can be used in place of vListInsert - unless the list has a priority
+         * index, in which case vListInsert() is just as fast and keeps the index
+         * valid. */
+        #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        {
+            if( pxEventList->pxPriorityIndex != NULL )
+            {
+                vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+            }
+            else
+            {
+                listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+            }
+        }
+        #else
+        {
+            listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        }
+        #endif
 
         /* If the task should block indefinitely then set the block time to a
          * value that will be recognised as an indefinite delay inside the
@@ -5343,11 +6867,35 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     TCB_t * pxUnblockedTCB;
     BaseType_t xReturn;
 
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        UBaseType_t uxSavedInterruptStatus;
+    #endif
+
     traceENTER_xTaskRemoveFromEventList( pxEventList );
 
     /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
      * called from a critical section within an ISR. */
 
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        /* The caller might only hold the spinlock of the object that owns the
+         * event list, so take the ISR lock before accessing the task lists.
+         * The tick interrupt on another core can remove a task that timed out
+         * from the event list after the caller found it was not empty, so
+         * check again now the list cannot change. */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+
+        if( listLIST_IS_EMPTY( pxEventList ) != pdFALSE )
+        {
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            traceRETURN_xTaskRemoveFromEventList( pdFALSE );
+
+            return pdFALSE;
+        }
+    }
+    #endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+
     /* The event list is sorted in priority order, so the first in the list can
      * be removed as it is known to be the highest priority.  Remove the TCB from
      * the delayed list, and add it to the ready list.
@@ -5367,6 +6915,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 
     if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
     {
+        taskREMOVE_DELAYED_TASK_FROM_HEAP( pxUnblockedTCB );
         listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
         prvAddTaskToReadyList( pxUnblockedTCB );
 
@@ -5393,7 +6942,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskTASK_PREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* Return true if the task removed from the event list has a higher
              * priority than the calling task.  This allows the calling task to know if
@@ -5426,6 +6975,12 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     }
     #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif
+
     traceRETURN_xTaskRemoveFromEventList( xReturn );
     return xReturn;
 }
@@ -5471,12 +7026,13 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     /* Remove the task from the delayed list and add it to the ready list.  The
      * scheduler is suspended so interrupts will not be accessing the ready
      * lists. */
+    taskREMOVE_DELAYED_TASK_FROM_HEAP( pxUnblockedTCB );
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskTASK_PREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
         {
             /* The unblocked task has a priority above that of the calling task, so
              * a context switch is required.  This function is called with the
@@ -5507,97 +7063,446 @@ void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
     traceENTER_vTaskSetTimeOutState( pxTimeOut );
 
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
-    {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
-    }
-    taskEXIT_CRITICAL();
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xTimeOnEntering = taskCURRENT_TICK_COUNT();
+        pxTimeOut->xOverflowCount = taskOVERFLOW_COUNT_AT( pxTimeOut->xTimeOnEntering );
+    }
+    taskEXIT_CRITICAL();
+
+    traceRETURN_vTaskSetTimeOutState();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    traceENTER_vTaskInternalSetTimeOutState( pxTimeOut );
+
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xTimeOnEntering = taskCURRENT_TICK_COUNT();
+    pxTimeOut->xOverflowCount = taskOVERFLOW_COUNT_AT( pxTimeOut->xTimeOnEntering );
+
+    traceRETURN_vTaskInternalSetTimeOutState();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
+
+    traceENTER_xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait );
+
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
+
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = taskCURRENT_TICK_COUNT();
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+            {
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = ( uint8_t ) pdFALSE;
+                xReturn = pdTRUE;
+            }
+            else
+        #endif
+
+        #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+            if( pxCurrentTCB->ullDeadlineNs != 0U )
+            {
+                /* The block time was calculated from a high resolution
+                 * deadline, so the deadline rather than the tick count
+                 * determines whether the time out has occurred. */
+                *pxTicksToWait = prvGetTicksToDeadline( pxCurrentTCB->ullDeadlineNs );
+
+                if( *pxTicksToWait == ( TickType_t ) 0 )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    xReturn = pdFALSE;
+                }
+            }
+            else
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
+            }
+            else
+        #endif
+
+        if( ( taskOVERFLOW_COUNT_AT( xConstTickCount ) != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) )
+        {
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
+        }
+        else if( xElapsedTime < *pxTicksToWait )
+        {
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    traceRETURN_xTaskCheckForTimeOut( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    uint64_t ullTaskGetTimeNs( void )
+    {
+        uint64_t ullTimeNs;
+
+        traceENTER_ullTaskGetTimeNs();
+
+        ullTimeNs = portGET_HIGH_RESOLUTION_TIME_NS();
+
+        traceRETURN_ullTaskGetTimeNs( ullTimeNs );
+
+        return ullTimeNs;
+    }
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    static TickType_t prvGetTicksToDeadline( uint64_t ullDeadlineNs )
+    {
+        const uint64_t ullTimeNs = portGET_HIGH_RESOLUTION_TIME_NS();
+        uint64_t ullTicks;
+        TickType_t xReturn;
+
+        if( ullDeadlineNs > ullTimeNs )
+        {
+            /* The tick count is not aligned with the high resolution counter,
+             * so a block time of N ticks can expire after only a little more
+             * than N - 1 tick periods.  Round up, then add one tick so the block
+             * time cannot expire before the deadline.  The task is normally
+             * woken by the high resolution timer before then. */
+            ullTicks = ( ( ullDeadlineNs - ullTimeNs ) + ( taskTICK_PERIOD_NS - 1U ) ) / taskTICK_PERIOD_NS;
+            ullTicks++;
+
+            /* portMAX_DELAY would block indefinitely.  Longer deadlines are
+             * handled by blocking again when the block time expires. */
+            if( ullTicks >= ( uint64_t ) portMAX_DELAY )
+            {
+                xReturn = portMAX_DELAY - ( TickType_t ) 1;
+            }
+            else
+            {
+                xReturn = ( TickType_t ) ullTicks;
+            }
+        }
+        else
+        {
+            xReturn = ( TickType_t ) 0;
+        }
+
+        return xReturn;
+    }
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    TickType_t xTaskInternalSetDeadlineNs( uint64_t ullDeadlineNs )
+    {
+        TickType_t xTicksToWait;
+
+        traceENTER_xTaskInternalSetDeadlineNs( ullDeadlineNs );
+
+        /* The high resolution timer interrupt can read the deadline of a task
+         * that is still referenced from xDeadlineTaskList, so the deadline is
+         * updated within a critical section. */
+        taskENTER_CRITICAL();
+        {
+            xTicksToWait = prvGetTicksToDeadline( ullDeadlineNs );
+
+            if( xTicksToWait > ( TickType_t ) 0 )
+            {
+                pxCurrentTCB->ullDeadlineNs = ullDeadlineNs;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xTaskInternalSetDeadlineNs( xTicksToWait );
+
+        return xTicksToWait;
+    }
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    void vTaskInternalClearDeadlineNs( void )
+    {
+        traceENTER_vTaskInternalClearDeadlineNs();
+
+        taskENTER_CRITICAL();
+        {
+            pxCurrentTCB->ullDeadlineNs = 0U;
+
+            /* The task may have left the Blocked state for a reason other than
+             * its deadline passing. */
+            if( listLIST_ITEM_CONTAINER( &( pxCurrentTCB->xDeadlineListItem ) ) != NULL )
+            {
+                listREMOVE_ITEM( &( pxCurrentTCB->xDeadlineListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskInternalClearDeadlineNs();
+    }
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    BaseType_t xTaskDelayUntilNs( uint64_t ullDeadlineNs )
+    {
+        TickType_t xTicksToDelay;
+        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
+
+        traceENTER_xTaskDelayUntilNs( ullDeadlineNs );
+
+        configASSERT( ullDeadlineNs != 0U );
+
+        xTicksToDelay = xTaskInternalSetDeadlineNs( ullDeadlineNs );
+
+        if( xTicksToDelay > ( TickType_t ) 0 )
+        {
+            xShouldDelay = pdTRUE;
+
+            vTaskSuspendAll();
+            {
+                configASSERT( uxSchedulerSuspended == 1U );
+
+                traceTASK_DELAY();
+
+                /* The high resolution timer normally moves the task out of the
+                 * Blocked state at the deadline, before the block time
+                 * expires. */
+                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+            }
+            xAlreadyYielded = xTaskResumeAll();
+
+            /* Force a reschedule if xTaskResumeAll has not already done so, we
+             * have put ourselves to sleep. */
+            if( xAlreadyYielded == pdFALSE )
+            {
+                taskYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            vTaskInternalClearDeadlineNs();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskDelayUntilNs( xShouldDelay );
+
+        return xShouldDelay;
+    }
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+
+    static BaseType_t prvCheckForExpiredDeadlines( void )
+    {
+        const uint64_t ullTimeNs = portGET_HIGH_RESOLUTION_TIME_NS();
+        const ListItem_t * const pxListEnd = listGET_END_MARKER( &xDeadlineTaskList );
+        ListItem_t * pxListItem;
+        ListItem_t * pxNextListItem;
+        const List_t * pxStateList;
+        TCB_t * pxTCB;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        ullNextDeadlineNs = taskNO_DEADLINE_NS;
+        pxListItem = listGET_HEAD_ENTRY( &xDeadlineTaskList );
+
+        while( pxListItem != pxListEnd )
+        {
+            pxNextListItem = listGET_NEXT( pxListItem );
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_LIST_ITEM_OWNER( pxListItem );
+            pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+
+            if( ( pxStateList != pxDelayedTaskList ) && ( pxStateList != pxOverflowDelayedTaskList ) )
+            {
+                /* The task has already left the Blocked state, so its deadline
+                 * no longer needs to be tracked. */
+                listREMOVE_ITEM( pxListItem );
+            }
+            else if( pxTCB->ullDeadlineNs > ullTimeNs )
+            {
+                if( pxTCB->ullDeadlineNs < ullNextDeadlineNs )
+                {
+                    ullNextDeadlineNs = pxTCB->ullDeadlineNs;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The deadline has passed, so remove the task from the Blocked
+                 * state as if its block time had expired. */
+                listREMOVE_ITEM( pxListItem );
+                taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvAddTaskToReadyList( pxTCB );
+
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
+                    {
+                        prvYieldForTask( pxTCB );
+
+                        if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+
+                #if ( configUSE_TICKLESS_IDLE != 0 )
+                {
+                    /* See the equivalent comment in xTaskRemoveFromEventList(). */
+                    prvResetNextTaskUnblockTime();
+                }
+                #endif
+            }
 
-    traceRETURN_vTaskSetTimeOutState();
-}
-/*-----------------------------------------------------------*/
+            pxListItem = pxNextListItem;
+        }
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    traceENTER_vTaskInternalSetTimeOutState( pxTimeOut );
+        if( ullNextDeadlineNs != taskNO_DEADLINE_NS )
+        {
+            portSET_HIGH_RESOLUTION_TIMER( ullNextDeadlineNs );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
+        return xSwitchRequired;
+    }
 
-    traceRETURN_vTaskInternalSetTimeOutState();
-}
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
-
-    traceENTER_xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait );
-
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
+#if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
 
-    taskENTER_CRITICAL();
+    BaseType_t xTaskCheckDeadlinesFromISR( void )
     {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+        BaseType_t xSwitchRequired = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
 
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+        traceENTER_xTaskCheckDeadlinesFromISR();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
             {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = ( uint8_t ) pdFALSE;
-                xReturn = pdTRUE;
+                xSwitchRequired = prvCheckForExpiredDeadlines();
             }
             else
-        #endif
-
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
             {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
-                xReturn = pdFALSE;
+                /* The delayed lists cannot be accessed while the scheduler is
+                 * suspended, so check the deadlines when the scheduler is
+                 * resumed. */
+                xDeadlineCheckPending = pdTRUE;
             }
-            else
-        #endif
-
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) )
-        {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
-        }
-        else if( xElapsedTime < *pxTicksToWait )
-        {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
-            xReturn = pdFALSE;
-        }
-        else
-        {
-            *pxTicksToWait = ( TickType_t ) 0;
-            xReturn = pdTRUE;
         }
-    }
-    taskEXIT_CRITICAL();
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
-    traceRETURN_xTaskCheckForTimeOut( xReturn );
+        traceRETURN_xTaskCheckDeadlinesFromISR( xSwitchRequired );
 
-    return xReturn;
-}
+        return xSwitchRequired;
+    }
+
+#endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
 /*-----------------------------------------------------------*/
 
 void vTaskMissedYield( void )
@@ -5705,7 +7610,7 @@ void vTaskMissedYield( void )
                  * the ready list at the idle priority contains one more task than the
                  * number of idle tasks, which is equal to the configured numbers of cores
                  * then a task other than the idle task is ready to execute. */
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+                if( taskREADY_TASK_COUNT( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
                 {
                     taskYIELD();
                 }
@@ -5794,7 +7699,7 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
              * the ready list at the idle priority contains one more task than the
              * number of idle tasks, which is equal to the configured numbers of cores
              * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+            if( taskREADY_TASK_COUNT( tskIDLE_PRIORITY ) > ( UBaseType_t ) configNUMBER_OF_CORES )
             {
                 taskYIELD();
             }
@@ -6014,13 +7919,32 @@ static void prvInitialiseTaskLists( void )
 
     for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+        #if ( configUSE_PER_CORE_READY_LISTS == 0 )
+        {
+            vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+        }
+        #else
+        {
+            BaseType_t xCoreID;
+
+            for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                vListInitialise( &( pxCoreReadyTasksLists[ xCoreID ][ uxPriority ] ) );
+            }
+        }
+        #endif /* #if ( configUSE_PER_CORE_READY_LISTS == 0 ) */
     }
 
     vListInitialise( &xDelayedTaskList1 );
     vListInitialise( &xDelayedTaskList2 );
     vListInitialise( &xPendingReadyList );
 
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    {
+        vListInitialise( &xDeadlineTaskList );
+    }
+    #endif
+
     #if ( INCLUDE_vTaskDelete == 1 )
     {
         vListInitialise( &xTasksWaitingTermination );
@@ -6037,6 +7961,13 @@ static void prvInitialiseTaskLists( void )
      * using list2. */
     pxDelayedTaskList = &xDelayedTaskList1;
     pxOverflowDelayedTaskList = &xDelayedTaskList2;
+
+    #if ( configUSE_DELAYED_TASK_HEAP == 1 )
+    {
+        pxDelayedTaskHeap = NULL;
+        pxOverflowDelayedTaskHeap = NULL;
+    }
+    #endif /* #if ( configUSE_DELAYED_TASK_HEAP == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -6469,11 +8400,204 @@ static void prvResetNextTaskUnblockTime( void )
          * the item at the head of the delayed list.  This is the time at
          * which the task at the head of the delayed list should be removed
          * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        #if ( configUSE_DELAYED_TASK_HEAP == 0 )
+        {
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
+        #else
+        {
+            xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( pxDelayedTaskHeap->xStateListItem ) );
+        }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_HEAP == 1 )
+
+    static TCB_t * prvDelayedHeapMeld( TCB_t * pxFirst,
+                                       TCB_t * pxSecond )
+    {
+        TCB_t * pxParent;
+        TCB_t * pxChild;
+
+        if( pxFirst == NULL )
+        {
+            pxParent = pxSecond;
+        }
+        else if( pxSecond == NULL )
+        {
+            pxParent = pxFirst;
+        }
+        else
+        {
+            /* The heap with the earlier wake time at its root becomes the
+             * parent.  The first heap wins ties so tasks that share a wake time
+             * leave the Blocked state in the order in which they entered it
+             * where possible. */
+            if( listGET_LIST_ITEM_VALUE( &( pxSecond->xStateListItem ) ) < listGET_LIST_ITEM_VALUE( &( pxFirst->xStateListItem ) ) )
+            {
+                pxParent = pxSecond;
+                pxChild = pxFirst;
+            }
+            else
+            {
+                pxParent = pxFirst;
+                pxChild = pxSecond;
+            }
+
+            /* Make pxChild the left most child of pxParent. */
+            pxChild->pxHeapPrev = pxParent;
+            pxChild->pxHeapNext = pxParent->pxHeapChild;
+
+            if( pxParent->pxHeapChild != NULL )
+            {
+                pxParent->pxHeapChild->pxHeapPrev = pxChild;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxParent->pxHeapChild = pxChild;
+        }
+
+        return pxParent;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvDelayedHeapMergePairs( TCB_t * pxFirstSibling )
+    {
+        TCB_t * pxPairs = NULL;
+        TCB_t * pxFirst;
+        TCB_t * pxSecond;
+        TCB_t * pxRoot = NULL;
+
+        /* First pass - meld the siblings together in pairs from left to right,
+         * pushing each resultant heap onto the pxPairs stack. */
+        while( pxFirstSibling != NULL )
+        {
+            pxFirst = pxFirstSibling;
+            pxSecond = pxFirst->pxHeapNext;
+
+            if( pxSecond != NULL )
+            {
+                pxFirstSibling = pxSecond->pxHeapNext;
+                pxSecond->pxHeapNext = NULL;
+                pxSecond->pxHeapPrev = NULL;
+            }
+            else
+            {
+                pxFirstSibling = NULL;
+            }
+
+            pxFirst->pxHeapNext = NULL;
+            pxFirst->pxHeapPrev = NULL;
+
+            pxFirst = prvDelayedHeapMeld( pxFirst, pxSecond );
+            pxFirst->pxHeapNext = pxPairs;
+            pxPairs = pxFirst;
+        }
+
+        /* Second pass - meld the pairs together from right to left, which is
+         * the order in which they come off the stack. */
+        while( pxPairs != NULL )
+        {
+            pxFirst = pxPairs;
+            pxPairs = pxFirst->pxHeapNext;
+            pxFirst->pxHeapNext = NULL;
+
+            pxRoot = prvDelayedHeapMeld( pxRoot, pxFirst );
+        }
+
+        return pxRoot;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvDelayedHeapInsert( TCB_t * pxRoot,
+                                         TCB_t * pxTCB )
+    {
+        pxTCB->pxHeapChild = NULL;
+        pxTCB->pxHeapNext = NULL;
+        pxTCB->pxHeapPrev = NULL;
+
+        return prvDelayedHeapMeld( pxRoot, pxTCB );
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvDelayedHeapRemove( TCB_t * pxRoot,
+                                         TCB_t * pxTCB )
+    {
+        TCB_t * pxSubHeap;
+
+        if( pxTCB != pxRoot )
+        {
+            /* Detach the sub-heap rooted at pxTCB from its parent or siblings. */
+            if( pxTCB->pxHeapPrev->pxHeapChild == pxTCB )
+            {
+                pxTCB->pxHeapPrev->pxHeapChild = pxTCB->pxHeapNext;
+            }
+            else
+            {
+                pxTCB->pxHeapPrev->pxHeapNext = pxTCB->pxHeapNext;
+            }
+
+            if( pxTCB->pxHeapNext != NULL )
+            {
+                pxTCB->pxHeapNext->pxHeapPrev = pxTCB->pxHeapPrev;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Combine the children of pxTCB into a single heap. */
+        pxSubHeap = prvDelayedHeapMergePairs( pxTCB->pxHeapChild );
+
+        pxTCB->pxHeapChild = NULL;
+        pxTCB->pxHeapNext = NULL;
+        pxTCB->pxHeapPrev = NULL;
+
+        if( pxTCB == pxRoot )
+        {
+            pxRoot = pxSubHeap;
+        }
+        else
+        {
+            pxRoot = prvDelayedHeapMeld( pxRoot, pxSubHeap );
+        }
+
+        return pxRoot;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveTaskFromDelayedHeap( TCB_t * pxTCB )
+    {
+        const List_t * const pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+
+        if( pxStateList == pxDelayedTaskList )
+        {
+            pxDelayedTaskHeap = prvDelayedHeapRemove( pxDelayedTaskHeap, pxTCB );
+        }
+        else if( pxStateList == pxOverflowDelayedTaskList )
+        {
+            pxOverflowDelayedTaskHeap = prvDelayedHeapRemove( pxOverflowDelayedTaskHeap, pxTCB );
+        }
+        else
+        {
+            /* The task is not in the Blocked state with a timeout. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* #if ( configUSE_DELAYED_TASK_HEAP == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -6598,7 +8722,7 @@ static void prvResetNextTaskUnblockTime( void )
                  * not being used for anything else. */
                 if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority );
+                    taskSET_EVENT_LIST_ITEM_VALUE( pxMutexHolderTCB, ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority );
                 }
                 else
                 {
@@ -6607,7 +8731,7 @@ static void prvResetNextTaskUnblockTime( void )
 
                 /* If the task being modified is in the ready state it will need
                  * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                if( listIS_CONTAINED_WITHIN( taskREADY_LIST_FOR_TASK( pxMutexHolderTCB, pxMutexHolderTCB->uxPriority ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
                 {
                     if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
@@ -6739,20 +8863,80 @@ static void prvResetNextTaskUnblockTime( void )
                     }
                     #endif /* if ( configNUMBER_OF_CORES > 1 ) */
 
-                    /* Return true to indicate that a context switch is required.
-                     * This is only actually required in the corner case whereby
-                     * multiple mutexes were held and the mutexes were given back
-                     * in an order different to that in which they were taken.
-                     * If a context switch did not occur when the first mutex was
-                     * returned, even if a task was waiting on it, then a context
-                     * switch should occur when the last mutex is returned whether
-                     * a task is waiting on it or not. */
-                    xReturn = pdTRUE;
+                    /* Return true to indicate that a context switch is required.
+                     * This is only actually required in the corner case whereby
+                     * multiple mutexes were held and the mutexes were given back
+                     * in an order different to that in which they were taken.
+                     * If a context switch did not occur when the first mutex was
+                     * returned, even if a task was waiting on it, then a context
+                     * switch should occur when the last mutex is returned whether
+                     * a task is waiting on it or not. */
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskPriorityDisinherit( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+
+    void vTaskPriorityRaiseToCeiling( TaskHandle_t const pxMutexHolder,
+                                      UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+
+        traceENTER_vTaskPriorityRaiseToCeiling( pxMutexHolder, uxCeilingPriority );
+
+        /* If the mutex is taken before the scheduler is started the mutex
+         * holder is NULL and there is no priority to raise. */
+        if( pxMutexHolder != NULL )
+        {
+            /* The mutex holder is the task that has just taken the mutex, so it
+             * must be the running state task, and therefore in its ready
+             * list. */
+            configASSERT( pxTCB == pxCurrentTCB );
+
+            if( pxTCB->uxPriority < uxCeilingPriority )
+            {
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                /* The base priority is left unchanged so the task returns to it
+                 * when it gives back the last mutex it holds. */
+                traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+                pxTCB->uxPriority = uxCeilingPriority;
+
+                /* The event list item value cannot be in use for any other
+                 * purpose while this task is running. */
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority );
+                prvAddTaskToReadyList( pxTCB );
+
+                /* Raising the priority of the running task cannot cause a
+                 * context switch, so there is no need to yield. */
             }
             else
             {
@@ -6764,12 +8948,10 @@ static void prvResetNextTaskUnblockTime( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xTaskPriorityDisinherit( xReturn );
-
-        return xReturn;
+        traceRETURN_vTaskPriorityRaiseToCeiling();
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_MUTEXES == 1 )
@@ -6827,7 +9009,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * being used for anything else. */
                     if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
                     {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse );
+                        taskSET_EVENT_LIST_ITEM_VALUE( pxTCB, ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse );
                     }
                     else
                     {
@@ -6840,7 +9022,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * from its current state list if it is in the Ready state as
                      * the task's priority is going to change and there is one
                      * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    if( listIS_CONTAINED_WITHIN( taskREADY_LIST_FOR_TASK( pxTCB, uxPriorityUsedOnEntry ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                     {
                         if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                         {
@@ -6961,9 +9143,16 @@ static void prvResetNextTaskUnblockTime( void )
 
         if( xSchedulerRunning != pdFALSE )
         {
-            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            if( taskKERNEL_CRITICAL_NESTING_COUNT() == 0U )
             {
-                portGET_TASK_LOCK();
+                /* A data group spinlock is always taken after the task lock,
+                 * so only the ISR lock is taken if this critical section is
+                 * nested within a data group critical section. */
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    portGET_TASK_LOCK();
+                }
+
                 portGET_ISR_LOCK();
             }
 
@@ -7013,7 +9202,7 @@ static void prvResetNextTaskUnblockTime( void )
         {
             uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 
-            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            if( taskKERNEL_CRITICAL_NESTING_COUNT() == 0U )
             {
                 portGET_ISR_LOCK();
             }
@@ -7118,6 +9307,16 @@ static void prvResetNextTaskUnblockTime( void )
                         portYIELD();
                     }
                 }
+
+                #if ( configUSE_GRANULAR_LOCKS == 1 )
+                    else if( taskKERNEL_CRITICAL_NESTING_COUNT() == 0U )
+                    {
+                        /* Exiting a critical section that was nested within a
+                         * data group critical section, so only took the ISR
+                         * lock. */
+                        portRELEASE_ISR_LOCK();
+                    }
+                #endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
@@ -7160,6 +9359,13 @@ static void prvResetNextTaskUnblockTime( void )
                     portRELEASE_ISR_LOCK();
                     portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
                 }
+
+                #if ( configUSE_GRANULAR_LOCKS == 1 )
+                    else if( taskKERNEL_CRITICAL_NESTING_COUNT() == 0U )
+                    {
+                        portRELEASE_ISR_LOCK();
+                    }
+                #endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
@@ -7181,6 +9387,181 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    void vTaskDataGroupEnterCritical( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        traceENTER_vTaskDataGroupEnterCritical( pxSpinlock );
+
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* The spinlock is taken without the task lock, so kernel functions
+             * called from within a data group critical section only take the
+             * ISR lock.  The lock order is therefore the task lock (held while
+             * the scheduler is suspended), then data group spinlocks, then the
+             * ISR lock. */
+            portGET_SPINLOCK( pxSpinlock );
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+            uxDataGroupCriticalNesting[ portGET_CORE_ID() ]++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so assert() if it is being called from an interrupt
+             * context. */
+            if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+            {
+                portASSERT_IF_IN_ISR();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskDataGroupEnterCritical();
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    UBaseType_t uxTaskDataGroupEnterCriticalFromISR( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+
+        traceENTER_uxTaskDataGroupEnterCriticalFromISR( pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            portGET_SPINLOCK( pxSpinlock );
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+            uxDataGroupCriticalNesting[ portGET_CORE_ID() ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_uxTaskDataGroupEnterCriticalFromISR( uxSavedInterruptStatus );
+
+        return uxSavedInterruptStatus;
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    void vTaskDataGroupExitCritical( portSPINLOCK_TYPE * pxSpinlock )
+    {
+        traceENTER_vTaskDataGroupExitCritical( pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the data group nesting count is zero then this function does
+             * not match a previous call to vTaskDataGroupEnterCritical(). */
+            configASSERT( uxDataGroupCriticalNesting[ portGET_CORE_ID() ] > 0U );
+
+            /* This function should not be called in ISR. Use
+             * vTaskDataGroupExitCriticalFromISR to exit critical section from
+             * ISR. */
+            portASSERT_IF_IN_ISR();
+
+            if( uxDataGroupCriticalNesting[ portGET_CORE_ID() ] > 0U )
+            {
+                uxDataGroupCriticalNesting[ portGET_CORE_ID() ]--;
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                portRELEASE_SPINLOCK( pxSpinlock );
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    BaseType_t xYieldCurrentTask;
+
+                    /* Get the xYieldPending stats inside the critical section. */
+                    xYieldCurrentTask = xYieldPendings[ portGET_CORE_ID() ];
+
+                    portENABLE_INTERRUPTS();
+
+                    /* A yield requested from within the critical section was
+                     * held pending, so perform it now. */
+                    if( xYieldCurrentTask != pdFALSE )
+                    {
+                        portYIELD();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskDataGroupExitCritical();
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    void vTaskDataGroupExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus,
+                                            portSPINLOCK_TYPE * pxSpinlock )
+    {
+        traceENTER_vTaskDataGroupExitCriticalFromISR( uxSavedInterruptStatus, pxSpinlock );
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the data group nesting count is zero then this function does
+             * not match a previous call to uxTaskDataGroupEnterCriticalFromISR(). */
+            configASSERT( uxDataGroupCriticalNesting[ portGET_CORE_ID() ] > 0U );
+
+            if( uxDataGroupCriticalNesting[ portGET_CORE_ID() ] > 0U )
+            {
+                uxDataGroupCriticalNesting[ portGET_CORE_ID() ]--;
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                portRELEASE_SPINLOCK( pxSpinlock );
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_vTaskDataGroupExitCriticalFromISR();
+    }
+
+#endif /* #if ( configUSE_GRANULAR_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
     static char * prvWriteNameToBuffer( char * pcBuffer,
@@ -7609,6 +9990,44 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_FAST_PATH == 1 )
+
+    BaseType_t xTaskDecrementMutexHeldCount( void )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        BaseType_t xReturn = pdFALSE;
+
+        traceENTER_xTaskDecrementMutexHeldCount();
+
+        configASSERT( pxTCB );
+        configASSERT( pxTCB->uxMutexesHeld );
+
+        if( ( pxTCB->uxMutexesHeld == ( UBaseType_t ) 1 ) && ( pxTCB->uxPriority != pxTCB->uxBasePriority ) )
+        {
+            /* The last mutex the task holds is being given back while the task
+             * has an inherited priority, so the task must return to its base
+             * priority, which requires a critical section. */
+            taskENTER_CRITICAL();
+            {
+                xReturn = xTaskPriorityDisinherit( pxTCB );
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            /* The held count is only ever modified by the task itself, so no
+             * critical section is required. */
+            ( pxTCB->uxMutexesHeld )--;
+        }
+
+        traceRETURN_xTaskDecrementMutexHeldCount( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEX_FAST_PATH */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
@@ -7906,6 +10325,7 @@ TickType_t uxTaskResetEventItemValue( void )
              * notification then unblock it now. */
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
+                taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
                 listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                 prvAddTaskToReadyList( pxTCB );
 
@@ -8053,6 +10473,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
                 {
+                    taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
                 }
@@ -8065,7 +10486,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8171,6 +10592,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
                 {
+                    taskREMOVE_DELAYED_TASK_FROM_HEAP( pxTCB );
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
                 }
@@ -8183,7 +10605,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskTASK_PREEMPTS_CURRENT_TASK( pxTCB ) )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8352,6 +10774,50 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    BaseType_t xTaskSetBudget( TaskHandle_t xTask,
+                               configRUN_TIME_COUNTER_TYPE ulBudget,
+                               TickType_t xPeriod )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskSetBudget( xTask, ulBudget, xPeriod );
+
+        if( ( ulBudget != ( configRUN_TIME_COUNTER_TYPE ) 0U ) && ( xPeriod == ( TickType_t ) 0U ) )
+        {
+            /* A budget must be replenished periodically. */
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                /* If null is passed in here then it is the budget of the
+                 * calling task that is being set. */
+                pxTCB = prvGetTCBFromHandle( xTask );
+                configASSERT( pxTCB != NULL );
+
+                /* The first budget period starts now. */
+                pxTCB->ulBudget = ulBudget;
+                pxTCB->xBudgetPeriod = xPeriod;
+                pxTCB->ulBudgetUsed = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+                pxTCB->xBudgetPeriodStart = taskCURRENT_TICK_COUNT();
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+
+        traceRETURN_xTaskSetBudget( xReturn );
+
+        return xReturn;
+    }
+
+#endif /* if ( configUSE_TASK_BUDGETS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
     configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
@@ -8429,6 +10895,23 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        const TickType_t xUnprocessedTicks = prvGetCurrentTickCount() - xConstTickCount;
+
+        /* Measure the block time from the current time rather than from the
+         * tick count, without turning a finite block time into portMAX_DELAY. */
+        if( xTicksToWait < ( portMAX_DELAY - xUnprocessedTicks ) )
+        {
+            xTicksToWait += xUnprocessedTicks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_DYNAMIC_TICK */
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -8466,14 +10949,14 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 /* Wake time has overflowed.  Place this item in the overflow
                  * list. */
                 traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-                vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxOverflowDelayedList, pxOverflowDelayedTaskHeap, pxCurrentTCB );
             }
             else
             {
                 /* The wake time has not overflowed, so the current block list
                  * is used. */
                 traceMOVED_TASK_TO_DELAYED_LIST();
-                vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                taskINSERT_DELAYED_TASK( pxDelayedList, pxDelayedTaskHeap, pxCurrentTCB );
 
                 /* If the task entering the blocked state was placed at the
                  * head of the list of blocked tasks then xNextTaskUnblockTime
@@ -8503,13 +10986,13 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         {
             traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
             /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxOverflowDelayedList, pxOverflowDelayedTaskHeap, pxCurrentTCB );
         }
         else
         {
             traceMOVED_TASK_TO_DELAYED_LIST();
             /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            taskINSERT_DELAYED_TASK( pxDelayedList, pxDelayedTaskHeap, pxCurrentTCB );
 
             /* If the task entering the blocked state was placed at the head of the
              * list of blocked tasks then xNextTaskUnblockTime needs to be updated
@@ -8528,6 +11011,40 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         ( void ) xCanBlockIndefinitely;
     }
     #endif /* INCLUDE_vTaskSuspend */
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 )
+    {
+        /* The task may still be referenced from xDeadlineTaskList if it left
+         * the Blocked state early the last time it blocked. */
+        if( listLIST_ITEM_CONTAINER( &( pxCurrentTCB->xDeadlineListItem ) ) != NULL )
+        {
+            listREMOVE_ITEM( &( pxCurrentTCB->xDeadlineListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxCurrentTCB->ullDeadlineNs != 0U )
+        {
+            listINSERT_END( &xDeadlineTaskList, &( pxCurrentTCB->xDeadlineListItem ) );
+
+            if( pxCurrentTCB->ullDeadlineNs < ullNextDeadlineNs )
+            {
+                ullNextDeadlineNs = pxCurrentTCB->ullDeadlineNs;
+                portSET_HIGH_RESOLUTION_TIMER( ullNextDeadlineNs );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* #if ( configUSE_HIGH_RESOLUTION_TIMEOUTS == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -8669,12 +11186,38 @@ void vTaskResetState( void )
     uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
     xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
     uxTopReadyPriority = tskIDLE_PRIORITY;
+
+    #if ( configUSE_READY_PRIORITY_BITMAP == 1 )
+    {
+        UBaseType_t uxWord;
+
+        ulReadyPriorityGroups = 0U;
+
+        for( uxWord = 0U; uxWord < ( UBaseType_t ) taskREADY_PRIORITY_BITMAP_WORDS; uxWord++ )
+        {
+            ulReadyPriorities[ uxWord ] = 0U;
+        }
+    }
+    #endif /* #if ( configUSE_READY_PRIORITY_BITMAP == 1 ) */
+
     xSchedulerRunning = pdFALSE;
     xPendedTicks = ( TickType_t ) 0U;
 
     for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
     {
         xYieldPendings[ xCoreID ] = pdFALSE;
+
+        #if ( configUSE_PER_CORE_READY_LISTS == 1 )
+        {
+            uxCoreTopReadyPriority[ xCoreID ] = tskIDLE_PRIORITY;
+        }
+        #endif
+
+        #if ( configUSE_GRANULAR_LOCKS == 1 )
+        {
+            uxDataGroupCriticalNesting[ xCoreID ] = 0U;
+        }
+        #endif
     }
 
     xNumOfOverflows = ( BaseType_t ) 0;